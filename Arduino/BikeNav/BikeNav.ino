@@ -25,6 +25,11 @@ enum PageType {
   PAGE_SNAKE
 };
 
+// --- DEBUG COMMANDS ---
+// 1 = compile the benchmarks in and run them from single-character Serial
+// commands (handleDebugCommand()); leave at 0 for ride builds
+#define BIKENAV_DEBUG_COMMANDS 0
+
 // Forward declaration of navigateToPage (needed by page headers)
 void navigateToPage(PageType page);
 
@@ -32,6 +37,7 @@ void navigateToPage(PageType page);
 #include "timezone.h"
 #include "bitmaps.h"
 #include "tile_cache.h"
+#include "tile_presence.h"
 #include "ble_handler.h"
 #include "battery_manager.h"
 #include "notification_system.h"
@@ -318,6 +324,13 @@ volatile unsigned long lastChargingTime = 0;
 volatile bool waitingForButtonRelease = false;  // True after processing encoder press, waiting for physical release
 volatile bool waitingForOptionsRelease = false; // True after processing options press, waiting for physical release
 
+// True while encoder/button events are waiting for the main loop (background work should yield)
+bool isUserInputPending() {
+  return encoderChanged || buttonPressed || backPressed || nextPagePressed || settingsPressed || optionsPressed;
+}
+
+const unsigned long LOOP_IDLE_MS = 50;  // Main loop period
+
 // --- INTERRUPT SERVICE ROUTINES ---
 /* Rotary encoder interrupt routine based on Oleg Mazurov's code
  * https://chome.nerpa.tech/mcu/rotary-encoder-interrupt-service-routine-for-avr-micros/
@@ -418,6 +431,8 @@ void navigateToPage(PageType page) {
   previousPage = currentPage;
   currentPage = page;
   lastPageNavigation = millis();  // Record page navigation time for cooldown
+  invalidatePanelShadow();        // The new page is drawn over the whole panel
+  clearFrameRequests();           // ...and covers whatever the old one had pending
 
   clearStatusBarExtras();
 
@@ -667,14 +682,20 @@ void setup() {
   digitalWrite(SD_CS_PIN, HIGH);
   delay(100);  // Let pins stabilize
 
+  // Panel and SD card share the SPI bus
+  initSpiBus();
+
   // Initialize display
   display.init(115200, true, 50, false);
   display.setRotation(2);
+  checkDisplayBufferLayout();                     // Direct framebuffer rendering (display_buffer.h)
+  initPanelBusyOverlap(EPD_BUSY_PIN);            // GPS parsing while the panel refreshes
   
   // Initialize u8g2 fonts
   u8g2_display.begin(display);
   u8g2_display.setFontMode(1);                    // Transparent mode (1) for e-ink
   u8g2_display.setFontDirection(0);               // Left to right
+  initGlyphCache();                               // Sprites for the hot info bar / status bar fonts
   
   Serial.printf("Display dimensions: %dx%d\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
   
@@ -789,6 +810,14 @@ void setup() {
     Serial.println("WARNING: Tile cache disabled - maps will load from SD only");
   }
 
+  // Load the tile presence filter so missing tiles skip the SD card
+  if (sdCardPresent) {
+    loadTilePresenceFilter(MAP_INDEX_PATH);
+  }
+
+  // Compose map frames on the other core (falls back to loop() rendering)
+  startMapRenderTask();
+
   // Initialize pages
   initMapPage();
 
@@ -825,11 +854,122 @@ void setup() {
 
 }
 
+// --- GPS INPUT ---
+// Drain the GPS UART. Runs from loop() and from the panel busy callback
+// (panel_busy.h) while a display refresh is in progress, so it must not
+// touch the display or the SD card.
+void readGPSSerial() {
+  static bool timeSetFromGPS = false;
+  while (GPS_Serial.available() > 0) {
+    if (gps.encode(GPS_Serial.read())) {
+      if (gps.location.isValid()) {
+        currentLat = gps.location.lat();
+        currentLon = gps.location.lng();
+        if (!gpsValid) {
+          Serial.println("GPS lock acquired!");
+          Serial.printf("Location: %.6f, %.6f\n", currentLat, currentLon);
+        }
+        gpsValid = true;
+        lastGPSUpdate = millis();
+
+        // Check if GPS position changed and trigger screen update if needed
+        // Works in both navigation mode and plain map mode
+        checkGPSPositionChange();
+      }
+
+      // Set system time from GPS (once when GPS first locks)
+      if (!timeSetFromGPS && gps.date.isValid() && gps.time.isValid()) {
+        struct tm timeinfo;
+        timeinfo.tm_year = gps.date.year() - 1900;  // Years since 1900
+        timeinfo.tm_mon = gps.date.month() - 1;      // Months since January (0-11)
+        timeinfo.tm_mday = gps.date.day();
+        timeinfo.tm_hour = gps.time.hour();
+        timeinfo.tm_min = gps.time.minute();
+        timeinfo.tm_sec = gps.time.second();
+        timeinfo.tm_isdst = -1;  // Auto-detect DST
+
+        time_t utcTime = mktime(&timeinfo);
+
+        // Apply timezone offset (CET/CEST for Czech Republic)
+        int timezoneOffset = isDSTActive(gps.date.year(), gps.date.month(), gps.date.day(), gps.time.hour()) ? 2 : 1;
+        time_t localTime = utcTime + (timezoneOffset * 3600);
+
+        // Set the system time
+        struct timeval tv = { .tv_sec = localTime, .tv_usec = 0 };
+        settimeofday(&tv, NULL);
+
+        timeSetFromGPS = true;
+        Serial.printf("System time set from GPS: %04d-%02d-%02d %02d:%02d:%02d (UTC+%d)\n",
+                     gps.date.year(), gps.date.month(), gps.date.day(),
+                     gps.time.hour(), gps.time.minute(), gps.time.second(), timezoneOffset);
+      }
+    }
+  }
+}
+
+#if BIKENAV_DEBUG_COMMANDS
+// --- DEBUG COMMANDS ---
+// One character per command from the Serial monitor, run between two loop()
+// passes. Benchmarks draw into the framebuffer, so the page is redrawn after.
+void printDebugCommands() {
+  Serial.println("=== DEBUG COMMANDS ===");
+  Serial.println("b  render pipeline benchmark (PBMs to /Bench)");
+  Serial.println("l  map render latency, loop() vs render task");
+  Serial.println("r  route projection");
+  Serial.println("t  thick route lines");
+  Serial.println("g  glyph cache");
+  Serial.println("o  panel busy overlap");
+  Serial.println("s  statistics");
+  Serial.println("======================");
+}
+
+void handleDebugCommand() {
+  if (Serial.available() <= 0) return;
+  char command = Serial.read();
+  bool redraw = true;
+
+  switch (command) {
+    case 'b': benchmarkRenderPipeline(); break;
+    case 'l': benchmarkMapRenderLatency(); break;
+    case 'r': benchmarkRouteProjection(); break;
+    case 't': benchmarkThickLines(); break;
+    case 'g': benchmarkGlyphCache(); break;
+    case 'o': benchmarkPanelBusyOverlap(); break;
+    case 's':
+      printTileCacheStats();
+      printTilePresenceStats();
+      printPanelDiffStats();
+      printPanelBusyStats();
+      printSpiBusStats();
+      printMapLayerStats();
+      redraw = false;
+      break;
+    case '\r':
+    case '\n':
+      return;
+    default:
+      printDebugCommands();
+      return;
+  }
+
+  if (redraw) {
+    // Same page, same state - only its pixels were overwritten
+    PageType backPage = previousPage;
+    skipPageInit = true;
+    navigateToPage(currentPage);
+    previousPage = backPage;
+  }
+}
+#endif
+
 // --- MAIN LOOP ---
 void loop() {
   // Update BLE handler (for delayed trip list sending)
   updateBleHandler();
 
+  // Show a map frame the render task finished
+  pollMapRenderTask();
+
   // Handle pending page navigation from BLE (deferred to avoid display corruption)
   extern volatile bool pendingPageNavigation;
   extern volatile PageType pendingNavigationPage;
@@ -901,53 +1041,12 @@ void loop() {
   }
 
   // Read GPS data
-  static bool timeSetFromGPS = false;
-  while (GPS_Serial.available() > 0) {
-    if (gps.encode(GPS_Serial.read())) {
-      if (gps.location.isValid()) {
-        currentLat = gps.location.lat();
-        currentLon = gps.location.lng();
-        if (!gpsValid) {
-          Serial.println("GPS lock acquired!");
-          Serial.printf("Location: %.6f, %.6f\n", currentLat, currentLon);
-        }
-        gpsValid = true;
-        lastGPSUpdate = millis();
+  readGPSSerial();
 
-        // Check if GPS position changed and trigger screen update if needed
-        // Works in both navigation mode and plain map mode
-        checkGPSPositionChange();
-      }
+#if BIKENAV_DEBUG_COMMANDS
+  handleDebugCommand();
+#endif
 
-      // Set system time from GPS (once when GPS first locks)
-      if (!timeSetFromGPS && gps.date.isValid() && gps.time.isValid()) {
-        struct tm timeinfo;
-        timeinfo.tm_year = gps.date.year() - 1900;  // Years since 1900
-        timeinfo.tm_mon = gps.date.month() - 1;      // Months since January (0-11)
-        timeinfo.tm_mday = gps.date.day();
-        timeinfo.tm_hour = gps.time.hour();
-        timeinfo.tm_min = gps.time.minute();
-        timeinfo.tm_sec = gps.time.second();
-        timeinfo.tm_isdst = -1;  // Auto-detect DST
-
-        time_t utcTime = mktime(&timeinfo);
-
-        // Apply timezone offset (CET/CEST for Czech Republic)
-        int timezoneOffset = isDSTActive(gps.date.year(), gps.date.month(), gps.date.day(), gps.time.hour()) ? 2 : 1;
-        time_t localTime = utcTime + (timezoneOffset * 3600);
-
-        // Set the system time
-        struct timeval tv = { .tv_sec = localTime, .tv_usec = 0 };
-        settimeofday(&tv, NULL);
-
-        timeSetFromGPS = true;
-        Serial.printf("System time set from GPS: %04d-%02d-%02d %02d:%02d:%02d (UTC+%d)\n",
-                     gps.date.year(), gps.date.month(), gps.date.day(),
-                     gps.time.hour(), gps.time.minute(), gps.time.second(), timezoneOffset);
-      }
-    }
-  }
-  
   // Handle encoder rotation
   if (encoderChanged) {
     // Atomically capture and reset the accumulated delta value
@@ -1225,6 +1324,9 @@ void loop() {
   // Update notification display with smart rendering (waits for user activity to finish)
   updateNotificationDisplay();
 
+  // At most one panel update per refresh slot for everything submitted above
+  serviceFrameScheduler();
+
   // Check for long-press on options button for power off
   // ONLY on main menu to avoid interfering with other pages (e.g., game scrolling)
   if (currentPage == PAGE_MAIN_MENU) {
@@ -1248,5 +1350,11 @@ void loop() {
     }
   }
 
-  delay(50);
+  // Spend the idle part of the loop period prefetching route tiles, then sleep the rest
+  unsigned long idleStart = millis();
+  updateTilePrefetch(PREFETCH_BUDGET_MS);
+  unsigned long idleSpent = millis() - idleStart;
+  if (idleSpent < LOOP_IDLE_MS) {
+    delay(LOOP_IDLE_MS - idleSpent);
+  }
 }
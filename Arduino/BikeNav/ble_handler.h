@@ -15,6 +15,7 @@
 
 // Include notification system and Bluetooth icons
 #include "notification_system.h"
+#include "spi_bus.h"
 extern const unsigned char ICON_BT_CONNECTED[];
 extern const unsigned char ICON_BT_DISCONNECTED[];
 
@@ -27,6 +28,17 @@ extern bool bluetoothEnabled;
 void sendEspDeviceStatus();
 uint8_t getGpsStage();
 
+// External from tile_presence.h
+void tilePresenceAdd(uint8_t zoom, uint32_t tileX, uint32_t tileY);
+void tilePresenceClear();
+void setTilePresenceReady(bool ready);
+
+// External from map_canvas.h
+void mapCanvasNoteTileSaved(int zoom, int tileX, int tileY);
+
+// External from page_radar.h
+void radarLayersNoteTileSaved(int zoom);
+
 // External from map_trips.h
 bool readTripListMetadata(const char* tripDirName, char* outName, size_t maxLen, uint64_t* outCreatedAt);
 
@@ -137,6 +149,7 @@ int radarFrameLocalMinutes[RADAR_MAX_FRAMES];
 bool radarFrameLocalMinutesValid[RADAR_MAX_FRAMES];
 uint8_t* radarFrames = nullptr;
 bool radarFrameReady[RADAR_MAX_FRAMES];
+uint16_t radarFrameGeneration[RADAR_MAX_FRAMES];  // Bumped whenever a frame's data changes
 int radarFrameStepMinutes = RADAR_FRAME_STEP_DEFAULT_MINUTES;
 int radarFrameTotalCount = RADAR_MAX_FRAMES;
 bool radarFramesUpdated = false;
@@ -153,6 +166,7 @@ bool isRadarFrameOffsetValid(int offsetSteps) {
 void clearRadarFrames() {
   for (int i = 0; i < RADAR_MAX_FRAMES; i++) {
     radarFrameReady[i] = false;
+    radarFrameGeneration[i]++;
     radarFrameLocalMinutesValid[i] = false;
     radarFrameLocalMinutes[i] = 0;
   }
@@ -319,11 +333,12 @@ uint32_t recordingMetaSize = 0;
 uint32_t recordingGpxSize = 0;
 uint32_t recordingBytesSent = 0;
 unsigned long recordingTransferLastSendMs = 0;
+unsigned long tileSaveBusWaitUs = 0;  // SPI bus wait of the last saveTileToSD()
+unsigned long tileSaveRetries = 0;    // SD.open() retries of saveTileToSD(), all tiles
 
 // Forward declarations
 bool saveTileToSD(int zoom, int tileX, int tileY, uint8_t* data, uint32_t size);
 void saveTripToSD(const char* fileName, uint8_t* gpxData, uint32_t gpxSize, uint8_t* metaData, uint32_t metaSize);
-bool decompressRLE(uint8_t* compressed, uint32_t compressedSize, uint8_t* decompressed, uint32_t* decompressedSize);
 void scanAndSendTripList();
 void scanAndSendRecordingList();
 void sendActiveTripUpdate();
@@ -339,20 +354,6 @@ void updateRecordingTransferSend();
 void finishRecordingTransfer();
 void sendRecordingTransferError(const char* message);
 
-// RLE decompression
-bool decompressRLE(uint8_t* compressed, uint32_t compressedSize, uint8_t* decompressed, uint32_t* decompressedSize) {
-    uint32_t srcIdx = 0; uint32_t dstIdx = 0; uint32_t maxDst = *decompressedSize;
-    while (srcIdx < compressedSize && dstIdx < maxDst) {
-        if (srcIdx + 1 >= compressedSize) return false;
-        uint8_t count = compressed[srcIdx++];
-        uint8_t value = compressed[srcIdx++];
-        if (dstIdx + count > maxDst) return false;
-        for (int i = 0; i < count; i++) decompressed[dstIdx++] = value;
-    }
-    *decompressedSize = dstIdx;
-    return true;
-}
-
 class MyServerCallbacks: public BLEServerCallbacks {
     void onConnect(BLEServer* pServer) {
       deviceConnected = true;
@@ -443,23 +444,26 @@ class MyServerCallbacks: public BLEServerCallbacks {
  * THE SOLUTION (DO NOT MODIFY WITHOUT CAUTION):
  * ======================================================================================
  * 
- * 1. CONTENTION RETRY LOOP (in `saveTileToSD`):
- *    We treat `SD.open()` failures as temporary (likely due to Display refresh). 
- *    We utilize a retry loop with small `delay()`s to wait for the SPI bus to free up.
+ * 1. SPI BUS ARBITER (spi_bus.h):
+ *    Every panel transfer goes through `nextDisplayPage()` (display_buffer.h) or
+ *    `flushDisplayDiff()` (panel_diff.h) and every SD access takes the bus, so
+ *    `saveTileToSD` waits for the display transaction instead of failing in
+ *    `SD.open()`. Panel updates lend the bus to waiting SD clients while the
+ *    waveform runs. A bounded `SD.open()` retry with the bus released stays as a
+ *    safety net for file handle exhaustion.
  * 
  * 2. MINIMIZED FILE OPERATIONS:
  *    - "Blind Remove": We call `SD.remove()` without checking `SD.exists()` first.
  *    - "Lazy Mkdir": We attempt to write the file assuming directories exist. We only 
- *      check/create directories (`SD.mkdir`) if the write fails after retries.
+ *      check/create directories (`SD.mkdir`) if the first open fails.
  *    - This reduces file system overhead by ~60% per tile.
  * 
  * 3. STRICT STOP-AND-WAIT FLOW CONTROL:
  *    - ESP32 sends the ACK (Notification) ONLY AFTER the SD write returns (success or fail).
- *    - On write failure, we add a throttle `delay(200)` to let the system recover before 
- *      requesting the next packet.
  * 
- * WARNING: Adding redundant `SD.exists()` checks or removing the retry logic will 
- * immediately re-introduce write failures during map rendering or display updates.
+ * WARNING: Adding redundant `SD.exists()` checks, touching the SD card without taking
+ * the bus, or calling `display.nextPage()` directly instead of `nextDisplayPage()`
+ * will re-introduce write failures during map rendering or display updates.
  * ======================================================================================
  */
 class TileCharacteristicCallbacks: public BLECharacteristicCallbacks {
@@ -584,11 +588,10 @@ private:
         }
         
         if (success) {
-            Serial.printf("Saved tile %d/%d/%d (%lu ms)\n", zoom, tileX, tileY, millis() - start);
+            Serial.printf("Saved tile %d/%d/%d (%lu ms, bus wait %lu ms, %lu open retries total)\n", zoom, tileX, tileY,
+                          millis() - start, tileSaveBusWaitUs / 1000, tileSaveRetries);
         } else {
             Serial.printf("FAILED to save tile %d/%d/%d (%lu ms)\n", zoom, tileX, tileY, millis() - start);
-            // Throttle on failure to allow background tasks (Display/SD) to recover
-            delay(100); 
         }
       }
 
@@ -846,6 +849,7 @@ class RadarCharacteristicCallbacks: public BLECharacteristicCallbacks {
             const uint8_t* frameData = radarReceiveBuffer + RADAR_FRAME_HEADER_SIZE + RADAR_ERROR_MESSAGE_SIZE;
             memcpy(radarFrames + (frameIndex * RADAR_IMAGE_BYTES), frameData, RADAR_IMAGE_BYTES);
             radarFrameReady[frameIndex] = true;
+            radarFrameGeneration[frameIndex]++;
             if (frameTimeValid) {
               radarFrameLocalMinutes[frameIndex] = (int)baseMinutesRaw;
               radarFrameLocalMinutesValid[frameIndex] = true;
@@ -1330,54 +1334,68 @@ void startBLE() {
 }
 
 void initSDCardFolders() {
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   if (!SD.exists(MAP_DIR)) SD.mkdir(MAP_DIR);
   if (!SD.exists(TRIPS_DIR)) SD.mkdir(TRIPS_DIR);
 }
 
-// OPTIMIZED SAVE TILE TO SD WITH CONTENTION RETRY
+// OPTIMIZED SAVE TILE TO SD, ONE BUS TRANSACTION
+#define TILE_SAVE_OPEN_ATTEMPTS 3
+
 bool saveTileToSD(int zoom, int tileX, int tileY, uint8_t* data, uint32_t size) {
   char zoomPath[32]; sprintf(zoomPath, "%s/%d", MAP_DIR, zoom);
   char xPath[48]; sprintf(xPath, "%s/%d", zoomPath, tileX);
   char tilePath[64]; sprintf(tilePath, "%s/%d.bin", xPath, tileY);
 
-  // 1. Blindly remove the file if it exists.
+  // 1. Wait for the bus: a panel update in progress finishes (or lends it
+  // during its waveform) instead of making SD.open() fail
+  unsigned long waitStart = micros();
+  acquireSpiBus(SPI_CLIENT_BACKGROUND);
+  tileSaveBusWaitUs = micros() - waitStart;
+
+  // 2. Blindly remove the file if it exists.
   // We do NOT check SD.exists() first to save a file handle.
   SD.remove(tilePath);
 
-  File file;
-  
-  // 2. Attempt to open file. 
-  // If the Display is refreshing (SPI busy) or map is rendering (Handle busy), this might fail.
-  // We use a retry loop to bridge the gap of the display update (which takes ~100-200ms).
-  for (int i = 0; i < 3; i++) {
-    file = SD.open(tilePath, FILE_WRITE);
-    if (file) break;
-
-    // Open failed. Wait a bit for other tasks to release SPI/Handles.
-    delay(50);
-  }
+  File file = SD.open(tilePath, FILE_WRITE);
 
-  // 3. If still failed, it might be that directories are missing (first time setup).
+  // 3. If that failed, directories are missing (first time setup).
   if (!file) {
     if (!SD.exists(zoomPath)) SD.mkdir(zoomPath);
     if (!SD.exists(xPath)) SD.mkdir(xPath);
-    
-    // One last try
     file = SD.open(tilePath, FILE_WRITE);
   }
 
+  // 4. Still failing: out of file handles until another task closes one.
+  // Bounded retry with the bus released, so that task can get to it.
+  for (int attempt = 1; !file && attempt < TILE_SAVE_OPEN_ATTEMPTS; attempt++) {
+    tileSaveRetries++;
+    releaseSpiBus();
+    delay(50);
+    acquireSpiBus(SPI_CLIENT_BACKGROUND);
+    file = SD.open(tilePath, FILE_WRITE);
+  }
+
+  bool saved = false;
   if (file) {
     file.write(data, size);
     file.close(); // CRITICAL
     appendTileIndexRecord((uint8_t)zoom, (uint32_t)tileX, (uint32_t)tileY);
-    return true;
-  } else {
+    saved = true;
+  }
+  releaseSpiBus();
+
+  if (!saved) {
     Serial.printf("ERROR: Failed to open tile %d/%d/%d for writing after retries\n", zoom, tileX, tileY);
     return false;
   }
+  mapCanvasNoteTileSaved(zoom, tileX, tileY);
+  radarLayersNoteTileSaved(zoom);
+  return true;
 }
 
 void saveTripToSD(const char* fileName, uint8_t* gpxData, uint32_t gpxSize, uint8_t* metaData, uint32_t metaSize) {
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   char tripPath[64]; sprintf(tripPath, "%s/%s", TRIPS_DIR, fileName);
   if (!SD.exists(tripPath)) SD.mkdir(tripPath);
   char gpxPath[80]; sprintf(gpxPath, "%s/%s.gpx", tripPath, fileName);
@@ -1386,9 +1404,12 @@ void saveTripToSD(const char* fileName, uint8_t* gpxData, uint32_t gpxSize, uint
   char metaPath[96]; sprintf(metaPath, "%s/%s_meta.json", tripPath, fileName);
   File metaFile = SD.open(metaPath, FILE_WRITE);
   if (metaFile) { metaFile.write(metaData, metaSize); metaFile.close(); }
+  char previewPath[96]; sprintf(previewPath, "%s/%s_preview.bin", tripPath, fileName);
+  SD.remove(previewPath);  // Rendered from the old GPX
 }
 
 uint8_t* loadTileFromSD(int zoom, int tileX, int tileY, uint32_t* outSize) {
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   char tilePath[64]; sprintf(tilePath, "%s/%d/%d/%d.bin", MAP_DIR, zoom, tileX, tileY);
   if (!SD.exists(tilePath)) return nullptr;
   File file = SD.open(tilePath, FILE_READ);
@@ -1429,11 +1450,9 @@ void writeTileIndexRecord(File& file, uint8_t zoom, uint32_t tileX, uint32_t til
 }
 
 void appendTileIndexRecord(uint8_t zoom, uint32_t tileX, uint32_t tileY) {
+  tilePresenceAdd(zoom, tileX, tileY);
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   File indexFile = SD.open(MAP_INDEX_PATH, FILE_APPEND);
-  if (!indexFile) {
-    delay(5);
-    indexFile = SD.open(MAP_INDEX_PATH, FILE_APPEND);
-  }
   if (indexFile) {
     writeTileIndexRecord(indexFile, zoom, tileX, tileY);
     indexFile.close();
@@ -1441,6 +1460,7 @@ void appendTileIndexRecord(uint8_t zoom, uint32_t tileX, uint32_t tileY) {
 }
 
 bool rebuildTileIndex() {
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   File mapDir = SD.open(MAP_DIR);
   if (!mapDir) return false;
 
@@ -1448,6 +1468,9 @@ bool rebuildTileIndex() {
   File indexFile = SD.open(MAP_INDEX_PATH, FILE_WRITE);
   if (!indexFile) { mapDir.close(); return false; }
 
+  // Refill the presence filter from the directory walk (renderer probes SD meanwhile)
+  tilePresenceClear();
+
   int recordsWritten = 0;
   File zoomEntry = mapDir.openNextFile();
   while (zoomEntry) {
@@ -1468,8 +1491,12 @@ bool rebuildTileIndex() {
                   int tileY = -1;
                   if (parseIntFromName(tileName, &tileY)) {
                     writeTileIndexRecord(indexFile, (uint8_t)zoom, (uint32_t)tileX, (uint32_t)tileY);
+                    tilePresenceAdd((uint8_t)zoom, (uint32_t)tileX, (uint32_t)tileY);
                     recordsWritten++;
-                    if ((recordsWritten % 200) == 0) delay(1);
+                    if ((recordsWritten % 200) == 0) {
+                      yieldSpiBus(SPI_CLIENT_BACKGROUND);  // Panel updates and tile reads go between
+                      delay(1);
+                    }
                   }
                 }
                 tileEntry.close();
@@ -1488,6 +1515,7 @@ bool rebuildTileIndex() {
 
   indexFile.close();
   mapDir.close();
+  setTilePresenceReady(true);
   Serial.printf("Tile index rebuilt: %d records\n", recordsWritten);
   return true;
 }
@@ -1504,6 +1532,7 @@ void sendTileInventoryError() {
 void startTileInventorySend() {
   if (!deviceConnected || pTripControlCharacteristic == nullptr) return;
   if (tileInventorySending) return;
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
 
   if (!SD.exists(MAP_INDEX_PATH)) {
     Serial.println("Tile index missing, rebuilding...");
@@ -1569,7 +1598,11 @@ void updateTileInventorySend() {
 
   uint8_t buffer[1 + TILE_INV_MAX_RECORDS_PER_CHUNK * TILE_INV_RECORD_SIZE];
   buffer[0] = TILE_INV_ACTION_DATA;
-  int bytesRead = tileInventoryFile.read(buffer + 1, bytesToRead);
+  int bytesRead;
+  {
+    SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
+    bytesRead = tileInventoryFile.read(buffer + 1, bytesToRead);
+  }
   if (bytesRead <= 0) {
     finishTileInventorySend();
     return;
@@ -1619,6 +1652,7 @@ void startRecordingTransfer(const char* recordingDirName) {
   char gpxPath[128];
   snprintf(metaPath, sizeof(metaPath), "%s/%s/%s_meta.json", RECORDINGS_DIR, recordingDirName, recordingDirName);
   snprintf(gpxPath, sizeof(gpxPath), "%s/%s/%s.gpx", RECORDINGS_DIR, recordingDirName, recordingDirName);
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
 
   recordingMetaFile = SD.open(metaPath, FILE_READ);
   recordingGpxFile = SD.open(gpxPath, FILE_READ);
@@ -1688,6 +1722,7 @@ void updateRecordingTransferSend() {
   buffer[0] = RECORDING_TRANSFER_ACTION_DATA;
 
   int bytesRead = 0;
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   if (recordingBytesSent < recordingMetaSize) {
     uint32_t metaRemaining = recordingMetaSize - recordingBytesSent;
     uint32_t metaToRead = (metaRemaining < bytesToRead) ? metaRemaining : bytesToRead;
@@ -1737,6 +1772,7 @@ static int compareBleTripSortEntryByCreatedAtDesc(const void* left, const void*
 
 void scanAndSendTripList() {
   if (!deviceConnected || pTripListCharacteristic == nullptr) return;
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
   File tripsDir = SD.open(TRIPS_DIR);
   if (!tripsDir) {
     uint8_t emptyList[2] = {0x00, 0x00}; pTripListCharacteristic->setValue(emptyList, 2); pTripListCharacteristic->notify(); return;
@@ -1831,6 +1867,7 @@ void scanAndSendTripList() {
 
 void scanAndSendRecordingList() {
   if (!deviceConnected || pRecordingListCharacteristic == nullptr) return;
+  SpiBusTransaction bus(SPI_CLIENT_BACKGROUND);
 
   File recordingsDir = SD.open(RECORDINGS_DIR);
   if (!recordingsDir) {
@@ -0,0 +1,285 @@
+#ifndef DISPLAY_BUFFER_H
+#define DISPLAY_BUFFER_H
+
+#include <GxEPD2_BW.h>
+#include <string.h>
+#include "spi_bus.h"
+
+// --- DIRECT FRAMEBUFFER ACCESS ---
+// GxEPD2_BW keeps its framebuffer private. The map renderers write whole
+// bytes into it instead of going through drawPixel() for every pixel.
+// Written against GxEPD2 1.6.x (GxEPD2_BW.h: uint8_t _buffer[], uint16_t
+// _pw_x/_pw_y/_pw_w/_pw_h). The library has no version macro, so the member
+// types and sizes are pinned by the static_asserts below, and
+// checkDisplayBufferLayout() probes the layout once at boot; on a mismatch
+// every renderer falls back to drawPixel().
+//
+// Buffer layout (full height page, setRotation(2), full screen window):
+// physical row = 295 - y, 16 bytes per row, MSB first, 1 = white.
+// Logical (x, y) is physical (127 - x, 295 - y), so logical byte k of a row
+// is the bit-reversed physical byte 15 - k.
+
+typedef GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> BikeNavDisplay;
+
+extern BikeNavDisplay display;
+
+const int DISPLAY_BUFFER_ROW_BYTES = GxEPD2_290_BS::WIDTH / 8;
+const int DISPLAY_BUFFER_ROWS = GxEPD2_290_BS::HEIGHT;
+
+// Explicit instantiation may name private members; the friend function
+// defined inside hands the member pointer out
+template <typename Tag, typename Tag::type Member>
+struct DisplayPrivateAccess {
+  friend typename Tag::type displayPrivateMember(Tag) { return Member; }
+};
+
+struct DisplayBufferTag {
+  typedef uint8_t (BikeNavDisplay::*type)[DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS];
+  friend type displayPrivateMember(DisplayBufferTag);
+};
+struct DisplayWindowXTag { typedef uint16_t BikeNavDisplay::*type; friend type displayPrivateMember(DisplayWindowXTag); };
+struct DisplayWindowYTag { typedef uint16_t BikeNavDisplay::*type; friend type displayPrivateMember(DisplayWindowYTag); };
+struct DisplayWindowWTag { typedef uint16_t BikeNavDisplay::*type; friend type displayPrivateMember(DisplayWindowWTag); };
+struct DisplayWindowHTag { typedef uint16_t BikeNavDisplay::*type; friend type displayPrivateMember(DisplayWindowHTag); };
+
+template struct DisplayPrivateAccess<DisplayBufferTag, &BikeNavDisplay::_buffer>;
+template struct DisplayPrivateAccess<DisplayWindowXTag, &BikeNavDisplay::_pw_x>;
+template struct DisplayPrivateAccess<DisplayWindowYTag, &BikeNavDisplay::_pw_y>;
+template struct DisplayPrivateAccess<DisplayWindowWTag, &BikeNavDisplay::_pw_w>;
+template struct DisplayPrivateAccess<DisplayWindowHTag, &BikeNavDisplay::_pw_h>;
+
+// The instantiations above only compile while the members have exactly these
+// types; the asserts pin the sizes the layout below depends on
+typedef uint8_t DisplayBufferArray[DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS];
+static_assert(GxEPD2_290_BS::WIDTH == 128 && GxEPD2_290_BS::HEIGHT == 296,
+              "display_buffer.h assumes the 128x296 GxEPD2_290_BS panel");
+static_assert(sizeof(BikeNavDisplay) >= sizeof(DisplayBufferArray) + 4 * sizeof(uint16_t),
+              "GxEPD2_BW no longer holds the framebuffer and partial window");
+
+bool displayBufferLayoutOk = false;  // Set by checkDisplayBufferLayout()
+
+inline uint8_t* getDisplayBuffer() {
+  return display.*displayPrivateMember(DisplayBufferTag());
+}
+
+/**
+ * True when the framebuffer has the layout described above. Anything else
+ * (other rotation, partial window smaller than the screen) must keep using
+ * drawPixel().
+ */
+bool isDisplayBufferDirect() {
+  return displayBufferLayoutOk && display.getRotation() == 2 &&
+         display.*displayPrivateMember(DisplayWindowXTag()) == 0 &&
+         display.*displayPrivateMember(DisplayWindowYTag()) == 0 &&
+         display.*displayPrivateMember(DisplayWindowWTag()) == GxEPD2_290_BS::WIDTH &&
+         display.*displayPrivateMember(DisplayWindowHTag()) == GxEPD2_290_BS::HEIGHT;
+}
+
+/**
+ * Call once after display.init() and setRotation(2): draw one pixel through
+ * the public drawPixel() and check it lands in the buffer byte and bit the
+ * layout above says. The pixel is restored afterwards.
+ */
+bool checkDisplayBufferLayout() {
+  displayBufferLayoutOk = false;
+  display.setFullWindow();
+  uint8_t* buffer = getDisplayBuffer();
+  uint8_t* end = buffer + sizeof(DisplayBufferArray);
+  bool inside = buffer >= (uint8_t*)&display && end <= (uint8_t*)&display + sizeof(BikeNavDisplay);
+
+  // Logical (0, 0) is physical (127, 295): last byte of the last row, LSB
+  uint8_t* probe = buffer + sizeof(DisplayBufferArray) - 1;
+  uint8_t saved = *probe;
+  display.drawPixel(0, 0, GxEPD_WHITE);
+  bool white = (*probe & 0x01) != 0;
+  display.drawPixel(0, 0, GxEPD_BLACK);
+  bool black = (*probe & 0x01) == 0;
+  *probe = saved;
+
+  displayBufferLayoutOk = inside && white && black && display.getRotation() == 2;
+  if (!displayBufferLayoutOk) {
+    Serial.println("[DISPLAY] Framebuffer layout not as expected, direct rendering disabled");
+  }
+  return displayBufferLayoutOk;
+}
+
+static inline uint8_t reverseBits8(uint8_t b) {
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+  b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+  return b;
+}
+
+// Source byte i of a row, white outside the row
+static inline uint8_t sourceRowByte(const uint8_t* src, int srcBytes, int i) {
+  return (i >= 0 && i < srcBytes) ? src[i] : 0xFF;
+}
+
+/**
+ * Clear (blacken) the pixels set in a logical row mask: 16 bytes, MSB first,
+ * 1 = black, byte 0 covering x = 0..7. Bit-reverses into physical order and
+ * ANDs into a buffer with the framebuffer layout one 32-bit word at a time.
+ * Used directly for off-screen frames (map_render_task.h).
+ */
+void displayApplyRowMaskTo(uint8_t* buffer, int dstY, const uint8_t* blackMask) {
+  if (dstY < 0 || dstY >= DISPLAY_BUFFER_ROWS) return;
+
+  uint32_t black[DISPLAY_BUFFER_ROW_BYTES / 4];
+  uint8_t* blackBytes = (uint8_t*)black;
+  for (int k = 0; k < DISPLAY_BUFFER_ROW_BYTES; k++) {
+    blackBytes[DISPLAY_BUFFER_ROW_BYTES - 1 - k] = reverseBits8(blackMask[k]);
+  }
+
+  uint8_t* row = buffer + (DISPLAY_BUFFER_ROWS - 1 - dstY) * DISPLAY_BUFFER_ROW_BYTES;
+  for (int w = 0; w < DISPLAY_BUFFER_ROW_BYTES / 4; w++) {
+    if (!black[w]) continue;
+    uint32_t word;
+    memcpy(&word, row + w * 4, 4);  // Buffer sits inside the display object, alignment unknown
+    word &= ~black[w];
+    memcpy(row + w * 4, &word, 4);
+  }
+}
+
+// Same as displayApplyRowMaskTo() on the display framebuffer.
+// Requires isDisplayBufferDirect().
+void displayApplyRowMask(int dstY, const uint8_t* blackMask) {
+  displayApplyRowMaskTo(getDisplayBuffer(), dstY, blackMask);
+}
+
+/**
+ * Blit the black pixels of one 1bpp source row (MSB first, 1 = white) onto
+ * logical screen row dstY, with source pixel 0 at logical x = dstX.
+ * Columns are clipped in source space and sub-byte offsets are shifted in.
+ * ditherPhase >= 0 drops black pixels whose (srcX + ditherPhase) is odd
+ * (checkerboard lightening); -1 keeps all pixels.
+ * Requires isDisplayBufferDirect().
+ */
+void displayBlitRow(const uint8_t* src, int srcBytes, int dstX, int dstY, int ditherPhase) {
+  if (dstY < 0 || dstY >= DISPLAY_BUFFER_ROWS) return;
+  int dstEnd = dstX + srcBytes * 8;
+  if (dstEnd <= 0 || dstX >= DISPLAY_BUFFER_ROW_BYTES * 8) return;
+
+  int firstByte = (dstX > 0 ? dstX : 0) >> 3;
+  int lastByte = ((dstEnd < DISPLAY_BUFFER_ROW_BYTES * 8 ? dstEnd : DISPLAY_BUFFER_ROW_BYTES * 8) - 1) >> 3;
+
+  // Checkerboard keeps the MSB of every byte or drops it, same for the whole row
+  uint8_t keepMask = 0xFF;
+  if (ditherPhase >= 0) {
+    keepMask = ((ditherPhase - dstX) & 1) ? 0x55 : 0xAA;
+  }
+
+  uint8_t blackMask[DISPLAY_BUFFER_ROW_BYTES] = {0};
+  int shift = (-dstX) & 7;
+
+  for (int k = firstByte; k <= lastByte; k++) {
+    int srcBit = k * 8 - dstX;
+    int i = srcBit >> 3;  // Arithmetic shift, floors negative offsets
+    uint8_t value;
+    if (shift == 0) {
+      value = sourceRowByte(src, srcBytes, i);
+    } else {
+      value = (uint8_t)((sourceRowByte(src, srcBytes, i) << shift) |
+                        (sourceRowByte(src, srcBytes, i + 1) >> (8 - shift)));
+    }
+    blackMask[k] = (uint8_t)~value & keepMask;
+  }
+
+  displayApplyRowMask(dstY, blackMask);
+}
+
+/**
+ * Blacken logical pixels x0..x1 (inclusive) of row dstY. The span is
+ * reversed into physical order and written as partial edge bytes plus a
+ * memset of the whole bytes between them.
+ * Requires isDisplayBufferDirect().
+ */
+void displayFillRowSpan(int dstY, int x0, int x1) {
+  if (dstY < 0 || dstY >= DISPLAY_BUFFER_ROWS) return;
+  if (x0 < 0) x0 = 0;
+  if (x1 > DISPLAY_BUFFER_ROW_BYTES * 8 - 1) x1 = DISPLAY_BUFFER_ROW_BYTES * 8 - 1;
+  if (x0 > x1) return;
+
+  uint8_t* row = getDisplayBuffer() + (DISPLAY_BUFFER_ROWS - 1 - dstY) * DISPLAY_BUFFER_ROW_BYTES;
+  int p0 = DISPLAY_BUFFER_ROW_BYTES * 8 - 1 - x1;  // Physical span, MSB first
+  int p1 = DISPLAY_BUFFER_ROW_BYTES * 8 - 1 - x0;
+  int firstByte = p0 >> 3;
+  int lastByte = p1 >> 3;
+  uint8_t firstMask = 0xFF >> (p0 & 7);
+  uint8_t lastMask = 0xFF << (7 - (p1 & 7));
+
+  if (firstByte == lastByte) {
+    row[firstByte] &= ~(firstMask & lastMask);
+    return;
+  }
+  row[firstByte] &= ~firstMask;
+  if (lastByte - firstByte > 1) memset(row + firstByte + 1, 0x00, lastByte - firstByte - 1);
+  row[lastByte] &= ~lastMask;
+}
+
+/**
+ * Compose row dstY one 32-bit word at a time: first lighten it (pixels with
+ * odd x + dstY + lightenPhase turn white; -1 skips this), then AND in the
+ * black pixels of src, a full-width logical row (1 = white; nullptr skips).
+ * Requires isDisplayBufferDirect().
+ */
+void displayComposeRow(int dstY, const uint8_t* src, int lightenPhase) {
+  if (dstY < 0 || dstY >= DISPLAY_BUFFER_ROWS) return;
+
+  // Logical x parity is flipped in physical order (x = 127 - px), so odd
+  // logical pixels are the even physical ones when dstY + phase is even
+  uint32_t lighten = 0;
+  if (lightenPhase >= 0) lighten = ((dstY + lightenPhase) & 1) ? 0x55555555 : 0xAAAAAAAA;
+
+  uint32_t overlay[DISPLAY_BUFFER_ROW_BYTES / 4];
+  if (src) {
+    uint8_t* overlayBytes = (uint8_t*)overlay;
+    for (int k = 0; k < DISPLAY_BUFFER_ROW_BYTES; k++) {
+      overlayBytes[DISPLAY_BUFFER_ROW_BYTES - 1 - k] = reverseBits8(src[k]);
+    }
+  } else {
+    memset(overlay, 0xFF, sizeof(overlay));
+  }
+
+  uint8_t* row = getDisplayBuffer() + (DISPLAY_BUFFER_ROWS - 1 - dstY) * DISPLAY_BUFFER_ROW_BYTES;
+  for (int w = 0; w < DISPLAY_BUFFER_ROW_BYTES / 4; w++) {
+    if (!lighten && overlay[w] == 0xFFFFFFFF) continue;
+    uint32_t word;
+    memcpy(&word, row + w * 4, 4);
+    word = (word | lighten) & overlay[w];
+    memcpy(row + w * 4, &word, 4);
+  }
+}
+
+/**
+ * Read logical pixels [x, x + width) of row srcY into dst, MSB first,
+ * 1 = white; bits past width in the last byte are set (white).
+ * Requires isDisplayBufferDirect().
+ */
+void displayReadRow(int srcY, int x, int width, uint8_t* dst) {
+  memset(dst, 0xFF, (width + 7) / 8);
+  if (srcY < 0 || srcY >= DISPLAY_BUFFER_ROWS) return;
+
+  const uint8_t* row = getDisplayBuffer() + (DISPLAY_BUFFER_ROWS - 1 - srcY) * DISPLAY_BUFFER_ROW_BYTES;
+  for (int i = 0; i < width; i++) {
+    int logicalX = x + i;
+    if (logicalX < 0 || logicalX >= DISPLAY_BUFFER_ROW_BYTES * 8) continue;
+    int physicalX = DISPLAY_BUFFER_ROW_BYTES * 8 - 1 - logicalX;
+    if ((row[physicalX >> 3] >> (7 - (physicalX & 7))) & 1) continue;
+    dst[i >> 3] &= ~(0x80 >> (i & 7));
+  }
+}
+
+// --- PANEL TRANSFER ---
+
+/**
+ * display.nextPage() holding the SPI bus: every firstPage()/nextPage()
+ * refresh ends its pages with this, so the panel transfer never overlaps
+ * an SD transaction of another task. Drawing between the pages runs
+ * without the bus; the busy callback lends it out during the waveform.
+ */
+bool nextDisplayPage() {
+  SpiBusTransaction bus(SPI_CLIENT_DISPLAY);
+  return display.nextPage();
+}
+
+#endif // DISPLAY_BUFFER_H
@@ -0,0 +1,234 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+
+// External panel producers from map_rendering.h, page_speedometer.h,
+// status_bar.h and notification_system.h
+extern void loadAndDisplayMap();
+extern void refreshMapInfoBar();
+extern void renderSpeedometerSplitOverlay();
+extern void refreshStatusBar();
+extern void forceNotificationRefresh();
+
+// External map view state from page_map.h / map_render_task.h
+extern bool isMapViewShown();
+extern bool isMapRenderTaskRunning();
+extern bool isMapRenderInFlight();
+
+// External layer compositing from map_layers.h
+extern bool isMapBaseLayerCurrent();
+extern bool refreshMapLayers(uint8_t regions);
+
+// --- FRAME SCHEDULER ---
+// Status bar, notifications, page refreshes and map frames each used to run
+// their own firstPage()/nextPage() cycle - several within a few hundred ms,
+// each blocking on the panel. Producers now submit the regions they made
+// stale, and serviceFrameScheduler() (once per loop(), after the producers)
+// turns everything pending into at most one panel update per refresh slot:
+//   FRAME_REGION_PAGE            - whole current page, covers everything
+//   FRAME_REGION_MAP             - map frame: tiles, route, info bar, overlays
+//   FRAME_REGION_INFO_BAR        - map view bands with a partial
+//   FRAME_REGION_SPEEDO_OVERLAY    refresh of their own
+//   FRAME_REGION_STATUS_BAR      - status bar band of the other pages
+// On the map view, changes above the map (bands, notification) are
+// recomposited over the cached base layer (map_layers.h); otherwise two
+// bands merge into one map frame. panel_diff.h pushes only changed rows.
+// While a map frame is on its way from the render task, map view bands wait
+// for it: its foreground is drawn with live state when it is flushed.
+//
+// Priorities input > navigation > status: a merged update carries the
+// highest priority submitted into it, and the slot - the minimum time since
+// the previous panel update - is shortest for input, so under contention
+// input goes first and status waits longest. Input renders of menus,
+// dialogs and page changes stay immediate and are not scheduled.
+#define FRAME_REPORT_INTERVAL_MS 60000
+
+enum FrameRegion : uint8_t {
+  FRAME_REGION_PAGE = 1 << 0,
+  FRAME_REGION_MAP = 1 << 1,
+  FRAME_REGION_INFO_BAR = 1 << 2,
+  FRAME_REGION_SPEEDO_OVERLAY = 1 << 3,
+  FRAME_REGION_STATUS_BAR = 1 << 4,
+};
+
+#define FRAME_REGIONS_MAP_BANDS (FRAME_REGION_INFO_BAR | FRAME_REGION_SPEEDO_OVERLAY)
+#define FRAME_REGIONS_MAP_VIEW (FRAME_REGION_PAGE | FRAME_REGION_MAP | FRAME_REGIONS_MAP_BANDS)
+
+enum FramePriority : uint8_t {
+  FRAME_PRIORITY_STATUS = 0,
+  FRAME_PRIORITY_NAVIGATION = 1,
+  FRAME_PRIORITY_INPUT = 2,
+  FRAME_PRIORITY_COUNT = 3
+};
+
+const char* const FRAME_PRIORITY_NAMES[FRAME_PRIORITY_COUNT] = {"status", "navigation", "input"};
+const unsigned long FRAME_SLOT_MS[FRAME_PRIORITY_COUNT] = {1500, 500, 250};
+
+// What a panel update drew, for the per-minute report
+enum FrameKind : uint8_t {
+  FRAME_KIND_MAP = 0,            // Full map frame, in loop() or from the render task
+  FRAME_KIND_LAYERS = 1,         // Bands recomposited over the cached base
+  FRAME_KIND_INFO_BAR = 2,
+  FRAME_KIND_SPEEDO_OVERLAY = 3,
+  FRAME_KIND_PAGE = 4,
+  FRAME_KIND_STATUS_BAR = 5,
+  FRAME_KIND_COUNT = 6
+};
+
+const char* const FRAME_KIND_NAMES[FRAME_KIND_COUNT] = {"map", "layers", "info bar", "speed overlay", "page", "status bar"};
+
+struct FrameSchedulerStats {
+  unsigned long requests[FRAME_PRIORITY_COUNT];  // Submissions - each used to be a refresh of its own
+  unsigned long updates[FRAME_PRIORITY_COUNT];   // Panel updates, by merged priority
+  unsigned long kinds[FRAME_KIND_COUNT];         // Panel updates, by what they drew
+};
+
+struct FrameSchedulerState {
+  uint8_t pending;              // FrameRegion bits
+  FramePriority priority;       // Highest priority among pending
+  unsigned long lastUpdateMs;
+  unsigned long windowStartMs;
+  FrameSchedulerStats window;   // Since the last report
+  FrameSchedulerStats total;
+};
+
+FrameSchedulerState frameScheduler = {0, FRAME_PRIORITY_STATUS, 0, 0};
+
+// Mark regions stale; the scheduler refreshes them in the next open slot
+void submitFrame(uint8_t regions, FramePriority priority) {
+  if (!frameScheduler.pending || priority > frameScheduler.priority) frameScheduler.priority = priority;
+  frameScheduler.pending |= regions;
+  frameScheduler.window.requests[priority]++;
+  frameScheduler.total.requests[priority]++;
+}
+
+// Page change: the new page renders itself in full
+void clearFrameRequests() {
+  frameScheduler.pending = 0;
+}
+
+bool isFrameSlotOpen(FramePriority priority) {
+  return millis() - frameScheduler.lastUpdateMs >= FRAME_SLOT_MS[priority];
+}
+
+// A panel update covering these regions happened (scheduled, or a render task flush)
+void noteFrameUpdate(uint8_t covered, FramePriority priority, FrameKind kind) {
+  frameScheduler.pending &= ~covered;
+  frameScheduler.lastUpdateMs = millis();
+  frameScheduler.window.updates[priority]++;
+  frameScheduler.total.updates[priority]++;
+  frameScheduler.window.kinds[kind]++;
+  frameScheduler.total.kinds[kind]++;
+}
+
+static unsigned long sumFrameCounts(const unsigned long* counts) {
+  unsigned long sum = 0;
+  for (int i = 0; i < FRAME_PRIORITY_COUNT; i++) sum += counts[i];
+  return sum;
+}
+
+static void printFrameCounts(const char* label, const FrameSchedulerStats& s, unsigned long elapsedMs) {
+  unsigned long requests = sumFrameCounts(s.requests);
+  unsigned long updates = sumFrameCounts(s.updates);
+  float minutes = elapsedMs / 60000.0f;
+  if (minutes <= 0) return;
+  Serial.printf("[FRAME] %s: %.1f refreshes/min requested, %.1f panel updates/min (input %lu/%lu, navigation %lu/%lu, status %lu/%lu)\n",
+                label, requests / minutes, updates / minutes,
+                s.updates[FRAME_PRIORITY_INPUT], s.requests[FRAME_PRIORITY_INPUT],
+                s.updates[FRAME_PRIORITY_NAVIGATION], s.requests[FRAME_PRIORITY_NAVIGATION],
+                s.updates[FRAME_PRIORITY_STATUS], s.requests[FRAME_PRIORITY_STATUS]);
+  Serial.printf("[FRAME] %s updates:", label);
+  for (int k = 0; k < FRAME_KIND_COUNT; k++) {
+    Serial.printf(" %s %lu%s", FRAME_KIND_NAMES[k], s.kinds[k], k < FRAME_KIND_COUNT - 1 ? "," : "\n");
+  }
+}
+
+// Requests per minute are what the producers refreshed on their own before
+static void reportFrameRate() {
+  unsigned long now = millis();
+  unsigned long elapsed = now - frameScheduler.windowStartMs;
+  if (elapsed < FRAME_REPORT_INTERVAL_MS) return;
+
+  if (sumFrameCounts(frameScheduler.window.requests) > 0) {
+    printFrameCounts("Last minute", frameScheduler.window, elapsed);
+    printFrameCounts("Since boot", frameScheduler.total, now);
+  }
+  memset(&frameScheduler.window, 0, sizeof(frameScheduler.window));
+  frameScheduler.windowStartMs = now;
+}
+
+/**
+ * Turn the pending regions into at most one panel update, if the slot of
+ * their priority is open. Call once per loop(), after the producers ran.
+ */
+void serviceFrameScheduler() {
+  reportFrameRate();
+
+  uint8_t pending = frameScheduler.pending;
+  if (!pending) return;
+  FramePriority priority = frameScheduler.priority;
+
+  if (isMapViewShown()) {
+    pending &= FRAME_REGIONS_MAP_VIEW;
+    if (pending && !(pending & FRAME_REGION_MAP) && isMapBaseLayerCurrent()) {
+      // Only layers above the map changed: recomposite them over the cached base
+      if (isMapRenderInFlight()) return;  // The coming frame covers them
+      if (!isFrameSlotOpen(priority)) return;
+      if (refreshMapLayers(pending)) {
+        frameScheduler.pending = 0;
+        noteFrameUpdate(pending, priority, FRAME_KIND_LAYERS);
+        return;
+      }
+      // No usable base after all: the bands go out with a full map frame
+      pending |= FRAME_REGION_MAP;
+      frameScheduler.pending |= FRAME_REGION_MAP;
+    }
+    if ((pending & (FRAME_REGION_MAP | FRAME_REGION_PAGE)) && isMapRenderTaskRunning()) {
+      // Posting to the render task is no panel update: the frame composes
+      // while the slot runs out, pollMapRenderTask() pushes it
+      frameScheduler.pending &= ~(FRAME_REGION_MAP | FRAME_REGION_PAGE);
+      loadAndDisplayMap();
+      return;
+    }
+    if (isMapRenderInFlight()) return;  // The coming frame covers the bands
+    if (!pending) {
+      frameScheduler.pending = 0;
+      return;
+    }
+    if (!isFrameSlotOpen(priority)) return;
+
+    frameScheduler.pending = 0;
+    FrameKind kind;
+    if (pending == FRAME_REGION_INFO_BAR) {
+      refreshMapInfoBar();
+      kind = FRAME_KIND_INFO_BAR;
+    } else if (pending == FRAME_REGION_SPEEDO_OVERLAY) {
+      renderSpeedometerSplitOverlay();
+      kind = FRAME_KIND_SPEEDO_OVERLAY;
+    } else {
+      loadAndDisplayMap();
+      kind = FRAME_KIND_MAP;
+    }
+    noteFrameUpdate(pending, priority, kind);
+    return;
+  }
+
+  // Map view bands are stale once the map view is gone
+  pending &= FRAME_REGION_PAGE | FRAME_REGION_STATUS_BAR;
+  if (!pending) {
+    frameScheduler.pending = 0;
+    return;
+  }
+  if (!isFrameSlotOpen(priority)) return;
+
+  frameScheduler.pending = 0;
+  if (pending & FRAME_REGION_PAGE) {
+    forceNotificationRefresh();
+  } else {
+    refreshStatusBar();
+  }
+  noteFrameUpdate(pending, priority, (pending & FRAME_REGION_PAGE) ? FRAME_KIND_PAGE : FRAME_KIND_STATUS_BAR);
+}
+
+#endif // FRAME_SCHEDULER_H
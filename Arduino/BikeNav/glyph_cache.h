@@ -0,0 +1,381 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+#include <U8g2_for_Adafruit_GFX.h>
+#include "display_buffer.h"
+
+// External references from BikeNav.ino
+extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
+extern const int DISPLAY_WIDTH;
+extern const int DISPLAY_HEIGHT;
+
+// --- GLYPH SPRITE CACHE ---
+// The status bar, navigation info bar and speedometer overlay redraw the
+// same few characters (digits, units, separators) on every refresh, and
+// u8g2 decodes each glyph's RLE bitmap every time. Here the glyphs of the
+// hot fonts are rasterized once at startup into trimmed 1bpp sprites and
+// text is drawn by table lookup + blit. Output is pixel-identical to u8g2:
+// same cursor advance, same ink. Strings with a character outside the
+// cached set fall back to u8g2 as a whole.
+#define GLYPH_ATLAS_BYTES 4096        // Sprite bits for all cached fonts
+#define GLYPH_MAX_PER_FONT 32
+#define GLYPH_RASTER_WIDTH 64         // Scratch canvas, larger than any cached glyph
+#define GLYPH_RASTER_HEIGHT 64
+#define GLYPH_RASTER_ORIGIN_X 16      // Cursor position in the scratch canvas
+#define GLYPH_RASTER_BASELINE 48
+
+enum GlyphFontId {
+  GLYPH_FONT_HELVB08,   // Status bar, info bar values, units
+  GLYPH_FONT_HELVB14,   // Navigation distance
+  GLYPH_FONT_FUB30,     // Speedometer overlay speed
+  GLYPH_FONT_COUNT
+};
+
+struct GlyphFontSpec {
+  const uint8_t* font;
+  const char* charset;  // UTF-8, code points below 256
+};
+
+const GlyphFontSpec GLYPH_FONT_SPECS[GLYPH_FONT_COUNT] = {
+  {u8g2_font_helvB08_tf, "0123456789.,:-+%/ kmhNoGPS\xC2\xB0"},
+  {u8g2_font_helvB14_tf, "0123456789.,- km"},
+  {u8g2_font_fub30_tn,   "0123456789.-"},
+};
+
+struct GlyphSprite {
+  int8_t xOffset;       // Left edge relative to the cursor
+  int8_t yOffset;       // Top edge relative to the baseline (negative = above)
+  uint8_t width;
+  uint8_t height;
+  uint8_t advance;      // Cursor step, same as u8g2
+  uint16_t bits;        // Offset into glyphAtlas.bits: rows of (width + 7) / 8 bytes, MSB first, 1 = ink
+};
+
+struct GlyphFontCache {
+  uint8_t slot[256];    // Sprite index per code point, 0xFF = not cached
+  GlyphSprite sprites[GLYPH_MAX_PER_FONT];
+  int count;
+};
+
+struct GlyphAtlas {
+  uint8_t* bits;        // PSRAM
+  uint16_t used;
+  bool ready;
+  GlyphFontCache fonts[GLYPH_FONT_COUNT];
+  unsigned long spriteDraws;     // Strings drawn from sprites
+  unsigned long fallbackDraws;   // Strings handed to u8g2
+};
+
+GlyphAtlas glyphAtlas = {nullptr, 0, false};
+
+// Next code point of a UTF-8 string; 0 at the end, 0xFFFF for anything not cacheable
+static uint16_t nextGlyphCode(const char** text) {
+  const uint8_t* s = (const uint8_t*)*text;
+  if (s[0] == 0) return 0;
+  if (s[0] < 0x80) {
+    *text += 1;
+    return s[0];
+  }
+  if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+    *text += 2;
+    uint16_t code = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    return code < 256 ? code : 0xFFFF;
+  }
+  // Longer sequence: skip the lead byte and its continuation bytes
+  *text += 1;
+  while ((**text & 0xC0) == 0x80) *text += 1;
+  return 0xFFFF;
+}
+
+/**
+ * Rasterize one glyph into the scratch canvas and store its trimmed ink
+ * as a sprite. Returns false when the atlas is full.
+ */
+static bool rasterizeGlyph(GFXcanvas1& canvas, U8G2_FOR_ADAFRUIT_GFX& rasterizer,
+                           GlyphFontCache& cache, uint16_t code, const char* utf8) {
+  canvas.fillScreen(0);
+  rasterizer.setCursor(GLYPH_RASTER_ORIGIN_X, GLYPH_RASTER_BASELINE);
+  rasterizer.print(utf8);
+
+  const uint8_t* raster = canvas.getBuffer();
+  const int rasterRowBytes = (GLYPH_RASTER_WIDTH + 7) / 8;
+  int left = GLYPH_RASTER_WIDTH, right = -1, top = GLYPH_RASTER_HEIGHT, bottom = -1;
+  for (int y = 0; y < GLYPH_RASTER_HEIGHT; y++) {
+    for (int x = 0; x < GLYPH_RASTER_WIDTH; x++) {
+      if (!(raster[y * rasterRowBytes + (x >> 3)] & (0x80 >> (x & 7)))) continue;
+      if (x < left) left = x;
+      if (x > right) right = x;
+      if (y < top) top = y;
+      if (y > bottom) bottom = y;
+    }
+  }
+
+  GlyphSprite& sprite = cache.sprites[cache.count];
+  sprite.advance = rasterizer.getUTF8Width(utf8);
+  sprite.bits = glyphAtlas.used;
+  if (right < 0) {
+    // No ink (space)
+    sprite.xOffset = 0;
+    sprite.yOffset = 0;
+    sprite.width = 0;
+    sprite.height = 0;
+  } else {
+    sprite.xOffset = left - GLYPH_RASTER_ORIGIN_X;
+    sprite.yOffset = top - GLYPH_RASTER_BASELINE;
+    sprite.width = right - left + 1;
+    sprite.height = bottom - top + 1;
+
+    int rowBytes = (sprite.width + 7) / 8;
+    if (glyphAtlas.used + rowBytes * sprite.height > GLYPH_ATLAS_BYTES) return false;
+    uint8_t* dst = glyphAtlas.bits + glyphAtlas.used;
+    memset(dst, 0, rowBytes * sprite.height);
+    for (int y = 0; y < sprite.height; y++) {
+      for (int x = 0; x < sprite.width; x++) {
+        int rx = left + x;
+        if (raster[(top + y) * rasterRowBytes + (rx >> 3)] & (0x80 >> (rx & 7))) {
+          dst[y * rowBytes + (x >> 3)] |= 0x80 >> (x & 7);
+        }
+      }
+    }
+    glyphAtlas.used += rowBytes * sprite.height;
+  }
+
+  cache.slot[code] = cache.count++;
+  return true;
+}
+
+/**
+ * Build the sprite atlas for GLYPH_FONT_SPECS. Call once after
+ * u8g2_display.begin(). Without it (or on allocation failure) all text
+ * goes through u8g2.
+ */
+bool initGlyphCache() {
+  if (glyphAtlas.ready) return true;
+
+  unsigned long start = micros();
+  glyphAtlas.bits = (uint8_t*)ps_malloc(GLYPH_ATLAS_BYTES);
+  if (!glyphAtlas.bits) {
+    Serial.println("[GLYPH] ERROR: Failed to allocate glyph atlas");
+    return false;
+  }
+
+  GFXcanvas1 canvas(GLYPH_RASTER_WIDTH, GLYPH_RASTER_HEIGHT);
+  if (!canvas.getBuffer()) {
+    Serial.println("[GLYPH] ERROR: Failed to allocate raster canvas");
+    free(glyphAtlas.bits);
+    glyphAtlas.bits = nullptr;
+    return false;
+  }
+  U8G2_FOR_ADAFRUIT_GFX rasterizer;
+  rasterizer.begin(canvas);
+  rasterizer.setFontMode(1);
+  rasterizer.setFontDirection(0);
+  rasterizer.setForegroundColor(1);
+
+  int glyphs = 0;
+  for (int f = 0; f < GLYPH_FONT_COUNT; f++) {
+    GlyphFontCache& cache = glyphAtlas.fonts[f];
+    memset(cache.slot, 0xFF, sizeof(cache.slot));
+    cache.count = 0;
+    rasterizer.setFont(GLYPH_FONT_SPECS[f].font);
+
+    const char* charset = GLYPH_FONT_SPECS[f].charset;
+    while (*charset) {
+      const char* glyphStart = charset;
+      uint16_t code = nextGlyphCode(&charset);
+      if (code == 0xFFFF || cache.slot[code] != 0xFF) continue;
+      if (cache.count >= GLYPH_MAX_PER_FONT) break;
+
+      char utf8[4] = {0};
+      memcpy(utf8, glyphStart, charset - glyphStart);
+      if (!rasterizeGlyph(canvas, rasterizer, cache, code, utf8)) {
+        Serial.printf("[GLYPH] Atlas full at font %d, remaining glyphs use u8g2\n", f);
+        break;
+      }
+      glyphs++;
+    }
+  }
+
+  glyphAtlas.ready = true;
+  Serial.printf("[GLYPH] Cached %d glyphs of %d fonts in %u bytes, %lu us\n",
+                glyphs, GLYPH_FONT_COUNT, glyphAtlas.used, micros() - start);
+  return true;
+}
+
+// Sprites for every character of text, or false if any is not cached
+static bool lookupGlyphs(GlyphFontId font, const char* text, const GlyphSprite** sprites, int maxGlyphs, int* count) {
+  if (!glyphAtlas.ready) return false;
+  const GlyphFontCache& cache = glyphAtlas.fonts[font];
+  *count = 0;
+  while (true) {
+    uint16_t code = nextGlyphCode(&text);
+    if (code == 0) return true;
+    if (code == 0xFFFF || cache.slot[code] == 0xFF || *count >= maxGlyphs) return false;
+    sprites[(*count)++] = &cache.sprites[cache.slot[code]];
+  }
+}
+
+/**
+ * Width of text in font, as u8g2_display.getUTF8Width() would report it.
+ * Leaves the u8g2 font set to font when it has to fall back.
+ */
+int glyphTextWidth(GlyphFontId font, const char* text) {
+  const GlyphSprite* sprites[32];
+  int count;
+  if (!lookupGlyphs(font, text, sprites, 32, &count)) {
+    u8g2_display.setFont(GLYPH_FONT_SPECS[font].font);
+    return u8g2_display.getUTF8Width(text);
+  }
+  int width = 0;
+  for (int i = 0; i < count; i++) width += sprites[i]->advance;
+  return width;
+}
+
+/**
+ * Draw text in black with its baseline at y, starting at cursor x, like
+ * u8g2_display.setCursor(x, y) + print(text) in font mode 1. With a
+ * directly addressable framebuffer every text row is ORed together from
+ * all glyphs and written once; partial windows go through drawBitmap().
+ * Returns the cursor advance. Leaves the u8g2 font set to font when it has
+ * to fall back.
+ */
+int drawGlyphText(GlyphFontId font, int x, int y, const char* text) {
+  const GlyphSprite* sprites[32];
+  int count;
+  if (!lookupGlyphs(font, text, sprites, 32, &count)) {
+    glyphAtlas.fallbackDraws++;
+    u8g2_display.setFont(GLYPH_FONT_SPECS[font].font);
+    u8g2_display.setCursor(x, y);
+    u8g2_display.print(text);
+    return u8g2_display.getUTF8Width(text);
+  }
+  glyphAtlas.spriteDraws++;
+
+  if (!isDisplayBufferDirect()) {
+    int cursor = x;
+    for (int i = 0; i < count; i++) {
+      const GlyphSprite& s = *sprites[i];
+      if (s.width > 0) {
+        display.drawBitmap(cursor + s.xOffset, y + s.yOffset, glyphAtlas.bits + s.bits,
+                           s.width, s.height, GxEPD_BLACK);
+      }
+      cursor += s.advance;
+    }
+    return cursor - x;
+  }
+
+  // Rows touched by any glyph
+  int top = 0, bottom = 0, width = 0;
+  for (int i = 0; i < count; i++) {
+    width += sprites[i]->advance;
+    if (sprites[i]->width == 0) continue;
+    if (sprites[i]->yOffset < top) top = sprites[i]->yOffset;
+    if (sprites[i]->yOffset + sprites[i]->height > bottom) bottom = sprites[i]->yOffset + sprites[i]->height;
+  }
+
+  uint8_t blackMask[DISPLAY_BUFFER_ROW_BYTES];
+  for (int row = top; row < bottom; row++) {
+    int dstY = y + row;
+    if (dstY < 0 || dstY >= DISPLAY_HEIGHT) continue;
+    memset(blackMask, 0, sizeof(blackMask));
+    bool anyBlack = false;
+
+    int cursor = x;
+    for (int i = 0; i < count; i++) {
+      const GlyphSprite& s = *sprites[i];
+      int spriteRow = row - s.yOffset;
+      if (spriteRow >= 0 && spriteRow < s.height) {
+        int rowBytes = (s.width + 7) / 8;
+        const uint8_t* src = glyphAtlas.bits + s.bits + spriteRow * rowBytes;
+        int left = cursor + s.xOffset;
+        int shift = left & 7;
+        for (int b = 0; b < rowBytes; b++) {
+          if (!src[b]) continue;
+          int k = (left >> 3) + b;  // Arithmetic shift floors negative positions
+          if (k >= 0 && k < DISPLAY_BUFFER_ROW_BYTES) blackMask[k] |= src[b] >> shift;
+          if (shift && k + 1 >= 0 && k + 1 < DISPLAY_BUFFER_ROW_BYTES) blackMask[k + 1] |= (uint8_t)(src[b] << (8 - shift));
+          anyBlack = true;
+        }
+      }
+      cursor += s.advance;
+    }
+
+    if (anyBlack) displayApplyRowMask(dstY, blackMask);
+  }
+
+  return width;
+}
+
+#if BIKENAV_DEBUG_COMMANDS
+/**
+ * Debug: draw sample strings of every cached font through u8g2 and through
+ * the sprites, check that both give the same pixels and print the timings.
+ * Leaves the framebuffer cleared (never refreshed to the panel) - redraw the
+ * page afterwards.
+ */
+void benchmarkGlyphCache() {
+  const struct { GlyphFontId font; const char* text; } samples[] = {
+    {GLYPH_FONT_HELVB08, "12:47"},
+    {GLYPH_FONT_HELVB08, "87%"},
+    {GLYPH_FONT_HELVB08, "+350m"},
+    {GLYPH_FONT_HELVB08, "215\xC2\xB0"},
+    {GLYPH_FONT_HELVB14, "1.4km"},
+    {GLYPH_FONT_HELVB14, "850m"},
+    {GLYPH_FONT_FUB30, "27.5"},
+  };
+  const int sampleCount = sizeof(samples) / sizeof(samples[0]);
+  const int iterations = 50;
+  const int baseline = 60;
+
+  if (!glyphAtlas.ready) {
+    Serial.println("[GLYPH] Cache not initialized");
+    return;
+  }
+
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);  // Framebuffer state only, no refresh
+  u8g2_display.setFontMode(1);
+  u8g2_display.setForegroundColor(GxEPD_BLACK);
+  u8g2_display.setBackgroundColor(GxEPD_WHITE);
+
+  Serial.println("=== GLYPH CACHE BENCHMARK ===");
+  Serial.println("text        u8g2 us  sprite us  speedup  diff px");
+  uint8_t u8g2Rows[64][DISPLAY_BUFFER_ROW_BYTES];
+  uint8_t row[DISPLAY_BUFFER_ROW_BYTES];
+  for (int s = 0; s < sampleCount; s++) {
+    const char* text = samples[s].text;
+    GlyphFontId font = samples[s].font;
+
+    display.fillScreen(GxEPD_WHITE);
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++) {
+      u8g2_display.setFont(GLYPH_FONT_SPECS[font].font);
+      u8g2_display.setCursor(4, baseline);
+      u8g2_display.print(text);
+    }
+    unsigned long u8g2Us = micros() - start;
+    for (int y = 0; y < 64; y++) displayReadRow(baseline - 48 + y, 0, DISPLAY_WIDTH, u8g2Rows[y]);
+
+    display.fillScreen(GxEPD_WHITE);
+    start = micros();
+    for (int i = 0; i < iterations; i++) {
+      drawGlyphText(font, 4, baseline, text);
+    }
+    unsigned long spriteUs = micros() - start;
+
+    int diff = 0;
+    for (int y = 0; y < 64; y++) {
+      displayReadRow(baseline - 48 + y, 0, DISPLAY_WIDTH, row);
+      for (int k = 0; k < DISPLAY_BUFFER_ROW_BYTES; k++) diff += __builtin_popcount(row[k] ^ u8g2Rows[y][k]);
+    }
+    Serial.printf("%-10s  %7lu  %9lu  %6.1fx  %7d\n", text, u8g2Us / iterations, spriteUs / iterations,
+                  spriteUs ? (float)u8g2Us / spriteUs : 0.0f, diff);
+  }
+  Serial.printf("Strings drawn: %lu from sprites, %lu through u8g2\n",
+                glyphAtlas.spriteDraws, glyphAtlas.fallbackDraws);
+  Serial.println("=============================");
+  display.fillScreen(GxEPD_WHITE);
+}
+#endif // BIKENAV_DEBUG_COMMANDS
+
+#endif // GLYPH_CACHE_H
@@ -0,0 +1,267 @@
+#ifndef HOST_SKETCH_H
+#define HOST_SKETCH_H
+
+// --- HOST SKETCH ---
+// The map half of BikeNav.ino for a PC: the same includes in the same
+// order (timezone.h .. page_speedometer.h), compiled against the stand-ins
+// in host/stubs, plus the globals and functions BikeNav.ino and the BLE /
+// page headers that stay on the device would otherwise provide. Include it
+// from exactly one .cpp per executable, like the sketch itself.
+
+#include <GxEPD2_BW.h>
+#include <U8g2_for_Adafruit_GFX.h>
+#include <TinyGPS++.h>
+#include <SPI.h>
+#include <SD.h>
+#include <time.h>
+#include <sys/time.h>
+
+// --- PAGE MANAGEMENT ENUM (as in BikeNav.ino) ---
+enum PageType {
+  PAGE_MAIN_MENU,
+  PAGE_MAP,
+  PAGE_SPEEDOMETER,
+  PAGE_PHONE_APP,
+  PAGE_WEATHER,
+  PAGE_GAMES,
+  PAGE_INFO,
+  PAGE_SHUTDOWN,
+  PAGE_SETTINGS,
+  PAGE_TRACKER,
+  PAGE_RECORDING,
+  PAGE_RECORDING_OPTIONS,
+  PAGE_WEATHER_OPTIONS,
+  PAGE_SNAKE
+};
+
+// The host build always compiles the debug code, so it cannot rot
+#define BIKENAV_DEBUG_COMMANDS 1
+
+void navigateToPage(PageType page);
+
+// From ble_handler.h, which needs the ESP32 BLE stack
+class BLEServer;
+#define RADAR_IMAGE_WIDTH 128
+#define RADAR_IMAGE_HEIGHT 296
+#define RADAR_IMAGE_BYTES ((RADAR_IMAGE_WIDTH * RADAR_IMAGE_HEIGHT) / 8)
+
+#include "timezone.h"
+#include "bitmaps.h"
+#include "tile_cache.h"
+#include "tile_presence.h"
+#include "battery_manager.h"
+#include "notification_system.h"
+#include "status_bar.h"
+#include "page_map.h"
+#include "page_speedometer.h"
+
+// --- GLOBALS FROM BIKENAV.INO ---
+GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display(GxEPD2_290_BS(10, 1, 2, 3));
+U8G2_FOR_ADAFRUIT_GFX u8g2_display;
+TinyGPSPlus gps;
+BatteryManager batteryManager;
+
+const int DISPLAY_WIDTH = 128;
+const int DISPLAY_HEIGHT = 296;
+
+double currentLat = 50.102382;
+double currentLon = 14.392353;
+bool gpsValid = false;
+bool sdCardPresent = false;
+bool navigationActive = false;
+PageType currentPage = PAGE_MAP;
+bool bluetoothEnabled = true;
+
+volatile bool buttonPressed = false;
+volatile bool backPressed = false;
+volatile bool waitingForButtonRelease = false;
+
+bool isUserInputPending() { return buttonPressed || backPressed; }
+void readGPSSerial() {}
+void navigateToPage(PageType page) { currentPage = page; }
+
+LocalTime getLocalTime() {
+  LocalTime localTime = {};
+  return localTime;
+}
+
+// --- STATE FROM BLE_HANDLER.H / PAGE_RADAR.H ---
+BLEServer* pServer = nullptr;
+bool deviceConnected = false;
+bool tileHeaderReceived = false;
+bool radarHasError = false;
+bool radarOverlayEnabled = false;
+bool radarMapLightenEnabled = false;
+bool navigateHomeHasError = false;
+char navigateHomeErrorMessage[64] = "";
+unsigned long navigateHomeRequestTime = 0;
+const char* MAP_INDEX_PATH = "/Map/index.bin";
+const uint8_t TILE_INV_RECORD_SIZE = 9;
+
+bool isBLEConnected() { return false; }
+void requestNavigateHome() {}
+void sendActiveTripUpdate() {}
+void sendNotificationDismissal(uint32_t id) { (void)id; }
+
+// Pages the host does not build
+void renderMainMenu() {}
+void renderPhoneAppPage() {}
+void renderWeatherPage() {}
+void renderGamesPage() {}
+void renderInfoPage() {}
+void renderSettingsPage() {}
+void renderTrackerPage() {}
+void renderRecordingPage() {}
+void renderRecordingOptionsPage() {}
+
+// --- HOST HELPERS ---
+
+/**
+ * setup() for the map: SD rooted at sdRoot, display in the sketch rotation,
+ * the tile cache, the presence filter from the synthetic index and the
+ * map page. Serial output is muted unless verbose.
+ */
+inline bool hostSketchBegin(const std::string& sdRoot, bool verbose = false) {
+  Serial.quiet = !verbose;
+  SD.setRoot(sdRoot);
+  sdCardPresent = SD.begin();
+  initSpiBus();
+  display.init(115200, true, 50, false);
+  display.setRotation(2);
+  if (!checkDisplayBufferLayout()) return false;
+  u8g2_display.begin(display);
+  initGlyphCache();
+  if (!initTileCache()) return false;
+  if (sdCardPresent) loadTilePresenceFilter(MAP_INDEX_PATH);
+  initMapPage();
+  return sdCardPresent;
+}
+
+// Logical framebuffer as one byte per pixel, 1 = black
+inline void hostSnapshotDisplay(std::vector<uint8_t>& pixels) {
+  pixels.assign(DISPLAY_WIDTH * DISPLAY_HEIGHT, 0);
+  uint8_t row[DISPLAY_BUFFER_ROW_BYTES];
+  for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+    displayReadRow(y, 0, DISPLAY_WIDTH, row);
+    for (int x = 0; x < DISPLAY_WIDTH; x++) {
+      pixels[y * DISPLAY_WIDTH + x] = !(row[x >> 3] & (0x80 >> (x & 7)));
+    }
+  }
+}
+
+// Binary PBM (P4) of a snapshot, on the host file system
+inline bool hostWritePbm(const std::string& path, const std::vector<uint8_t>& pixels, int width, int height) {
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp) return false;
+  fprintf(fp, "P4\n%d %d\n", width, height);
+  int rowBytes = (width + 7) / 8;
+  std::vector<uint8_t> row(rowBytes);
+  for (int y = 0; y < height; y++) {
+    std::fill(row.begin(), row.end(), 0);
+    for (int x = 0; x < width; x++) {
+      if (pixels[y * width + x]) row[x >> 3] |= 0x80 >> (x & 7);
+    }
+    fwrite(row.data(), 1, rowBytes, fp);
+  }
+  return fclose(fp) == 0;
+}
+
+// --- SYNTHETIC TILE SET ---
+// Streets on a jittered grid, a few diagonals and filled blocks, drawn in
+// world pixels so neighbouring tiles join up. A tile is left out when its
+// hash says so (about 1 in 12), so missing tiles and the presence filter
+// get exercised. index.bin lists exactly the tiles written.
+
+inline uint32_t hostTileHash(uint32_t a, uint32_t b, uint32_t c) {
+  uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u) * 0x85EBCA77u ^ (c + 0x165667B1u) * 0xC2B2AE3Du;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return h;
+}
+
+inline bool hostTileExists(int zoom, uint32_t tileX, uint32_t tileY) {
+  return hostTileHash(zoom, tileX, tileY) % 12 != 0;
+}
+
+inline void hostDrawSyntheticTile(GFXcanvas1& canvas, int zoom, uint32_t tileX, uint32_t tileY) {
+  canvas.fillScreen(1);  // 1 = white, as in the .bin tiles
+  int64_t originX = (int64_t)tileX * 256;
+  int64_t originY = (int64_t)tileY * 256;
+  // Streets every 64 world pixels, jittered per street so rotation shows
+  const int spacing = 64;
+  for (int64_t s = (originX / spacing) - 1; s <= (originX + 256) / spacing + 1; s++) {
+    int x = (int)(s * spacing - originX) + (int)(hostTileHash(zoom, (uint32_t)s, 1) % 9) - 4;
+    int w = 1 + hostTileHash(zoom, (uint32_t)s, 2) % 3;
+    canvas.fillRect(x, 0, w, 256, 0);
+  }
+  for (int64_t s = (originY / spacing) - 1; s <= (originY + 256) / spacing + 1; s++) {
+    int y = (int)(s * spacing - originY) + (int)(hostTileHash(zoom, (uint32_t)s, 3) % 9) - 4;
+    int h = 1 + hostTileHash(zoom, (uint32_t)s, 4) % 3;
+    canvas.fillRect(0, y, 256, h, 0);
+  }
+  // World diagonals x - y = 256k and x + y = 256k cross every tile corner to corner
+  canvas.drawLine(0, 0, 255, 255, 0);
+  canvas.drawLine(1, 255, 255, 1, 0);
+  // A filled block and a ring per tile
+  uint32_t h = hostTileHash(zoom, tileX, tileY);
+  canvas.fillRect(16 + h % 96, 16 + (h >> 8) % 96, 12 + (h >> 16) % 40, 8 + (h >> 20) % 30, 0);
+  canvas.drawCircle(128 + (int)((h >> 4) % 64) - 32, 128 + (int)((h >> 12) % 64) - 32, 10 + (h >> 24) % 30, 0);
+}
+
+/**
+ * Write tiles for every zoom in ZOOM_LEVELS covering radius tiles around
+ * lat/lon to <dir>/Map/z/x/y.bin, and <dir>/Map/index.bin. Returns the
+ * number of tiles written.
+ */
+inline int hostWriteSyntheticTiles(const std::string& dir, double lat, double lon, int radius) {
+  std::string mapDir = dir + "/Map";
+  ::mkdir(dir.c_str(), 0755);
+  ::mkdir(mapDir.c_str(), 0755);
+  FILE* index = fopen((mapDir + "/index.bin").c_str(), "wb");
+  if (!index) return 0;
+
+  GFXcanvas1 canvas(256, 256);
+  int written = 0;
+  for (size_t z = 0; z < sizeof(ZOOM_LEVELS) / sizeof(ZOOM_LEVELS[0]); z++) {
+    int zoom = ZOOM_LEVELS[z];
+    int n = 1 << zoom;
+    int centerX = (int)((lon + 180.0) / 360.0 * n);
+    double latRad = lat * M_PI / 180.0;
+    int centerY = (int)((1.0 - log(tan(latRad) + 1.0 / cos(latRad)) / M_PI) / 2.0 * n);
+
+    std::string zoomDir = mapDir + "/" + std::to_string(zoom);
+    ::mkdir(zoomDir.c_str(), 0755);
+    for (int tx = centerX - radius; tx <= centerX + radius; tx++) {
+      std::string xDir = zoomDir + "/" + std::to_string(tx);
+      ::mkdir(xDir.c_str(), 0755);
+      for (int ty = centerY - radius; ty <= centerY + radius; ty++) {
+        if (!hostTileExists(zoom, tx, ty)) continue;
+        hostDrawSyntheticTile(canvas, zoom, tx, ty);
+        FILE* fp = fopen((xDir + "/" + std::to_string(ty) + ".bin").c_str(), "wb");
+        if (!fp) continue;
+        fwrite(canvas.getBuffer(), 1, 8192, fp);
+        fclose(fp);
+        uint8_t record[9] = {(uint8_t)zoom,
+                             (uint8_t)(tx >> 24), (uint8_t)(tx >> 16), (uint8_t)(tx >> 8), (uint8_t)tx,
+                             (uint8_t)(ty >> 24), (uint8_t)(ty >> 16), (uint8_t)(ty >> 8), (uint8_t)ty};
+        fwrite(record, 1, sizeof(record), index);
+        written++;
+      }
+    }
+  }
+  fclose(index);
+  return written;
+}
+
+// Switch the map layout the way the zoom / navigation handlers do
+inline void hostSetMapView(int zoomIndex, int rotation, bool navLayout) {
+  currentZoomIndex = zoomIndex;
+  zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+  mapRotation = rotation;
+  currentInfoBarHeight = navLayout ? MAP_INFO_BAR_HEIGHT_NAV : MAP_INFO_BAR_HEIGHT_NORMAL;
+  MAP_DISPLAY_HEIGHT = DISPLAY_HEIGHT - currentInfoBarHeight;
+  currentCenterY = navLayout ? CENTER_Y_NAV : CENTER_Y_NORMAL;
+}
+
+#endif // HOST_SKETCH_H
@@ -0,0 +1,230 @@
+// --- HOST MAP BENCHMARK ---
+// The map pipeline of the device firmware on a PC, over a synthetic tile
+// set written to a directory that stands in for the SD card:
+//   pipeline - MAP_BENCH_VIEWS from map_benchmark.h, per-stage timings
+//              (select / sd / blit / route) as median and min over the
+//              repetitions, SD opens and bytes per view, a PBM per view
+//   rotation - full frames of all-black tiles at 0, 37 and 90 degrees,
+//              with the unpainted (hole) pixel count
+//   index    - tile cache key lookup, linear scan vs hash index
+// Host timings rank changes against each other; absolute numbers for the
+// ESP32-S3 still come from the device ('b' debug command).
+//
+// Usage: map_bench [--out DIR] [--reps N] [--verbose]
+
+#include "host_sketch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+static unsigned long medianOf(std::vector<unsigned long> v) {
+  std::sort(v.begin(), v.end());
+  return v.empty() ? 0 : v[v.size() / 2];
+}
+
+static unsigned long minOf(const std::vector<unsigned long>& v) {
+  return v.empty() ? 0 : *std::min_element(v.begin(), v.end());
+}
+
+// --- PIPELINE ---
+static bool benchmarkPipeline(const std::string& outDir, int reps) {
+  double lat = currentLat;
+  double lon = currentLon;
+  TrackPoint* track = buildBenchRoute(lat, lon);
+  if (!track) return false;
+  navigationTrack = track;
+  navigationTrackPointCount = MAP_BENCH_ROUTE_POINTS;
+
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  tileCacheLock();
+  getRouteGeometry(navigationTrack, navigationTrackPointCount);
+
+  printf("=== RENDER PIPELINE BENCHMARK (%d reps, median / min us) ===\n", reps);
+  printf("view              tiles  read  select          sd              blit            route           "
+         "opens  KB read\n");
+  bool ok = true;
+  std::vector<uint8_t> pixels;
+  for (int v = 0; v < MAP_BENCH_VIEW_COUNT; v++) {
+    const MapBenchView& view = MAP_BENCH_VIEWS[v];
+    hostSetMapView(view.zoomIndex, view.rotation, view.navLayout);
+
+    std::vector<unsigned long> selectUs, sdUs, blitUs, routeUs;
+    MapBenchStages stages = {};
+    File::Stats before = File::stats();
+    for (int r = 0; r < reps; r++) {
+      renderBenchView(lat, lon, view.route, &stages);
+      selectUs.push_back(stages.selectUs);
+      sdUs.push_back(stages.sdReadUs);
+      blitUs.push_back(stages.blitUs);
+      routeUs.push_back(stages.routeUs);
+    }
+    File::Stats after = File::stats();
+
+    printf("%-16s  %5d  %4d  %6lu / %-6lu  %6lu / %-6lu  %6lu / %-6lu  %6lu / %-6lu  %5lu  %7lu\n",
+           view.name, stages.tiles, stages.tilesRead,
+           medianOf(selectUs), minOf(selectUs), medianOf(sdUs), minOf(sdUs),
+           medianOf(blitUs), minOf(blitUs), medianOf(routeUs), minOf(routeUs),
+           (after.opens - before.opens) / reps, (after.bytesRead - before.bytesRead) / reps / 1024);
+
+    hostSnapshotDisplay(pixels);
+    std::string path = outDir + "/" + view.name + ".pbm";
+    if (!hostWritePbm(path, pixels, DISPLAY_WIDTH, DISPLAY_HEIGHT)) {
+      printf("Failed to write %s\n", path.c_str());
+      ok = false;
+    }
+    if (stages.tiles == 0) ok = false;
+  }
+  printf("Images written to %s/\n", outDir.c_str());
+
+  tileCacheUnlock();
+  releaseRouteGeometry(track);
+  navigationTrack = nullptr;
+  navigationTrackPointCount = 0;
+  free(track);
+  return ok;
+}
+
+// --- ROTATION ---
+// Full map frame of synthetic all-black tiles at 0, 37 and 90 degrees, with
+// the number of unpainted map pixels (holes) - must stay 0.
+static bool benchmarkMapRenderer() {
+  static uint8_t tile[8192];
+  memset(tile, 0x00, sizeof(tile));
+
+  const int angles[3] = {0, 37, 90};
+  hostSetMapView(1, 0, false);
+  radarMapLightenEnabled = false;
+  bool direct = isDisplayBufferDirect();
+  bool ok = direct;
+
+  printf("=== MAP RENDERER BENCHMARK ===\n");
+  for (int a = 0; a < 3; a++) {
+    mapRotation = angles[a];
+    display.fillScreen(GxEPD_WHITE);
+
+    unsigned long start = micros();
+    collectVisibleTiles(0, 0, CENTER_X - 128, currentCenterY - 128);
+    int tiles = tileCount;
+    for (int i = 0; i < tileCount; i++) {
+      if (mapRotation == 0 && direct) {
+        renderTileRowsDirect(tile, tilesToRender[i].screenX, tilesToRender[i].screenY);
+      } else {
+        renderTileRotated(tile, tilesToRender[i].screenX, tilesToRender[i].screenY);
+      }
+    }
+    unsigned long elapsed = micros() - start;
+
+    long holes = 0;
+    const uint8_t* buffer = getDisplayBuffer();
+    for (int y = 0; y < MAP_DISPLAY_HEIGHT; y++) {
+      const uint8_t* row = buffer + (DISPLAY_BUFFER_ROWS - 1 - y) * DISPLAY_BUFFER_ROW_BYTES;
+      for (int k = 0; k < DISPLAY_BUFFER_ROW_BYTES; k++) {
+        holes += __builtin_popcount(row[k]);
+      }
+    }
+    if (holes != 0) ok = false;
+    printf("%3d deg: %d tiles, %lu us/frame, holes %ld (%lu source px forward-mapped before)\n",
+           angles[a], tiles, elapsed, holes, (unsigned long)tiles * 65536UL);
+  }
+  printf("==============================\n");
+
+  mapRotation = 0;
+  display.fillScreen(GxEPD_WHITE);
+  return ok;
+}
+
+// --- INDEX ---
+// The old linear key scan vs the hash index at several cache sizes, on
+// key-only tables so the live cache is never touched.
+static void benchmarkTileCacheIndex() {
+  const int sizes[] = {768, 2048, 4096};
+  const int lookups = 20000;
+
+  printf("=== TILE CACHE INDEX BENCHMARK ===\n");
+  for (int s = 0; s < 3; s++) {
+    int n = sizes[s];
+    int buckets = 1;
+    while (buckets < n * 2) buckets <<= 1;
+
+    std::vector<int32_t> keys(n * 3), next(n), heads(buckets, TILE_CACHE_NONE);
+    for (int i = 0; i < n; i++) {
+      // Square-ish block of z15 tiles, like a downloaded region
+      keys[i * 3] = 15;
+      keys[i * 3 + 1] = 17600 + (i % 64);
+      keys[i * 3 + 2] = 11100 + (i / 64);
+      uint32_t h = tileCacheKeyHash(keys[i * 3], keys[i * 3 + 1], keys[i * 3 + 2]) & (buckets - 1);
+      next[i] = heads[h];
+      heads[h] = i;
+    }
+
+    // Half hits, half misses, spread over the whole table
+    volatile int found = 0;
+    unsigned long start = micros();
+    for (int q = 0; q < lookups; q++) {
+      int k = (q * 7919) % n;
+      int y = keys[k * 3 + 2] + ((q & 1) ? 1000 : 0);
+      for (int i = 0; i < n; i++) {
+        if (keys[i * 3] == 15 && keys[i * 3 + 1] == keys[k * 3 + 1] && keys[i * 3 + 2] == y) {
+          found++;
+          break;
+        }
+      }
+    }
+    unsigned long linearUs = micros() - start;
+
+    start = micros();
+    for (int q = 0; q < lookups; q++) {
+      int k = (q * 7919) % n;
+      int x = keys[k * 3 + 1];
+      int y = keys[k * 3 + 2] + ((q & 1) ? 1000 : 0);
+      int32_t i = heads[tileCacheKeyHash(15, x, y) & (buckets - 1)];
+      while (i != TILE_CACHE_NONE) {
+        if (keys[i * 3] == 15 && keys[i * 3 + 1] == x && keys[i * 3 + 2] == y) {
+          found++;
+          break;
+        }
+        i = next[i];
+      }
+    }
+    unsigned long hashUs = micros() - start;
+
+    printf("%4d entries: linear %.3f us/lookup, hash %.4f us/lookup (%.0fx)\n",
+           n, (double)linearUs / lookups, (double)hashUs / lookups,
+           hashUs > 0 ? (double)linearUs / hashUs : 0.0);
+  }
+  printf("==================================\n");
+}
+
+int main(int argc, char** argv) {
+  std::string outDir = "bench";
+  int reps = 5;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--out" && i + 1 < argc) {
+      outDir = argv[++i];
+    } else if (arg == "--reps" && i + 1 < argc) {
+      reps = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--verbose") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "usage: %s [--out DIR] [--reps N] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  ::mkdir(outDir.c_str(), 0755);
+  std::string sdRoot = outDir + "/sd";
+  int tiles = hostWriteSyntheticTiles(sdRoot, currentLat, currentLon, 3);
+  if (tiles == 0 || !hostSketchBegin(sdRoot, verbose)) {
+    fprintf(stderr, "Failed to set up the tile set in %s\n", sdRoot.c_str());
+    return 1;
+  }
+  printf("Synthetic tile set: %d tiles in %s/Map\n", tiles, sdRoot.c_str());
+
+  bool ok = benchmarkPipeline(outDir, reps);
+  ok = benchmarkMapRenderer() && ok;
+  benchmarkTileCacheIndex();
+  return ok ? 0 : 1;
+}
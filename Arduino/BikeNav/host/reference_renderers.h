@@ -0,0 +1,243 @@
+#ifndef REFERENCE_RENDERERS_H
+#define REFERENCE_RENDERERS_H
+
+// --- REFERENCE RENDERERS ---
+// The per-pixel map renderers as they were before the fast paths (commit
+// 98922c0, map_rendering.h): the cached-tile loop of loadAndRenderTile(),
+// drawRadarOverlay() and drawNavigationRoute(). The pixel loops are kept
+// verbatim - only the names changed, the tile data is passed in instead of
+// looked up, and the Serial logging is gone. getTileCoordinates() and
+// clipLineToRect() are still the original ones in map_rendering.h.
+// render_equivalence.cpp compares the live renderers against these.
+
+#include "host_sketch.h"
+
+const int REFERENCE_MAX_ROUTE_SEGMENTS = 300;  // MAX_ROUTE_SEGMENTS of the original
+
+// loadAndRenderTile(), STEP 2: render tile from memory (cache)
+void referenceRenderTile(const uint8_t* tileData, int screenX, int screenY) {
+  // Pre-calculate rotation parameters
+  float rotationRad = mapRotation * M_PI / 180.0;
+  float cosAngle = cos(rotationRad);
+  float sinAngle = sin(rotationRad);
+
+  // Render from cached tile data
+  for (int y = 0; y < 256; y++) {
+    // Calculate byte offset for this line (32 bytes per line)
+    int lineOffset = y * 32;
+
+    for (int x = 0; x < 256; x++) {
+      // Extract bit (1 = white, 0 = black)
+      int byteIndex = lineOffset + (x / 8);
+      uint8_t byteVal = tileData[byteIndex];
+      uint8_t bitIndex = 7 - (x % 8);
+      bool isWhite = (byteVal >> bitIndex) & 1;
+
+      // Skip white pixels (background)
+      if (isWhite) {
+        continue;
+      }
+      if (radarMapLightenEnabled && ((x + y) & 1)) {
+        continue;
+      }
+
+      // Calculate original screen position (before rotation)
+      int screenX_original = screenX + x;
+      int screenY_original = screenY + y;
+
+      int screenX_final = screenX_original;
+      int screenY_final = screenY_original;
+
+      // Apply rotation around center point (CENTER_X, currentCenterY)
+      if (mapRotation != 0) {
+        // Translate to origin (relative to center point)
+        float relX = screenX_original - CENTER_X;
+        float relY = screenY_original - currentCenterY;
+
+        // Apply rotation
+        float rotatedX = relX * cosAngle - relY * sinAngle;
+        float rotatedY = relX * sinAngle + relY * cosAngle;
+
+        // Translate back
+        screenX_final = (int)(rotatedX + CENTER_X + 0.5);
+        screenY_final = (int)(rotatedY + currentCenterY + 0.5);
+      }
+
+      // Skip if outside display area
+      if (screenX_final < 0 || screenX_final >= DISPLAY_WIDTH ||
+          screenY_final < 0 || screenY_final >= MAP_DISPLAY_HEIGHT) {
+        continue;
+      }
+
+      // Draw pixel
+      display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
+    }
+  }
+}
+
+void referenceDrawRadarOverlay(const uint8_t* frameData) {
+  if (!radarOverlayEnabled || radarHasError || frameData == nullptr) return;
+
+  const int bytesPerRow = RADAR_IMAGE_WIDTH / 8;
+  int yOffset = currentCenterY - (DISPLAY_HEIGHT / 2);
+
+  float rotationRad = mapRotation * M_PI / 180.0;
+  float cosAngle = cos(rotationRad);
+  float sinAngle = sin(rotationRad);
+
+  for (int y = 0; y < RADAR_IMAGE_HEIGHT; y++) {
+    int screenY_original = y + yOffset;
+    int rowOffset = y * bytesPerRow;
+
+    for (int x = 0; x < RADAR_IMAGE_WIDTH; x++) {
+      int byteIndex = rowOffset + (x / 8);
+      uint8_t byteVal = frameData[byteIndex];
+      uint8_t bitIndex = 7 - (x % 8);
+      bool isWhite = (byteVal >> bitIndex) & 1;
+
+      if (isWhite) continue;
+
+      int screenX_original = x;
+      int screenX_final = screenX_original;
+      int screenY_final = screenY_original;
+
+      if (mapRotation != 0) {
+        float relX = screenX_original - CENTER_X;
+        float relY = screenY_original - currentCenterY;
+        float rotatedX = relX * cosAngle - relY * sinAngle;
+        float rotatedY = relX * sinAngle + relY * cosAngle;
+        screenX_final = (int)(rotatedX + CENTER_X + 0.5);
+        screenY_final = (int)(rotatedY + currentCenterY + 0.5);
+      }
+
+      if (screenX_final < 0 || screenX_final >= DISPLAY_WIDTH ||
+          screenY_final < 0 || screenY_final >= MAP_DISPLAY_HEIGHT) {
+        continue;
+      }
+
+      display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
+    }
+  }
+}
+
+void referenceDrawNavigationRoute(double centerLat, double centerLon) {
+  // Check if we have a navigation track loaded
+  if (navigationTrack == nullptr || navigationTrackPointCount < 2) {
+    return;
+  }
+
+  // Get line width for current zoom level
+  int lineWidth = ROUTE_LINE_WIDTH[currentZoomIndex];
+
+  // Calculate downsampling step for performance
+  // Aim for MAX_ROUTE_SEGMENTS line segments maximum
+  int step = max(1, navigationTrackPointCount / REFERENCE_MAX_ROUTE_SEGMENTS);
+
+  // Get center tile coordinates (map center - GPS or scrubbed position)
+  int centerTileX, centerTileY;
+  double centerPixelX, centerPixelY;
+  getTileCoordinates(centerLat, centerLon, zoomLevel,
+                    &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
+
+  // Pre-calculate rotation parameters
+  float rotationRad = mapRotation * M_PI / 180.0;
+  float cosAngle = cos(rotationRad);
+  float sinAngle = sin(rotationRad);
+
+  // Draw route segments
+  for (int i = 0; i < navigationTrackPointCount - step; i += step) {
+    // Get two consecutive points for this segment
+    double lat1 = navigationTrack[i].lat;
+    double lon1 = navigationTrack[i].lon;
+    double lat2 = navigationTrack[i + step].lat;
+    double lon2 = navigationTrack[i + step].lon;
+
+    // Convert point 1 to screen coordinates
+    int tile1X, tile1Y;
+    double pixel1X, pixel1Y;
+    getTileCoordinates(lat1, lon1, zoomLevel, &tile1X, &tile1Y, &pixel1X, &pixel1Y);
+
+    // Calculate screen position (non-rotated) - use double precision to avoid rounding errors
+    double screen1X_original = CENTER_X + (tile1X - centerTileX) * 256.0 + (pixel1X - centerPixelX);
+    double screen1Y_original = currentCenterY + (tile1Y - centerTileY) * 256.0 + (pixel1Y - centerPixelY);
+
+    // Convert point 2 to screen coordinates
+    int tile2X, tile2Y;
+    double pixel2X, pixel2Y;
+    getTileCoordinates(lat2, lon2, zoomLevel, &tile2X, &tile2Y, &pixel2X, &pixel2Y);
+
+    // Use double precision for accurate coordinate transformation
+    double screen2X_original = CENTER_X + (tile2X - centerTileX) * 256.0 + (pixel2X - centerPixelX);
+    double screen2Y_original = currentCenterY + (tile2Y - centerTileY) * 256.0 + (pixel2Y - centerPixelY);
+
+    // Apply rotation if needed
+    int screen1X_final, screen1Y_final, screen2X_final, screen2Y_final;
+
+    if (mapRotation != 0) {
+      // Rotate point 1 - use double precision for accuracy
+      double rel1X = screen1X_original - CENTER_X;
+      double rel1Y = screen1Y_original - currentCenterY;
+      double rotated1X = rel1X * cosAngle - rel1Y * sinAngle;
+      double rotated1Y = rel1X * sinAngle + rel1Y * cosAngle;
+      screen1X_final = (int)(rotated1X + CENTER_X + 0.5);
+      screen1Y_final = (int)(rotated1Y + currentCenterY + 0.5);
+
+      // Rotate point 2 - use double precision for accuracy
+      double rel2X = screen2X_original - CENTER_X;
+      double rel2Y = screen2Y_original - currentCenterY;
+      double rotated2X = rel2X * cosAngle - rel2Y * sinAngle;
+      double rotated2Y = rel2X * sinAngle + rel2Y * cosAngle;
+      screen2X_final = (int)(rotated2X + CENTER_X + 0.5);
+      screen2Y_final = (int)(rotated2Y + currentCenterY + 0.5);
+    } else {
+      // No rotation - round to nearest pixel
+      screen1X_final = (int)(screen1X_original + 0.5);
+      screen1Y_final = (int)(screen1Y_original + 0.5);
+      screen2X_final = (int)(screen2X_original + 0.5);
+      screen2Y_final = (int)(screen2Y_original + 0.5);
+    }
+
+    // Properly clip the line segment to the map display area to prevent drawing over info bar
+    // Use Cohen-Sutherland algorithm for accurate clipping
+    int clipped1X = screen1X_final;
+    int clipped1Y = screen1Y_final;
+    int clipped2X = screen2X_final;
+    int clipped2Y = screen2Y_final;
+
+    if (!clipLineToRect(&clipped1X, &clipped1Y, &clipped2X, &clipped2Y,
+                        0, 0, DISPLAY_WIDTH, MAP_DISPLAY_HEIGHT)) {
+      // Line is completely outside viewport - skip it
+      continue;
+    }
+
+    // Draw line with configured thickness
+    // For lineWidth=1: draw single line
+    // For lineWidth>1: draw with filled circle brush at each point
+    if (lineWidth == 1) {
+      display.drawLine(clipped1X, clipped1Y, clipped2X, clipped2Y, GxEPD_BLACK);
+    } else {
+      // Draw the main line first
+      display.drawLine(clipped1X, clipped1Y, clipped2X, clipped2Y, GxEPD_BLACK);
+
+      // Add thickness by drawing offset lines in a cross pattern
+      int halfWidth = lineWidth / 2;
+      for (int offset = 1; offset <= halfWidth; offset++) {
+        // Draw offset lines in 4 directions for better coverage at all angles
+        display.drawLine(clipped1X - offset, clipped1Y, clipped2X - offset, clipped2Y, GxEPD_BLACK);
+        display.drawLine(clipped1X + offset, clipped1Y, clipped2X + offset, clipped2Y, GxEPD_BLACK);
+        display.drawLine(clipped1X, clipped1Y - offset, clipped2X, clipped2Y - offset, GxEPD_BLACK);
+        display.drawLine(clipped1X, clipped1Y + offset, clipped2X, clipped2Y + offset, GxEPD_BLACK);
+
+        // Add diagonal offsets for even better coverage at 45-degree angles
+        if (offset == 1) {
+          display.drawLine(clipped1X - offset, clipped1Y - offset, clipped2X - offset, clipped2Y - offset, GxEPD_BLACK);
+          display.drawLine(clipped1X + offset, clipped1Y - offset, clipped2X + offset, clipped2Y - offset, GxEPD_BLACK);
+          display.drawLine(clipped1X - offset, clipped1Y + offset, clipped2X - offset, clipped2Y + offset, GxEPD_BLACK);
+          display.drawLine(clipped1X + offset, clipped1Y + offset, clipped2X + offset, clipped2Y + offset, GxEPD_BLACK);
+        }
+      }
+    }
+  }
+}
+
+#endif // REFERENCE_RENDERERS_H
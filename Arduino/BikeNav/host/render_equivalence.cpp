@@ -0,0 +1,549 @@
+// --- RENDER EQUIVALENCE ---
+// The live map renderers against the original per-pixel loops
+// (reference_renderers.h) on randomized views of the synthetic tile set:
+// center, zoom, rotation, info bar layout (browse / navigation) and radar
+// lightening are drawn from a seeded generator.
+//   tiles  - calculateVisibleTiles() + loadAndRenderTile(), cache cold or warm
+//   canvas - renderMapFromCanvas() in runs of small moves (reuse, scroll, refill)
+//   task   - composeMapRenderFrame() into a render task frame, same canvas
+//   radar  - map with drawRadarOverlay() as the radar page composes it
+//   route  - drawNavigationRoute() for tracks of up to 300 points
+//   layers - GPS jitter after a full map frame: the cached base must stay
+//            valid exactly while the drawn pixel is the same, and the
+//            recomposite (refreshMapLayers()) must match a full frame
+// Every differing pixel is measured as its distance (8-neighbourhood rings)
+// to the nearest black pixel of the other image:
+//   north-up tiles, canvas, radar and layers - exact, 0 px
+//   rotated - the original forward mapping leaves holes and rounds each
+//             source pixel on its own, the live renderers sample every
+//             screen pixel once; 1 px lines land up to ROTATED_TOLERANCE_PX
+//             apart, and that ring along the map edges is not compared
+//   route   - the original brush is a cross of offset lines, the live one a
+//             capsule of the line width: ROUTE_TOLERANCE_PX (half the widest
+//             line); the original clips before offsetting, so the brush
+//             stops short of the map edges - ROUTE_EDGE_PX is not compared
+// The live renderers must not draw below the map area (layers compares the
+// whole screen, info bar included). Cases above the
+// tolerance fail; the first failure of each suite is written as
+// <out>/<suite>-ref.pbm and <out>/<suite>-live.pbm.
+//
+// Usage: render_equivalence [--cases N] [--seed S] [--out DIR] [--verbose]
+
+#include "reference_renderers.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define TILE_SET_RADIUS 5        // Synthetic tiles around the base position, per zoom
+#define CENTER_SPREAD_TILES 3    // Case centers within this many tiles of the base
+#define REFERENCE_RADIUS_PX 340  // Reference renders every tile this close to the center (> rotated extent)
+#define ROTATED_TOLERANCE_PX 2
+#define ROUTE_EDGE_PX 4
+#define ROUTE_TOLERANCE_PX 3
+#define ROUTE_MAX_POINTS 300
+
+static const double BASE_LAT = 50.102382;
+static const double BASE_LON = 14.392353;
+
+static std::string outDir = "equivalence";
+
+// --- RANDOM ---
+static uint32_t rngState = 1;
+
+static uint32_t nextRandom() {
+  uint32_t x = rngState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rngState = x;
+  return x;
+}
+
+// Uniform in [lo, hi)
+static int randomRange(int lo, int hi) {
+  return lo + (int)(nextRandom() % (uint32_t)(hi - lo));
+}
+
+static bool randomChance(int percent) {
+  return randomRange(0, 100) < percent;
+}
+
+// --- VIEWS ---
+static void worldToLatLon(double wx, double wy, int zoom, double* lat, double* lon) {
+  double n = 256.0 * (1 << zoom);
+  *lon = wx / n * 360.0 - 180.0;
+  *lat = atan(sinh(M_PI * (1.0 - 2.0 * wy / n))) * 180.0 / M_PI;
+}
+
+static void latLonToWorld(double lat, double lon, int zoom, double* wx, double* wy) {
+  int tileX, tileY;
+  double pixelX, pixelY;
+  getTileCoordinates(lat, lon, zoom, &tileX, &tileY, &pixelX, &pixelY);
+  *wx = tileX * 256.0 + pixelX;
+  *wy = tileY * 256.0 + pixelY;
+}
+
+struct EquivalenceView {
+  double lat, lon;
+};
+
+// Random layout and a center within CENTER_SPREAD_TILES of the base position
+static EquivalenceView pickView(bool allowRotation) {
+  int rotation = allowRotation && randomChance(65) ? randomRange(1, 360) : 0;
+  hostSetMapView(randomRange(0, 10), rotation, randomChance(50));
+
+  double baseX, baseY;
+  latLonToWorld(BASE_LAT, BASE_LON, zoomLevel, &baseX, &baseY);
+  int spread = CENTER_SPREAD_TILES * 256;
+  EquivalenceView view;
+  worldToLatLon(baseX + randomRange(-spread, spread) + randomRange(0, 1000) / 1000.0,
+                baseY + randomRange(-spread, spread) + randomRange(0, 1000) / 1000.0,
+                zoomLevel, &view.lat, &view.lon);
+  return view;
+}
+
+// --- REFERENCE TILES ---
+// Read straight from the tile files, independent of the tile cache
+static const uint8_t* referenceTileData(int zoom, int tileX, int tileY) {
+  static std::map<std::tuple<int, int, int>, std::vector<uint8_t>> tiles;
+  auto key = std::make_tuple(zoom, tileX, tileY);
+  auto it = tiles.find(key);
+  if (it == tiles.end()) {
+    std::vector<uint8_t> data;
+    char path[96];
+    snprintf(path, sizeof(path), "%s/Map/%d/%d/%d.bin", SD.getRoot().c_str(), zoom, tileX, tileY);
+    FILE* fp = fopen(path, "rb");
+    if (fp) {
+      data.resize(8192);
+      if (fread(data.data(), 1, 8192, fp) != 8192) data.clear();
+      fclose(fp);
+    }
+    it = tiles.emplace(key, std::move(data)).first;
+  }
+  return it->second.empty() ? nullptr : it->second.data();
+}
+
+// Every tile within REFERENCE_RADIUS_PX of the rotation center, no visibility test
+static void referenceRenderMap(const EquivalenceView& view) {
+  int centerTileX, centerTileY;
+  double centerPixelX, centerPixelY;
+  getTileCoordinates(view.lat, view.lon, zoomLevel, &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
+  int centerTileScreenX = CENTER_X - (int)centerPixelX;
+  int centerTileScreenY = currentCenterY - (int)centerPixelY;
+
+  for (int dy = -3; dy <= 3; dy++) {
+    for (int dx = -3; dx <= 3; dx++) {
+      int screenX = centerTileScreenX + dx * 256;
+      int screenY = centerTileScreenY + dy * 256;
+      if (screenX + 256 < CENTER_X - REFERENCE_RADIUS_PX || screenX > CENTER_X + REFERENCE_RADIUS_PX) continue;
+      if (screenY + 256 < currentCenterY - REFERENCE_RADIUS_PX || screenY > currentCenterY + REFERENCE_RADIUS_PX) continue;
+      const uint8_t* tileData = referenceTileData(zoomLevel, centerTileX + dx, centerTileY + dy);
+      if (tileData) referenceRenderTile(tileData, screenX, screenY);
+    }
+  }
+}
+
+// --- COMPARISON ---
+struct SuiteResult {
+  const char* name;
+  int cases;
+  int failed;
+  unsigned long diffPixels;
+  int maxDiffPixels;
+  int maxDistance;       // Worst differing pixel, px to black in the other image
+  int maxTolerance;      // Largest tolerance any case was held to
+  unsigned long liveUs;
+  unsigned long referenceUs;
+  char firstFailure[128];
+};
+
+static std::vector<uint8_t> referencePixels, livePixels;
+
+// Chebyshev distance from (x, y) to the nearest black pixel of image, capped at limit + 1
+static int distanceToBlack(const std::vector<uint8_t>& image, int x, int y, int height, int limit) {
+  for (int d = 1; d <= limit; d++) {
+    for (int yy = y - d; yy <= y + d; yy++) {
+      if (yy < 0 || yy >= height) continue;
+      for (int xx = x - d; xx <= x + d; xx++) {
+        if (xx < 0 || xx >= DISPLAY_WIDTH) continue;
+        if (abs(xx - x) != d && abs(yy - y) != d) continue;  // Ring only
+        if (image[yy * DISPLAY_WIDTH + xx]) return d;
+      }
+    }
+  }
+  return limit + 1;
+}
+
+/**
+ * Compare the map area of referencePixels and livePixels, less a ring of
+ * margin px along its edges: count the differing pixels and the worst
+ * distance; the case fails when that distance exceeds tolerance, or when
+ * the live renderer drew below the map area. wholeScreen compares all rows
+ * instead. keyError fails the case regardless of the pixels.
+ */
+static void compareCase(SuiteResult* result, int margin, int tolerance, const char* params,
+                        bool wholeScreen = false, const char* keyError = nullptr) {
+  int height = wholeScreen ? DISPLAY_HEIGHT : MAP_DISPLAY_HEIGHT;
+  int diff = 0;
+  int worst = 0;
+  for (int y = margin; y < height - margin; y++) {
+    for (int x = margin; x < DISPLAY_WIDTH - margin; x++) {
+      int i = y * DISPLAY_WIDTH + x;
+      if (referencePixels[i] == livePixels[i]) continue;
+      diff++;
+      const std::vector<uint8_t>& other = referencePixels[i] ? livePixels : referencePixels;
+      int distance = distanceToBlack(other, x, y, height, tolerance);
+      if (distance > worst) worst = distance;
+    }
+  }
+  int spill = 0;
+  for (int i = height * DISPLAY_WIDTH; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) spill += livePixels[i];
+
+  result->cases++;
+  result->diffPixels += diff;
+  if (diff > result->maxDiffPixels) result->maxDiffPixels = diff;
+  if (worst > result->maxDistance) result->maxDistance = worst;
+  if (tolerance > result->maxTolerance) result->maxTolerance = tolerance;
+  if (worst <= tolerance && spill == 0 && !keyError) return;
+
+  if (result->failed++ == 0) {
+    snprintf(result->firstFailure, sizeof(result->firstFailure), "%s: %d px differ, worst %d px away, %d px below the map%s%s",
+             params, diff, worst, spill, keyError ? ", " : "", keyError ? keyError : "");
+    hostWritePbm(outDir + "/" + result->name + "-ref.pbm", referencePixels, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    hostWritePbm(outDir + "/" + result->name + "-live.pbm", livePixels, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  }
+}
+
+static void describeView(const EquivalenceView& view, char* params, size_t size, const char* extra = "") {
+  snprintf(params, size, "z%d rot %d %s at %.7f, %.7f%s", zoomLevel, mapRotation,
+           currentInfoBarHeight == MAP_INFO_BAR_HEIGHT_NAV ? "nav" : "browse", view.lat, view.lon, extra);
+}
+
+// Rotated, the original rounds at the map edges on its own terms ((int)
+// truncates toward zero, so row / column -1 lands on 0) and the nearest
+// black of the other image may be just off screen, so a ring of
+// ROTATED_TOLERANCE_PX along the map edges is not compared
+static int mapMargin() {
+  return mapRotation == 0 ? 0 : ROTATED_TOLERANCE_PX;
+}
+
+static int mapTolerance() {
+  return mapRotation == 0 ? 0 : ROTATED_TOLERANCE_PX;
+}
+
+// --- SUITES ---
+static void checkTiles(SuiteResult* result) {
+  EquivalenceView view = pickView(true);
+  // Lightening only happens under the radar overlay, which is always north-up
+  radarMapLightenEnabled = mapRotation == 0 && randomChance(25);
+  if (randomChance(30)) tileCacheClear();  // SD read path, not only cache hits
+
+  display.fillScreen(GxEPD_WHITE);
+  unsigned long start = micros();
+  referenceRenderMap(view);
+  result->referenceUs += micros() - start;
+  hostSnapshotDisplay(referencePixels);
+
+  display.fillScreen(GxEPD_WHITE);
+  start = micros();
+  calculateVisibleTiles(view.lat, view.lon, zoomLevel);
+  for (int i = 0; i < tileCount; i++) {
+    loadAndRenderTile(tilesToRender[i].tileX, tilesToRender[i].tileY, zoomLevel,
+                      tilesToRender[i].screenX, tilesToRender[i].screenY);
+  }
+  result->liveUs += micros() - start;
+  hostSnapshotDisplay(livePixels);
+
+  char params[128];
+  describeView(view, params, sizeof(params), radarMapLightenEnabled ? ", lightened" : "");
+  compareCase(result, mapMargin(), mapTolerance(), params);
+  radarMapLightenEnabled = false;
+}
+
+// A run of views sharing one layout, moving a few px at a time (canvas
+// reuse and scrolling) with an occasional jump (full refill). Each view
+// goes through the live canvas or, at random, a render task frame.
+static void checkCanvasRun(SuiteResult* canvasResult, SuiteResult* taskResult, int steps, uint8_t* frame) {
+  EquivalenceView view = pickView(true);
+  double wx, wy;
+  latLonToWorld(view.lat, view.lon, zoomLevel, &wx, &wy);
+  radarMapLightenEnabled = false;
+
+  for (int s = 0; s < steps; s++) {
+    if (randomChance(10)) {
+      wx += randomRange(-400, 400);
+      wy += randomRange(-400, 400);
+    } else {
+      wx += randomRange(-12, 13);
+      wy += randomRange(-12, 13);
+    }
+    if (randomChance(15)) mapRotation = randomChance(30) ? 0 : randomRange(1, 360);
+    worldToLatLon(wx, wy, zoomLevel, &view.lat, &view.lon);
+
+    display.fillScreen(GxEPD_WHITE);
+    unsigned long start = micros();
+    referenceRenderMap(view);
+    unsigned long referenceUs = micros() - start;
+    hostSnapshotDisplay(referencePixels);
+
+    bool viaTask = randomChance(40);
+    SuiteResult* result = viaTask ? taskResult : canvasResult;
+    result->referenceUs += referenceUs;
+    bool composed;
+    start = micros();
+    if (viaTask) {
+      MapRenderRequest request = {view.lat, view.lon, zoomLevel, mapRotation, currentCenterY,
+                                  MAP_DISPLAY_HEIGHT, false, 0, 0};
+      composed = composeMapRenderFrame(request, frame);
+      result->liveUs += micros() - start;
+      memcpy(getDisplayBuffer(), frame, MAP_RENDER_FRAME_BYTES);
+    } else {
+      display.fillScreen(GxEPD_WHITE);
+      composed = renderMapFromCanvas(view.lat, view.lon, zoomLevel);
+      result->liveUs += micros() - start;
+    }
+    hostSnapshotDisplay(livePixels);
+
+    char params[128];
+    describeView(view, params, sizeof(params), composed ? "" : ", NOT COMPOSED");
+    if (!composed) std::fill(livePixels.begin(), livePixels.end(), 1);  // Fails the case
+    compareCase(result, mapMargin(), mapTolerance(), params);
+  }
+}
+
+// Precipitation-like blobs with ragged edges, mostly clear sky
+static void buildRadarFrame(uint8_t* frameData) {
+  GFXcanvas1 canvas(RADAR_IMAGE_WIDTH, RADAR_IMAGE_HEIGHT);
+  canvas.fillScreen(1);
+  int blobs = randomRange(0, 6);
+  for (int b = 0; b < blobs; b++) {
+    canvas.fillCircle(randomRange(-20, RADAR_IMAGE_WIDTH + 20), randomRange(-20, RADAR_IMAGE_HEIGHT + 20),
+                      randomRange(4, 50), 0);
+  }
+  uint8_t* bits = canvas.getBuffer();
+  for (int i = 0; i < RADAR_IMAGE_BYTES; i++) {
+    uint32_t r = nextRandom();
+    if ((r & 0x1F) == 0) bits[i] ^= (uint8_t)(r >> 8);
+  }
+  memcpy(frameData, bits, RADAR_IMAGE_BYTES);
+}
+
+// As drawRadarMapContent() composes it without layers
+static void checkRadar(SuiteResult* result, uint8_t* frameData) {
+  EquivalenceView view = pickView(false);  // drawRadarMapContent() forces rotation 0
+  buildRadarFrame(frameData);
+  radarOverlayEnabled = true;
+
+  display.fillScreen(GxEPD_WHITE);
+  unsigned long start = micros();
+  radarMapLightenEnabled = true;
+  referenceRenderMap(view);
+  referenceDrawRadarOverlay(frameData);
+  result->referenceUs += micros() - start;
+  hostSnapshotDisplay(referencePixels);
+
+  display.fillScreen(GxEPD_WHITE);
+  start = micros();
+  calculateVisibleTiles(view.lat, view.lon, zoomLevel);
+  bool composeLighten = isRadarCompositorDirect();
+  radarMapLightenEnabled = !composeLighten;
+  for (int i = 0; i < tileCount; i++) {
+    loadAndRenderTile(tilesToRender[i].tileX, tilesToRender[i].tileY, zoomLevel,
+                      tilesToRender[i].screenX, tilesToRender[i].screenY);
+  }
+  radarMapLightenEnabled = false;
+  int lightenPhase = -1;
+  if (composeLighten && tileCount > 0) {
+    lightenPhase = (tilesToRender[0].screenX + tilesToRender[0].screenY) & 1;
+  }
+  drawRadarOverlay(frameData, lightenPhase);
+  result->liveUs += micros() - start;
+  hostSnapshotDisplay(livePixels);
+
+  char params[128];
+  describeView(view, params, sizeof(params));
+  compareCase(result, mapMargin(), mapTolerance(), params);
+  radarOverlayEnabled = false;
+}
+
+// Random walk with a slowly turning heading through the view center
+static int buildRoute(TrackPoint* track, const EquivalenceView& view) {
+  int count = randomRange(2, ROUTE_MAX_POINTS + 1);
+  double wx, wy;
+  latLonToWorld(view.lat, view.lon, zoomLevel, &wx, &wy);
+  double heading = randomRange(0, 360) * M_PI / 180.0;
+  double stepPx = randomRange(2, 60);
+  // Start behind the center so the middle of the route crosses the view
+  wx -= cos(heading) * stepPx * count / 2;
+  wy -= sin(heading) * stepPx * count / 2;
+  for (int i = 0; i < count; i++) {
+    double lat, lon;
+    worldToLatLon(wx, wy, zoomLevel, &lat, &lon);
+    track[i].lat = lat;
+    track[i].lon = lon;
+    track[i].elev = 0;
+    heading += randomRange(-30, 31) * M_PI / 180.0 * (randomChance(10) ? 3 : 1) / 10.0;
+    wx += cos(heading) * stepPx;
+    wy += sin(heading) * stepPx;
+  }
+  return count;
+}
+
+static void checkRoute(SuiteResult* result, TrackPoint* track) {
+  EquivalenceView view = pickView(true);
+  navigationTrack = track;
+  navigationTrackPointCount = buildRoute(track, view);
+
+  display.fillScreen(GxEPD_WHITE);
+  unsigned long start = micros();
+  referenceDrawNavigationRoute(view.lat, view.lon);
+  result->referenceUs += micros() - start;
+  hostSnapshotDisplay(referencePixels);
+
+  display.fillScreen(GxEPD_WHITE);
+  start = micros();
+  drawNavigationRoute(view.lat, view.lon);
+  result->liveUs += micros() - start;
+  hostSnapshotDisplay(livePixels);
+
+  char params[128];
+  char extra[48];
+  snprintf(extra, sizeof(extra), ", %d points", navigationTrackPointCount);
+  describeView(view, params, sizeof(params), extra);
+  // The original offset lines run past the clipped map area; only the map area counts
+  compareCase(result, ROUTE_EDGE_PX, ROUTE_TOLERANCE_PX, params);
+
+  releaseRouteGeometry(track);
+  navigationTrack = nullptr;
+  navigationTrackPointCount = 0;
+}
+
+// World pixel the map is drawn around, as the base layer key takes it
+static void drawnPixel(double lat, double lon, int32_t* x, int32_t* y) {
+  int tileX, tileY;
+  double pixelX, pixelY;
+  getTileCoordinates(lat, lon, zoomLevel, &tileX, &tileY, &pixelX, &pixelY);
+  *x = (int32_t)tileX * 256 + (int)pixelX;
+  *y = (int32_t)tileY * 256 + (int)pixelY;
+}
+
+// A full map frame, GPS jitter of up to a pixel (mostly within the drawn
+// one), then the info bar tick the scheduler would recomposite: over the
+// cached base while it is current, against a full frame of the new fix
+static void checkLayers(SuiteResult* result, TrackPoint* track) {
+  EquivalenceView view = pickView(true);
+  radarMapLightenEnabled = false;
+  navigationActive = randomChance(50);
+  if (navigationActive) {
+    navigationTrack = track;
+    navigationTrackPointCount = buildRoute(track, view);
+  }
+  currentLat = view.lat;
+  currentLon = view.lon;
+  loadAndDisplayMap();
+
+  double wx, wy;
+  latLonToWorld(view.lat, view.lon, zoomLevel, &wx, &wy);
+  int jitter = randomChance(80) ? 40 : 100;  // Hundredths of a pixel
+  worldToLatLon(wx + randomRange(-jitter, jitter + 1) / 100.0, wy + randomRange(-jitter, jitter + 1) / 100.0,
+                zoomLevel, &currentLat, &currentLon);
+  int32_t drawnX, drawnY, jitterX, jitterY;
+  drawnPixel(view.lat, view.lon, &drawnX, &drawnY);
+  drawnPixel(currentLat, currentLon, &jitterX, &jitterY);
+  bool samePixel = drawnX == jitterX && drawnY == jitterY;
+  bool current = isMapBaseLayerCurrent();
+
+  const char* keyError = nullptr;
+  if (current != samePixel) keyError = current ? "base kept across pixels" : "base dropped within the pixel";
+  unsigned long start = micros();
+  bool recomposited = current && refreshMapLayers(FRAME_REGION_INFO_BAR);
+  result->liveUs += micros() - start;
+  if (current && !recomposited) keyError = "recomposite failed";
+  hostSnapshotDisplay(livePixels);
+
+  start = micros();
+  invalidateMapLayers();
+  loadAndDisplayMap();
+  result->referenceUs += micros() - start;
+  hostSnapshotDisplay(referencePixels);
+  if (!recomposited) livePixels = referencePixels;  // Nothing recomposited, only the key is checked
+
+  char params[128];
+  describeView(view, params, sizeof(params), navigationActive ? ", route" : "");
+  compareCase(result, 0, 0, params, true, keyError);
+
+  if (navigationActive) releaseRouteGeometry(track);
+  navigationActive = false;
+  navigationTrack = nullptr;
+  navigationTrackPointCount = 0;
+}
+
+static void printResult(const SuiteResult& r) {
+  printf("%-7s %6d  %6d  %10lu  %8d  %6d px  %6d px  %9.1f  %9.1f\n", r.name, r.cases, r.failed,
+         r.diffPixels, r.maxDiffPixels, r.maxDistance, r.maxTolerance,
+         r.cases ? (double)r.liveUs / r.cases : 0.0, r.cases ? (double)r.referenceUs / r.cases : 0.0);
+  if (r.failed) printf("        first failure: %s\n", r.firstFailure);
+}
+
+int main(int argc, char** argv) {
+  int cases = 1000;
+  uint32_t seed = 0x5EEDB1CE;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--cases" && i + 1 < argc) {
+      cases = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--seed" && i + 1 < argc) {
+      seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--out" && i + 1 < argc) {
+      outDir = argv[++i];
+    } else if (arg == "--verbose") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "usage: %s [--cases N] [--seed S] [--out DIR] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+  rngState = seed ? seed : 1;
+
+  ::mkdir(outDir.c_str(), 0755);
+  std::string sdRoot = outDir + "/sd";
+  if (hostWriteSyntheticTiles(sdRoot, BASE_LAT, BASE_LON, TILE_SET_RADIUS) == 0 ||
+      !hostSketchBegin(sdRoot, verbose)) {
+    fprintf(stderr, "Failed to set up the tile set in %s\n", sdRoot.c_str());
+    return 1;
+  }
+  mapCanvas.logFrames = false;
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  if (!isDisplayBufferDirect()) {
+    fprintf(stderr, "Framebuffer not directly addressable\n");
+    return 1;
+  }
+
+  SuiteResult tiles = {"tiles"}, canvas = {"canvas"}, task = {"task"}, radar = {"radar"}, route = {"route"},
+              layers = {"layers"};
+  std::vector<uint8_t> frame(MAP_RENDER_FRAME_BYTES);
+  std::vector<uint8_t> radarFrame(RADAR_IMAGE_BYTES);
+  std::vector<TrackPoint> track(ROUTE_MAX_POINTS);
+
+  for (int i = 0; i < cases; i++) checkTiles(&tiles);
+  while (canvas.cases + task.cases < cases) checkCanvasRun(&canvas, &task, randomRange(1, 25), frame.data());
+  for (int i = 0; i < cases; i++) checkRadar(&radar, radarFrame.data());
+  for (int i = 0; i < cases; i++) checkRoute(&route, track.data());
+  for (int i = 0; i < cases; i++) checkLayers(&layers, track.data());
+
+  printf("=== RENDER EQUIVALENCE (seed 0x%08X) ===\n", seed);
+  printf("suite    cases  failed  diff px     max/case  worst      tolerance  live us    ref us\n");
+  SuiteResult* results[] = {&tiles, &canvas, &task, &radar, &route, &layers};
+  int failed = 0;
+  for (SuiteResult* r : results) {
+    printResult(*r);
+    failed += r->failed;
+  }
+  printf("Tolerance (distance of a differing pixel to black in the other image): north-up exact, "
+         "rotated %d px (edge ring %d px skipped), route %d px (edge ring %d px skipped)\n",
+         ROTATED_TOLERANCE_PX, ROTATED_TOLERANCE_PX, ROUTE_TOLERANCE_PX, ROUTE_EDGE_PX);
+  printf("%s: %d failed cases\n", failed ? "FAIL" : "PASS", failed);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,306 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+// --- HOST STAND-IN: ADAFRUIT GFX ---
+// The primitives the sketch draws with, following Adafruit_GFX's own
+// algorithms (Bresenham writeLine, midpoint circles, MSB-first bitmaps) so
+// reference renderers built on drawLine() produce the same pixels as on
+// the device. Text goes through U8g2_for_Adafruit_GFX, not through here.
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+ public:
+  Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+  void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      std::swap(x0, y0);
+      std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+      std::swap(x0, x1);
+      std::swap(y0, y1);
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+      if (steep) {
+        writePixel(y0, x0, color);
+      } else {
+        writePixel(x0, y0, color);
+      }
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeLine(x, y, x, y + h - 1, color);
+  }
+
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeLine(x, y, x + w - 1, y, color);
+  }
+
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+  }
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) {
+      if (y0 > y1) std::swap(y0, y1);
+      drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    } else if (y0 == y1) {
+      if (x0 > x1) std::swap(x0, x1);
+      drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    } else {
+      writeLine(x0, y0, x1, y1, color);
+    }
+  }
+
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+  }
+
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    writePixel(x0, y0 + r, color);
+    writePixel(x0, y0 - r, color);
+    writePixel(x0 + r, y0, color);
+    writePixel(x0 - r, y0, color);
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      writePixel(x0 + x, y0 + y, color);
+      writePixel(x0 - x, y0 + y, color);
+      writePixel(x0 + x, y0 - y, color);
+      writePixel(x0 - x, y0 - y, color);
+      writePixel(x0 + y, y0 + x, color);
+      writePixel(x0 - y, y0 + x, color);
+      writePixel(x0 + y, y0 - x, color);
+      writePixel(x0 - y, y0 - x, color);
+    }
+  }
+
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+  }
+
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+    delta++;
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      if (x < (y + 1)) {
+        if (corners & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+        if (corners & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+      }
+      if (y != py) {
+        if (corners & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+        if (corners & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+        py = y;
+      }
+      px = x;
+    }
+  }
+
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    drawFastHLine(x + r, y, w - 2 * r, color);
+    drawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    drawFastVLine(x, y + r, h - 2 * r, color);
+    drawFastVLine(x + w - 1, y + r, h - 2 * r, color);
+    drawCircle(x + r, y + r, r, color);  // Whole circles: corners only matter for looks here
+    drawCircle(x + w - r - 1, y + r, r, color);
+    drawCircle(x + r, y + h - r - 1, r, color);
+    drawCircle(x + w - r - 1, y + h - r - 1, r, color);
+  }
+
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    fillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+  }
+
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+  }
+
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    if (y0 > y1) {
+      std::swap(y0, y1);
+      std::swap(x0, x1);
+    }
+    if (y1 > y2) {
+      std::swap(y2, y1);
+      std::swap(x2, x1);
+    }
+    if (y0 > y1) {
+      std::swap(y0, y1);
+      std::swap(x0, x1);
+    }
+    if (y0 == y2) {
+      int16_t a = min(x0, min(x1, x2));
+      int16_t b = max(x0, max(x1, x2));
+      drawFastHLine(a, y0, b - a + 1, color);
+      return;
+    }
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0;
+    int32_t dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    int16_t last = y1 == y2 ? y1 : y1 - 1;
+    int16_t y;
+    for (y = y0; y <= last; y++) {
+      int16_t a = x0 + sa / dy01;
+      int16_t b = x0 + sb / dy02;
+      sa += dx01;
+      sb += dx02;
+      if (a > b) std::swap(a, b);
+      drawFastHLine(a, y, b - a + 1, color);
+    }
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+      int16_t a = x1 + sa / dy12;
+      int16_t b = x0 + sb / dy02;
+      sa += dx12;
+      sb += dx02;
+      if (a > b) std::swap(a, b);
+      drawFastHLine(a, y, b - a + 1, color);
+    }
+  }
+
+  // MSB-first 1bpp bitmap, set bits drawn in color
+  void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t i = 0; i < w; i++) {
+        if (bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7))) writePixel(x + i, y + j, color);
+      }
+    }
+  }
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t i = 0; i < w; i++) {
+        bool set = bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7));
+        writePixel(x + i, y + j, set ? color : bg);
+      }
+    }
+  }
+
+  void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t i = 0; i < w; i++) {
+        if (!(bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7)))) writePixel(x + i, y + j, color);
+      }
+    }
+  }
+
+  void setRotation(uint8_t r) {
+    rotation = r & 3;
+    bool portrait = rotation == 0 || rotation == 2;
+    _width = portrait ? WIDTH : HEIGHT;
+    _height = portrait ? HEIGHT : WIDTH;
+  }
+  uint8_t getRotation() const { return rotation; }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+  // Adafruit's built-in font is not used by the sketch; printed text is dropped
+  void setCursor(int16_t x, int16_t y) {
+    cursorX = x;
+    cursorY = y;
+  }
+  void setTextColor(uint16_t) {}
+  void setTextSize(uint8_t) {}
+  void setTextWrap(bool) {}
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+
+ protected:
+  const int16_t WIDTH;
+  const int16_t HEIGHT;
+  int16_t _width;
+  int16_t _height;
+  uint8_t rotation = 0;
+  int16_t cursorX = 0;
+  int16_t cursorY = 0;
+};
+
+// 1bpp off-screen canvas, rows of (w + 7) / 8 bytes, MSB first, 1 = set
+class GFXcanvas1 : public Adafruit_GFX {
+ public:
+  GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer((uint8_t*)calloc((w + 7) / 8 * h, 1)) {}
+  ~GFXcanvas1() { free(buffer); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    int16_t t;
+    switch (rotation) {
+      case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+      case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+      case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+    }
+    uint8_t* ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+    if (color) {
+      *ptr |= 0x80 >> (x & 7);
+    } else {
+      *ptr &= ~(0x80 >> (x & 7));
+    }
+  }
+
+  void fillScreen(uint16_t color) override {
+    if (buffer) memset(buffer, color ? 0xFF : 0x00, (WIDTH + 7) / 8 * HEIGHT);
+  }
+
+  uint8_t* getBuffer() const { return buffer; }
+
+ private:
+  uint8_t* buffer;
+};
+
+#endif // HOST_ADAFRUIT_GFX_H
@@ -0,0 +1,205 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// --- HOST STAND-IN: ARDUINO CORE ---
+// Just enough of the ESP32 Arduino core for the sketch headers to compile
+// and run on Linux: Serial to stdout, a millis()/micros() clock, PSRAM
+// allocation from the heap and FreeRTOS on std::thread (host_rtos.h).
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// --- CLOCK ---
+// Wall clock since start plus a manual offset: tests advance time with
+// hostAdvanceMillis() instead of sleeping. delay() only advances the offset.
+inline std::chrono::steady_clock::time_point hostClockStart() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return start;
+}
+
+inline unsigned long& hostClockOffsetUs() {
+  static unsigned long offset = 0;
+  return offset;
+}
+
+inline unsigned long micros() {
+  auto elapsed = std::chrono::steady_clock::now() - hostClockStart();
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + hostClockOffsetUs();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+
+inline void hostAdvanceMillis(unsigned long ms) { hostClockOffsetUs() += ms * 1000; }
+
+inline void delay(unsigned long ms) {
+  hostAdvanceMillis(ms);
+  std::this_thread::yield();
+}
+
+inline void delayMicroseconds(unsigned int us) { hostClockOffsetUs() += us; }
+inline void yield() { std::this_thread::yield(); }
+
+// --- RANDOM ---
+inline long random(long howBig) { return howBig > 0 ? ::random() % howBig : 0; }
+inline long random(long howSmall, long howBig) { return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall); }
+inline void randomSeed(unsigned long seed) { srandom((unsigned)seed); }
+
+// --- GPIO ---
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+inline void digitalWrite(int, int) {}
+inline int analogRead(int) { return 0; }
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void detachInterrupt(int) {}
+
+// --- MEMORY ---
+// PSRAM is plain heap; the sizes are what the ESP32-S3 module reports
+struct HostEsp {
+  uint32_t getPsramSize() { return 8u << 20; }
+  uint32_t getFreePsram() { return 6u << 20; }
+  uint32_t getFreeHeap() { return 200u << 10; }
+  uint32_t getHeapSize() { return 320u << 10; }
+};
+inline HostEsp ESP;
+
+inline bool psramFound() { return true; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+inline void* ps_calloc(size_t count, size_t size) { return calloc(count, size); }
+inline void* ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+
+class String;
+
+// --- PRINT ---
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+  size_t print(const char* str) { return write(str); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(const String& str);
+  size_t print(int value, int base = 10) { return print((long)value, base); }
+  size_t print(unsigned int value, int base = 10) { return print((unsigned long)value, base); }
+  size_t print(long value, int base = 10) {
+    if (base != 10) return print((unsigned long)value, base);
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", value);
+    return write(buf);
+  }
+  size_t print(unsigned long value, int base = 10) {
+    char buf[40];
+    if (base == 16) {
+      snprintf(buf, sizeof(buf), "%lX", value);
+    } else {
+      snprintf(buf, sizeof(buf), "%lu", value);
+    }
+    return write(buf);
+  }
+  size_t print(long long value) { return print((long)value); }
+  size_t print(unsigned long long value) { return print((unsigned long)value); }
+  size_t print(double value, int digits = 2) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+  }
+
+  template <typename T>
+  size_t println(const T& value) { return print(value) + println(); }
+  template <typename T>
+  size_t println(const T& value, int format) { return print(value, format) + println(); }
+  size_t println() { return write((uint8_t)'\n'); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    char stackBuf[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(stackBuf, sizeof(stackBuf), format, args);
+    va_end(args);
+    if (len < (int)sizeof(stackBuf)) return write((const uint8_t*)stackBuf, len);
+    std::string big(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+  }
+};
+
+// --- SERIAL ---
+// Written to stdout; hostSerialQuiet() drops the output (tests, benchmarks)
+class HostSerial : public Print {
+ public:
+  bool quiet = false;
+  void begin(unsigned long) {}
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { fflush(stdout); }
+  size_t write(uint8_t c) override {
+    if (!quiet) fputc(c, stdout);
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    if (!quiet) fwrite(buffer, 1, size, stdout);
+    return size;
+  }
+  using Print::write;
+  explicit operator bool() const { return true; }
+};
+inline HostSerial Serial;
+
+#include "WString.h"
+
+inline size_t Print::print(const String& str) { return write((const uint8_t*)str.c_str(), str.length()); }
+
+#include "host_rtos.h"
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,110 @@
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+// --- HOST STAND-IN: ARDUINOJSON ---
+// Trip metadata is one flat object of strings and numbers. This parses
+// exactly that and offers the lookups the sketch makes: doc["key"] as
+// const char* and doc["key"] | default for numbers and strings.
+
+#include <Arduino.h>
+#include <SD.h>
+#include <map>
+
+class DeserializationError {
+ public:
+  enum Code { Ok, InvalidInput, EmptyInput };
+  DeserializationError(Code c = Ok) : code(c) {}
+  explicit operator bool() const { return code != Ok; }
+  const char* c_str() const { return code == Ok ? "Ok" : code == EmptyInput ? "EmptyInput" : "InvalidInput"; }
+
+ private:
+  Code code;
+};
+
+class JsonVariantConst {
+ public:
+  explicit JsonVariantConst(const std::string* value = nullptr, bool isString = false) : value(value), isString(isString) {}
+
+  bool isNull() const { return value == nullptr; }
+  operator const char*() const { return value && isString ? value->c_str() : nullptr; }
+
+  const char* operator|(const char* fallback) const { return value && isString ? value->c_str() : fallback; }
+  int operator|(int fallback) const { return isNumber() ? (int)strtol(value->c_str(), nullptr, 10) : fallback; }
+  long long operator|(long long fallback) const { return isNumber() ? strtoll(value->c_str(), nullptr, 10) : fallback; }
+  unsigned long long operator|(unsigned long long fallback) const {
+    return isNumber() ? strtoull(value->c_str(), nullptr, 10) : fallback;
+  }
+  double operator|(double fallback) const { return isNumber() ? strtod(value->c_str(), nullptr) : fallback; }
+
+ private:
+  bool isNumber() const { return value && !isString; }
+  const std::string* value;
+  bool isString;
+};
+
+class JsonDocument {
+ public:
+  JsonVariantConst operator[](const char* key) const {
+    auto it = values.find(key);
+    if (it == values.end()) return JsonVariantConst();
+    return JsonVariantConst(&it->second.first, it->second.second);
+  }
+  void clear() { values.clear(); }
+
+  std::map<std::string, std::pair<std::string, bool>> values;  // key -> (text, is string)
+};
+
+template <size_t capacity>
+class StaticJsonDocument : public JsonDocument {};
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const std::string& text) {
+  doc.clear();
+  size_t i = 0;
+  auto skip = [&]() {
+    while (i < text.size() && isspace((unsigned char)text[i])) i++;
+  };
+  auto readString = [&](std::string& out) {
+    if (text[i] != '"') return false;
+    for (i++; i < text.size() && text[i] != '"'; i++) {
+      if (text[i] == '\\' && i + 1 < text.size()) i++;
+      out += text[i];
+    }
+    if (i >= text.size()) return false;
+    i++;
+    return true;
+  };
+
+  skip();
+  if (i >= text.size()) return DeserializationError::EmptyInput;
+  if (text[i++] != '{') return DeserializationError::InvalidInput;
+  while (true) {
+    skip();
+    if (i < text.size() && text[i] == '}') return DeserializationError::Ok;
+    std::string key;
+    if (i >= text.size() || !readString(key)) return DeserializationError::InvalidInput;
+    skip();
+    if (i >= text.size() || text[i++] != ':') return DeserializationError::InvalidInput;
+    skip();
+    if (i >= text.size()) return DeserializationError::InvalidInput;
+    std::string value;
+    bool isString = text[i] == '"';
+    if (isString) {
+      if (!readString(value)) return DeserializationError::InvalidInput;
+    } else {
+      while (i < text.size() && text[i] != ',' && text[i] != '}' && !isspace((unsigned char)text[i])) value += text[i++];
+    }
+    doc.values[key] = std::make_pair(value, isString);
+    skip();
+    if (i < text.size() && text[i] == ',') i++;
+  }
+}
+
+inline DeserializationError deserializeJson(JsonDocument& doc, File& file) {
+  std::string text;
+  uint8_t buf[256];
+  size_t n;
+  while ((n = file.read(buf, sizeof(buf))) > 0) text.append((const char*)buf, n);
+  return deserializeJson(doc, text);
+}
+
+#endif // HOST_ARDUINOJSON_H
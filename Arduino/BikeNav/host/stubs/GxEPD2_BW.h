@@ -0,0 +1,230 @@
+#ifndef HOST_GXEPD2_BW_H
+#define HOST_GXEPD2_BW_H
+
+// --- HOST STAND-IN: GXEPD2 ---
+// GxEPD2_BW with the same framebuffer as the library: private _buffer of
+// (WIDTH / 8) * page_height bytes, partial window in _pw_x/_pw_y/_pw_w/_pw_h
+// (physical, x multiple of 8), drawPixel() rotation and window transpose as
+// in GxEPD2_BW.h. display_buffer.h reaches those members directly, so the
+// names, types and bit layout must stay those of the library.
+// The panel is a second bitmap: writeImage()/refresh() and nextPage() copy
+// the window into it, counting refreshes and pushed bytes.
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#define GxEPD_BLACK 0x0000
+#define GxEPD_WHITE 0xFFFF
+#define GxEPD_DARKGREY 0x7BEF
+#define GxEPD_LIGHTGREY 0xC618
+
+class GxEPD2_290_BS {
+ public:
+  static const uint16_t WIDTH = 128;
+  static const uint16_t WIDTH_VISIBLE = WIDTH;
+  static const uint16_t HEIGHT = 296;
+  static const bool hasPartialUpdate = true;
+  static const bool hasFastPartialUpdate = true;
+
+  GxEPD2_290_BS(int16_t cs, int16_t dc, int16_t rst, int16_t busy) : busyPin(busy) {
+    (void)cs;
+    (void)dc;
+    (void)rst;
+    memset(panel, 0xFF, sizeof(panel));
+  }
+
+  void setBusyCallback(void (*callback)(const void*), const void* parameter = 0) {
+    busyCallback = callback;
+    busyParameter = parameter;
+  }
+
+  // Physical coordinates, bitmap rows of w / 8 bytes
+  void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h,
+                  bool invert = false, bool mirror_y = false, bool pgm = false) {
+    (void)mirror_y;
+    (void)pgm;
+    int16_t rowBytes = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+      int16_t py = y + j;
+      if (py < 0 || py >= HEIGHT) continue;
+      for (int16_t i = 0; i < rowBytes; i++) {
+        int16_t px = x / 8 + i;
+        if (px < 0 || px >= WIDTH / 8) continue;
+        uint8_t data = bitmap[j * rowBytes + i];
+        panel[py * (WIDTH / 8) + px] = invert ? ~data : data;
+      }
+    }
+    bytesWritten += (unsigned long)rowBytes * h;
+  }
+
+  // The waveform: one busy poll, so a busy callback sees every refresh
+  void refresh(int16_t x, int16_t y, int16_t w, int16_t h) {
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;
+    refreshes++;
+    if (busyCallback) busyCallback(busyParameter);
+  }
+  void refresh(bool partial_update_mode = false) { refresh(0, 0, WIDTH, HEIGHT); (void)partial_update_mode; }
+  void powerOff() {}
+  void hibernate() {}
+
+  int16_t busyPin;
+  uint8_t panel[WIDTH / 8 * HEIGHT];  // What the screen shows, same layout as the buffer
+  unsigned long refreshes = 0;
+  unsigned long bytesWritten = 0;
+
+ private:
+  void (*busyCallback)(const void*) = nullptr;
+  const void* busyParameter = nullptr;
+};
+
+template <typename GxEPD_Type, const uint16_t page_height>
+class GxEPD2_BW : public Adafruit_GFX {
+ public:
+  GxEPD_Type epd2;
+
+  GxEPD2_BW(GxEPD_Type epd2_instance) : Adafruit_GFX(GxEPD_Type::WIDTH_VISIBLE, GxEPD_Type::HEIGHT), epd2(epd2_instance) {
+    _page_height = page_height;
+    _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+    _using_partial_mode = false;
+    _current_page = 0;
+    setFullWindow();
+  }
+
+  void init(uint32_t serial_diag_bitrate = 0) { (void)serial_diag_bitrate; }
+  void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 10, bool pulldown_rst_mode = false) {
+    (void)serial_diag_bitrate;
+    (void)initial;
+    (void)reset_duration;
+    (void)pulldown_rst_mode;
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+    switch (getRotation()) {
+      case 1:
+        std::swap(x, y);
+        x = WIDTH - x - 1;
+        break;
+      case 2:
+        x = WIDTH - x - 1;
+        y = HEIGHT - y - 1;
+        break;
+      case 3:
+        std::swap(x, y);
+        y = HEIGHT - y - 1;
+        break;
+    }
+    // Transpose partial window to 0,0 and clip to it
+    x -= _pw_x;
+    y -= _pw_y;
+    if ((x < 0) || (x >= int16_t(_pw_w)) || (y < 0) || (y >= int16_t(_pw_h))) return;
+    // Adjust for current page
+    y -= _current_page * _page_height;
+    if ((y < 0) || (y >= int16_t(_page_height))) return;
+    uint16_t i = x / 8 + y * (_pw_w / 8);
+    if (color) {
+      _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
+    } else {
+      _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    }
+  }
+
+  void fillScreen(uint16_t color) override {
+    uint8_t data = (color == GxEPD_BLACK) ? 0x00 : 0xFF;
+    for (uint16_t x = 0; x < sizeof(_buffer); x++) _buffer[x] = data;
+  }
+
+  void setFullWindow() {
+    _using_partial_mode = false;
+    _pw_x = 0;
+    _pw_y = 0;
+    _pw_w = WIDTH;
+    _pw_h = HEIGHT;
+  }
+
+  void setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    _rotate(x, y, w, h);
+    _using_partial_mode = true;
+    _pw_x = std::min(x, (uint16_t)WIDTH);
+    _pw_y = std::min(y, (uint16_t)HEIGHT);
+    _pw_w = std::min(w, (uint16_t)(WIDTH - _pw_x));
+    _pw_h = std::min(h, (uint16_t)(HEIGHT - _pw_y));
+    // Make _pw_x, _pw_w multiple of 8
+    _pw_w += _pw_x % 8;
+    if (_pw_w % 8 > 0) _pw_w += 8 - _pw_w % 8;
+    _pw_x -= _pw_x % 8;
+  }
+
+  void firstPage() {
+    fillScreen(GxEPD_WHITE);
+    _current_page = 0;
+  }
+
+  // Full height page: the whole window goes to the panel on the first call
+  bool nextPage() {
+    uint16_t page_ys = _current_page * _page_height;
+    uint16_t dest_ys = _pw_y + page_ys;
+    uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+    uint16_t dest_ye = std::min(uint16_t(_pw_y + _pw_h), uint16_t(page_ye));
+    if (dest_ye > dest_ys) {
+      epd2.writeImage(_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+    }
+    epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+    return false;
+  }
+
+  // Push a window of the (full screen) buffer, logical coordinates
+  void displayWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    uint16_t ux = x, uy = y, uw = w, uh = h;
+    _rotate(ux, uy, uw, uh);
+    uw += ux % 8;
+    if (uw % 8 > 0) uw += 8 - uw % 8;
+    ux -= ux % 8;
+    uw = std::min(uw, uint16_t(WIDTH - ux));
+    uh = std::min(uh, uint16_t(HEIGHT - uy));
+    for (uint16_t row = uy; row < uy + uh; row++) {
+      epd2.writeImage(_buffer + row * (WIDTH / 8) + ux / 8, ux, row, uw, 1);
+    }
+    epd2.refresh(ux, uy, uw, uh);
+  }
+
+  void display(bool partial_update_mode = false) {
+    epd2.writeImage(_buffer, 0, 0, WIDTH, HEIGHT);
+    epd2.refresh(partial_update_mode);
+  }
+
+  void powerOff() { epd2.powerOff(); }
+  void hibernate() { epd2.hibernate(); }
+
+ private:
+  void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h) {
+    switch (getRotation()) {
+      case 1:
+        std::swap(x, y);
+        std::swap(w, h);
+        x = WIDTH - x - w;
+        break;
+      case 2:
+        x = WIDTH - x - w;
+        y = HEIGHT - y - h;
+        break;
+      case 3:
+        std::swap(x, y);
+        std::swap(w, h);
+        y = HEIGHT - y - h;
+        break;
+    }
+  }
+
+  static const uint16_t WIDTH = GxEPD_Type::WIDTH;
+  static const uint16_t HEIGHT = GxEPD_Type::HEIGHT;
+  uint8_t _buffer[(GxEPD_Type::WIDTH / 8) * page_height];
+  bool _using_partial_mode;
+  uint16_t _pw_x, _pw_y, _pw_w, _pw_h;
+  uint16_t _pages, _page_height, _current_page;
+};
+
+#endif // HOST_GXEPD2_BW_H
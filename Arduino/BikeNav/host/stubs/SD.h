@@ -0,0 +1,221 @@
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+// --- HOST STAND-IN: SD CARD ---
+// The ESP32 SD library on a host directory: SD.open("/Map/...") opens
+// <root>/Map/... . The root is set with SD.setRoot() before SD.begin().
+// File follows the ESP32 semantics the sketch relies on: falsy when the
+// open failed, name() is the last path component, openNextFile() walks a
+// directory. Opens and bytes read are counted for the benchmarks.
+
+#include <Arduino.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <memory>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+#define CARD_NONE 0
+#define CARD_MMC 1
+#define CARD_SD 2
+#define CARD_SDHC 3
+
+class File {
+ public:
+  File() {}
+
+  explicit operator bool() const { return impl != nullptr; }
+
+  const char* name() const {
+    if (!impl) return "";
+    size_t slash = impl->path.find_last_of('/');
+    return impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+  }
+  const char* path() const { return impl ? impl->path.c_str() : ""; }
+  bool isDirectory() const { return impl && impl->isDir; }
+
+  size_t size() const {
+    if (!impl || !impl->fp) return 0;
+    struct stat st;
+    return fstat(fileno(impl->fp), &st) == 0 ? (size_t)st.st_size : 0;
+  }
+  size_t position() const { return impl && impl->fp ? (size_t)ftell(impl->fp) : 0; }
+  int available() const { return impl && impl->fp ? (int)(size() - position()) : 0; }
+  bool seek(uint32_t pos) { return impl && impl->fp && fseek(impl->fp, pos, SEEK_SET) == 0; }
+
+  int read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  size_t read(uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) return 0;
+    size_t n = fread(buf, 1, size, impl->fp);
+    stats().bytesRead += n;
+    return n;
+  }
+  size_t readBytes(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+  int peek() {
+    if (!impl || !impl->fp) return -1;
+    int c = fgetc(impl->fp);
+    if (c != EOF) ungetc(c, impl->fp);
+    return c;
+  }
+
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) return 0;
+    size_t n = fwrite(buf, 1, size, impl->fp);
+    stats().bytesWritten += n;
+    return n;
+  }
+  size_t print(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+  size_t print(const String& str) { return write((const uint8_t*)str.c_str(), str.length()); }
+  size_t println(const char* str = "") { return print(str) + write('\n'); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    if (!impl || !impl->fp) return 0;
+    va_list args;
+    va_start(args, format);
+    int n = vfprintf(impl->fp, format, args);
+    va_end(args);
+    return n > 0 ? n : 0;
+  }
+  void flush() {
+    if (impl && impl->fp) fflush(impl->fp);
+  }
+
+  time_t getLastWrite() const {
+    struct stat st;
+    return impl && stat(impl->hostPath.c_str(), &st) == 0 ? st.st_mtime : 0;
+  }
+
+  File openNextFile() {
+    File entry;
+    if (!impl || !impl->isDir) return entry;
+    while (impl->nextEntry < impl->entries.size()) {
+      std::string child = impl->entries[impl->nextEntry++];
+      std::string sdPath = impl->path == "/" ? "/" + child : impl->path + "/" + child;
+      entry = File::openPath(sdPath, impl->hostPath + "/" + child, "r");
+      if (entry) break;
+    }
+    return entry;
+  }
+  void rewindDirectory() {
+    if (impl) impl->nextEntry = 0;
+  }
+
+  void close() { impl.reset(); }
+
+  struct Stats {
+    unsigned long opens = 0;
+    unsigned long failedOpens = 0;
+    unsigned long bytesRead = 0;
+    unsigned long bytesWritten = 0;
+  };
+  static Stats& stats() {
+    static Stats s;
+    return s;
+  }
+
+  static File openPath(const std::string& sdPath, const std::string& hostPath, const char* mode) {
+    File file;
+    struct stat st;
+    bool exists = stat(hostPath.c_str(), &st) == 0;
+    if (exists && S_ISDIR(st.st_mode)) {
+      DIR* dir = opendir(hostPath.c_str());
+      if (!dir) return file;
+      auto impl = std::make_shared<Impl>();
+      impl->isDir = true;
+      while (struct dirent* d = readdir(dir)) {
+        if (strcmp(d->d_name, ".") && strcmp(d->d_name, "..")) impl->entries.push_back(d->d_name);
+      }
+      closedir(dir);
+      std::sort(impl->entries.begin(), impl->entries.end());
+      impl->path = sdPath;
+      impl->hostPath = hostPath;
+      file.impl = impl;
+      stats().opens++;
+      return file;
+    }
+    if (!exists && mode[0] == 'r') {
+      stats().failedOpens++;
+      return file;
+    }
+    // Same modes as the ESP32 VFS: "w" truncates, "a" appends, "r+" patches in place
+    const char* hostMode = !strcmp(mode, "r") ? "rb" : !strcmp(mode, "r+") ? "rb+" : !strcmp(mode, "a") ? "ab" : "wb";
+    FILE* fp = fopen(hostPath.c_str(), hostMode);
+    if (!fp) {
+      stats().failedOpens++;
+      return file;
+    }
+    auto impl = std::make_shared<Impl>();
+    impl->fp = fp;
+    impl->path = sdPath;
+    impl->hostPath = hostPath;
+    file.impl = impl;
+    stats().opens++;
+    return file;
+  }
+
+ private:
+  struct Impl {
+    FILE* fp = nullptr;
+    bool isDir = false;
+    std::string path;
+    std::string hostPath;
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+    ~Impl() {
+      if (fp) fclose(fp);
+    }
+  };
+  std::shared_ptr<Impl> impl;
+};
+
+class HostSD {
+ public:
+  void setRoot(const std::string& dir) { root = dir; }
+  const std::string& getRoot() const { return root; }
+
+  bool begin(uint8_t ssPin = 0, ...) {
+    (void)ssPin;
+    struct stat st;
+    mounted = !root.empty() && stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    return mounted;
+  }
+  void end() { mounted = false; }
+
+  File open(const char* path, const char* mode = FILE_READ) {
+    if (!mounted || !path) return File();
+    return File::openPath(path, hostPath(path), mode);
+  }
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+
+  bool exists(const char* path) {
+    struct stat st;
+    return mounted && stat(hostPath(path).c_str(), &st) == 0;
+  }
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool mkdir(const char* path) { return mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+  bool mkdir(const String& path) { return mkdir(path.c_str()); }
+  bool remove(const char* path) { return mounted && unlink(hostPath(path).c_str()) == 0; }
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rmdir(const char* path) { return mounted && ::rmdir(hostPath(path).c_str()) == 0; }
+  bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+  uint8_t cardType() { return mounted ? CARD_SDHC : CARD_NONE; }
+  uint64_t cardSize() { return 32ull << 30; }
+  uint64_t totalBytes() { return 32ull << 30; }
+  uint64_t usedBytes() { return 0; }
+
+ private:
+  std::string hostPath(const char* path) const { return root + (path[0] == '/' ? "" : "/") + path; }
+  std::string root;
+  bool mounted = false;
+};
+inline HostSD SD;
+
+#endif // HOST_SD_H
@@ -0,0 +1,61 @@
+#ifndef HOST_TINYGPSPLUS_H
+#define HOST_TINYGPSPLUS_H
+
+// --- HOST STAND-IN: TINYGPS++ ---
+// Plain fields instead of NMEA parsing; tests set them directly.
+
+#include <Arduino.h>
+
+struct TinyGPSLocation {
+  bool valid = false;
+  double latitude = 0;
+  double longitude = 0;
+  bool isValid() const { return valid; }
+  double lat() const { return latitude; }
+  double lng() const { return longitude; }
+};
+
+struct TinyGPSDate {
+  bool valid = false;
+  uint16_t y = 2026;
+  uint8_t m = 1, d = 1;
+  bool isValid() const { return valid; }
+  uint16_t year() const { return y; }
+  uint8_t month() const { return m; }
+  uint8_t day() const { return d; }
+};
+
+struct TinyGPSTime {
+  bool valid = false;
+  uint8_t h = 0, m = 0, s = 0;
+  bool isValid() const { return valid; }
+  uint8_t hour() const { return h; }
+  uint8_t minute() const { return m; }
+  uint8_t second() const { return s; }
+};
+
+struct TinyGPSSpeed {
+  bool valid = false;
+  double speedKmph = 0;
+  bool isValid() const { return valid; }
+  double kmph() const { return speedKmph; }
+};
+
+struct TinyGPSInteger {
+  bool valid = false;
+  uint32_t count = 0;
+  bool isValid() const { return valid; }
+  uint32_t value() const { return count; }
+};
+
+class TinyGPSPlus {
+ public:
+  bool encode(char) { return false; }
+  TinyGPSLocation location;
+  TinyGPSDate date;
+  TinyGPSTime time;
+  TinyGPSSpeed speed;
+  TinyGPSInteger satellites;
+};
+
+#endif // HOST_TINYGPSPLUS_H
@@ -0,0 +1,93 @@
+#ifndef HOST_U8G2_FOR_ADAFRUIT_GFX_H
+#define HOST_U8G2_FOR_ADAFRUIT_GFX_H
+
+// --- HOST STAND-IN: U8G2 FONTS ---
+// No real font data: each font is {glyph width, ascent, advance} and every
+// printable character is a deterministic block pattern of that size sitting
+// on the baseline (space has no ink). Enough for layout, widths, the glyph
+// sprite cache and pixel comparisons between two renderers of the same text.
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#define U8G2_FONT(name, w, h, advance) inline const uint8_t name[] = {w, h, advance};
+
+U8G2_FONT(u8g2_font_helvR08_tf, 4, 8, 5)
+U8G2_FONT(u8g2_font_helvR08_tr, 4, 8, 5)
+U8G2_FONT(u8g2_font_helvR10_tf, 5, 10, 6)
+U8G2_FONT(u8g2_font_helvB08_tf, 5, 8, 6)
+U8G2_FONT(u8g2_font_helvB10_tf, 6, 10, 7)
+U8G2_FONT(u8g2_font_helvB10_tr, 6, 10, 7)
+U8G2_FONT(u8g2_font_helvB12_tf, 7, 12, 8)
+U8G2_FONT(u8g2_font_helvB12_tr, 7, 12, 8)
+U8G2_FONT(u8g2_font_helvB14_tf, 8, 14, 9)
+U8G2_FONT(u8g2_font_helvB14_te, 8, 14, 9)
+U8G2_FONT(u8g2_font_helvB24_tf, 14, 24, 16)
+U8G2_FONT(u8g2_font_helvB24_tn, 14, 24, 16)
+U8G2_FONT(u8g2_font_fub30_tn, 18, 30, 20)
+U8G2_FONT(u8g2_font_fub42_tn, 24, 42, 27)
+U8G2_FONT(u8g2_font_profont10_tf, 4, 8, 5)
+
+class U8G2_FOR_ADAFRUIT_GFX : public Print {
+ public:
+  void begin(Adafruit_GFX& gfx) { target = &gfx; }
+  void setFont(const uint8_t* f) { font = f; }
+  void setFontMode(uint8_t mode) { fontMode = mode; }
+  void setFontDirection(uint8_t) {}
+  void setForegroundColor(uint16_t color) { foreground = color; }
+  void setBackgroundColor(uint16_t color) { background = color; }
+  void setCursor(int16_t x, int16_t y) {
+    cursorX = x;
+    cursorY = y;
+  }
+  int16_t getCursorX() const { return cursorX; }
+  int16_t getCursorY() const { return cursorY; }
+  int8_t getFontAscent() const { return font ? font[1] : 0; }
+  int8_t getFontDescent() const { return 0; }
+
+  int16_t getUTF8Width(const char* text) const {
+    if (!font || !text) return 0;
+    int16_t width = 0;
+    for (const uint8_t* s = (const uint8_t*)text; *s; s++) {
+      if ((*s & 0xC0) != 0x80) width += font[2];  // Continuation bytes belong to the previous glyph
+    }
+    return width;
+  }
+
+  size_t write(uint8_t c) override {
+    if (!font) return 1;
+    if ((c & 0xC0) == 0x80) return 1;
+    drawGlyph(c);
+    cursorX += font[2];
+    return 1;
+  }
+  using Print::write;
+
+ private:
+  void drawGlyph(uint8_t c) {
+    if (!target) return;
+    int w = font[0];
+    int h = font[1];
+    int top = cursorY - h;
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        bool ink = c != ' ' && (x == 0 || y == 0 || y == h - 1 || ((c >> ((x + y) % 7)) & 1));
+        if (ink) {
+          target->drawPixel(cursorX + x, top + y, foreground);
+        } else if (fontMode == 0) {
+          target->drawPixel(cursorX + x, top + y, background);
+        }
+      }
+    }
+  }
+
+  Adafruit_GFX* target = nullptr;
+  const uint8_t* font = nullptr;
+  uint8_t fontMode = 0;
+  uint16_t foreground = 1;
+  uint16_t background = 0;
+  int16_t cursorX = 0;
+  int16_t cursorY = 0;
+};
+
+#endif // HOST_U8G2_FOR_ADAFRUIT_GFX_H
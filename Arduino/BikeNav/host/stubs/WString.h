@@ -0,0 +1,80 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// --- HOST STAND-IN: ARDUINO STRING ---
+// The subset of Arduino's String the sketch headers use, on std::string.
+
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+
+class String {
+ public:
+  String() {}
+  String(const char* str) : s(str ? str : "") {}
+  String(const std::string& str) : s(str) {}
+  String(char c) : s(1, c) {}
+  String(int value) : s(std::to_string(value)) {}
+  String(unsigned int value) : s(std::to_string(value)) {}
+  String(long value) : s(std::to_string(value)) {}
+  String(unsigned long value) : s(std::to_string(value)) {}
+  String(double value, unsigned int digits = 2) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)digits, value);
+    s = buf;
+  }
+
+  const char* c_str() const { return s.c_str(); }
+  unsigned int length() const { return (unsigned int)s.size(); }
+  bool reserve(unsigned int size) {
+    s.reserve(size);
+    return true;
+  }
+  char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  int indexOf(char c, unsigned int from = 0) const { return find(s.find(c, from)); }
+  int indexOf(const String& str, unsigned int from = 0) const { return find(s.find(str.s, from)); }
+  int lastIndexOf(char c) const { return find(s.rfind(c)); }
+  String substring(unsigned int begin) const { return begin < s.size() ? String(s.substr(begin)) : String(); }
+  String substring(unsigned int begin, unsigned int end) const {
+    if (begin > end) std::swap(begin, end);
+    if (begin >= s.size()) return String();
+    return String(s.substr(begin, end - begin));
+  }
+  bool startsWith(const String& prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+  bool endsWith(const String& suffix) const {
+    return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+  }
+  void trim() {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    size_t last = s.find_last_not_of(" \t\r\n");
+    s = first == std::string::npos ? std::string() : s.substr(first, last - first + 1);
+  }
+  long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s.c_str(), nullptr); }
+  double toDouble() const { return strtod(s.c_str(), nullptr); }
+
+  String& operator+=(const String& other) {
+    s += other.s;
+    return *this;
+  }
+  String& operator+=(const char* other) {
+    s += other ? other : "";
+    return *this;
+  }
+  String& operator+=(char c) {
+    s += c;
+    return *this;
+  }
+  friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+  bool operator==(const String& other) const { return s == other.s; }
+  bool operator!=(const String& other) const { return s != other.s; }
+  bool operator==(const char* other) const { return s == (other ? other : ""); }
+
+ private:
+  std::string s;
+  static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+#endif // HOST_WSTRING_H
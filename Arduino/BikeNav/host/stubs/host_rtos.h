@@ -0,0 +1,165 @@
+#ifndef HOST_RTOS_H
+#define HOST_RTOS_H
+
+// --- HOST STAND-IN: FREERTOS ---
+// Tasks are std::threads, one tick is one millisecond. Covers the calls the
+// sketch headers make: pinned task creation, task notifications, mutexes,
+// recursive mutexes and critical sections.
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portYIELD_FROM_ISR() ((void)0)
+#define taskYIELD() std::this_thread::yield()
+
+struct HostTask {
+  std::mutex lock;
+  std::condition_variable wake;
+  uint32_t notifications = 0;
+};
+typedef HostTask* TaskHandle_t;
+
+inline HostTask*& hostCurrentTask() {
+  thread_local HostTask* task = nullptr;
+  return task;
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+  HostTask*& task = hostCurrentTask();
+  if (!task) task = new HostTask();  // Threads not made by xTaskCreate (main)
+  return task;
+}
+
+// Wait up to ticks for pred(), with lock held; portMAX_DELAY waits forever
+template <typename Pred>
+inline bool hostWaitTicks(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                          TickType_t ticks, Pred pred) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, pred);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), pred);
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*code)(void*), const char*, uint32_t, void* parameter,
+                                          UBaseType_t, TaskHandle_t* created, BaseType_t) {
+  HostTask* task = new HostTask();
+  std::thread([task, code, parameter]() {
+    hostCurrentTask() = task;
+    code(parameter);
+  }).detach();
+  if (created) *created = task;
+  return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(void (*code)(void*), const char* name, uint32_t stack, void* parameter,
+                              UBaseType_t priority, TaskHandle_t* created) {
+  return xTaskCreatePinnedToCore(code, name, stack, parameter, priority, created, 0);
+}
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(task->lock);
+  hostWaitTicks(task->wake, lock, ticks, [task]() { return task->notifications > 0; });
+  uint32_t value = task->notifications;
+  if (value) task->notifications = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  std::lock_guard<std::mutex> lock(task->lock);
+  task->notifications++;
+  task->wake.notify_all();
+  return pdPASS;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  xTaskNotifyGive(task);
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+}
+
+// --- SEMAPHORES ---
+struct HostSemaphore {
+  std::mutex lock;
+  std::condition_variable wake;
+  int count;
+  int maxCount;
+  TaskHandle_t owner = nullptr;  // Recursive mutexes only
+  int depth = 0;
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostSemaphore{{}, {}, 1, 1}; }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new HostSemaphore{{}, {}, 1, 1}; }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore{{}, {}, 0, 1}; }
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(semaphore->lock);
+  if (!hostWaitTicks(semaphore->wake, lock, ticks, [semaphore]() { return semaphore->count > 0; })) {
+    return pdFALSE;
+  }
+  semaphore->count--;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  std::lock_guard<std::mutex> lock(semaphore->lock);
+  if (semaphore->count >= semaphore->maxCount) return pdFALSE;
+  semaphore->count++;
+  semaphore->wake.notify_one();
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(semaphore->lock);
+  if (semaphore->owner == self) {
+    semaphore->depth++;
+    return pdTRUE;
+  }
+  if (!hostWaitTicks(semaphore->wake, lock, ticks, [semaphore]() { return semaphore->count > 0; })) {
+    return pdFALSE;
+  }
+  semaphore->count--;
+  semaphore->owner = self;
+  semaphore->depth = 1;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+  std::lock_guard<std::mutex> lock(semaphore->lock);
+  if (semaphore->owner != xTaskGetCurrentTaskHandle()) return pdFALSE;
+  if (--semaphore->depth > 0) return pdTRUE;
+  semaphore->owner = nullptr;
+  semaphore->count++;
+  semaphore->wake.notify_one();
+  return pdTRUE;
+}
+
+// --- CRITICAL SECTIONS ---
+struct HostCriticalMux {
+  std::recursive_mutex lock;
+};
+typedef HostCriticalMux portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->lock.lock()
+#define portEXIT_CRITICAL(mux) (mux)->lock.unlock()
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL(mux)
+
+#endif // HOST_RTOS_H
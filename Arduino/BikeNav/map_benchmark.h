@@ -0,0 +1,228 @@
+#ifndef MAP_BENCHMARK_H
+#define MAP_BENCHMARK_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include "display_buffer.h"
+#include "spi_bus.h"
+
+// External state from BikeNav.ino
+extern bool sdCardPresent;
+
+// External tile cache functions from tile_cache.h
+extern void tileCacheClear();
+extern void tileCacheLock();
+extern void tileCacheUnlock();
+
+// --- RENDER PIPELINE BENCHMARK ---
+// Renders scripted viewpoints from the tile set on the SD card and times
+// the stages of a map frame separately, so a change to one stage can be
+// measured on its own:
+//   select - visible tile selection for the rotated map area
+//   sd     - reading the selected tiles from SD into the (cleared) cache
+//   blit   - drawing the cached tiles into the framebuffer
+//   route  - drawing the navigation route on top
+// Each view is also written to SD as a PBM image for visual checks.
+// host/map_bench.cpp runs the same views on a PC against a synthetic tile set.
+#define MAP_BENCH_DIR "/Bench"
+#define MAP_BENCH_ROUTE_POINTS 600     // Synthetic route when no track is loaded
+#define MAP_BENCH_ROUTE_STEP_M 10.0
+
+struct MapBenchView {
+  const char* name;
+  int zoomIndex;      // Into ZOOM_LEVELS
+  int rotation;
+  bool navLayout;     // Navigation info bar and center row
+  bool route;
+};
+
+const MapBenchView MAP_BENCH_VIEWS[] = {
+  {"browse-z16",     2,   0, false, false},
+  {"browse-z16-r37", 2,  37, false, false},
+  {"nav-z17",        1,   0, true,  true},
+  {"nav-z17-r90",    1,  90, true,  true},
+  {"nav-z16-r215",   2, 215, true,  true},
+  {"nav-z18-r320",   0, 320, true,  true},
+  {"overview-z13",   5,  15, true,  true},
+};
+const int MAP_BENCH_VIEW_COUNT = sizeof(MAP_BENCH_VIEWS) / sizeof(MAP_BENCH_VIEWS[0]);
+
+struct MapBenchStages {
+  unsigned long selectUs;
+  unsigned long sdReadUs;
+  unsigned long blitUs;
+  unsigned long routeUs;
+  int tiles;
+  int tilesRead;
+};
+
+/**
+ * Write the framebuffer as a binary PBM (P4, 1 = black) of the logical
+ * 128x296 screen. Requires isDisplayBufferDirect().
+ */
+static bool writeDisplayPbm(const char* path) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+  File file = SD.open(path, FILE_WRITE);
+  if (!file) return false;
+
+  char header[24];
+  int headerLen = snprintf(header, sizeof(header), "P4\n%d %d\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  bool ok = file.write((const uint8_t*)header, headerLen) == (size_t)headerLen;
+
+  uint8_t row[DISPLAY_BUFFER_ROW_BYTES];
+  for (int y = 0; y < DISPLAY_HEIGHT && ok; y++) {
+    displayReadRow(y, 0, DISPLAY_WIDTH, row);
+    for (int i = 0; i < DISPLAY_BUFFER_ROW_BYTES; i++) row[i] = ~row[i];
+    ok = file.write(row, sizeof(row)) == sizeof(row);
+  }
+  file.close();
+  return ok;
+}
+
+// North-going route with a slow wiggle, centered on lat/lon
+static TrackPoint* buildBenchRoute(double lat, double lon) {
+  TrackPoint* track = (TrackPoint*)ps_malloc(MAP_BENCH_ROUTE_POINTS * sizeof(TrackPoint));
+  if (!track) return nullptr;
+
+  double stepLat = MAP_BENCH_ROUTE_STEP_M / 111320.0;
+  double metersPerLon = 111320.0 * cos(lat * M_PI / 180.0);
+  for (int i = 0; i < MAP_BENCH_ROUTE_POINTS; i++) {
+    int offset = i - MAP_BENCH_ROUTE_POINTS / 2;
+    track[i].lat = lat + offset * stepLat;
+    track[i].lon = lon + 150.0 * sin(offset / 40.0) / metersPerLon;
+    track[i].elev = 0;
+  }
+  return track;
+}
+
+/**
+ * Render one view into the framebuffer, timing each stage. The tile cache
+ * is cleared first so the SD stage reads every tile of the view.
+ * Caller holds the tile cache lock.
+ */
+static void renderBenchView(double lat, double lon, bool route, MapBenchStages* stages) {
+  tileCacheClear();
+
+  unsigned long start = micros();
+  calculateVisibleTiles(lat, lon, zoomLevel);
+  stages->selectUs = micros() - start;
+  stages->tiles = tileCount;
+
+  stages->tilesRead = 0;
+  start = micros();
+  for (int i = 0; i < tileCount; i++) {
+    if (loadTileIntoCache(zoomLevel, tilesToRender[i].tileX, tilesToRender[i].tileY)) stages->tilesRead++;
+  }
+  stages->sdReadUs = micros() - start;
+
+  display.fillScreen(GxEPD_WHITE);
+  radarMapLightenEnabled = false;
+  start = micros();
+  for (int i = 0; i < tileCount; i++) {
+    loadAndRenderTile(tilesToRender[i].tileX, tilesToRender[i].tileY, zoomLevel,
+                      tilesToRender[i].screenX, tilesToRender[i].screenY);
+  }
+  stages->blitUs = micros() - start;
+
+  stages->routeUs = 0;
+  if (route) {
+    start = micros();
+    drawNavigationRoute(lat, lon);
+    stages->routeUs = micros() - start;
+  }
+}
+
+/**
+ * Debug: run MAP_BENCH_VIEWS around the current position and print the
+ * per-stage timings; each view is saved as MAP_BENCH_DIR/<name>.pbm. Uses
+ * the loaded navigation track for route views, or a synthetic route when
+ * none is loaded. Leaves the tile cache empty and the framebuffer holding
+ * the last view (never refreshed to the panel) - redraw the page afterwards.
+ */
+void benchmarkRenderPipeline() {
+  if (!isTileCacheReady()) {
+    Serial.println("[BENCH] Tile cache unavailable");
+    return;
+  }
+
+  double lat = currentLat;
+  double lon = currentLon;
+  TrackPoint* savedTrack = navigationTrack;
+  int savedTrackCount = navigationTrackPointCount;
+  TrackPoint* benchTrack = nullptr;
+  if (savedTrack == nullptr || savedTrackCount < 2) {
+    benchTrack = buildBenchRoute(lat, lon);
+    if (benchTrack) {
+      navigationTrack = benchTrack;
+      navigationTrackPointCount = MAP_BENCH_ROUTE_POINTS;
+    }
+  }
+
+  int savedZoomIndex = currentZoomIndex;
+  int savedRotation = mapRotation;
+  int savedCenterY = currentCenterY;
+  int savedMapHeight = MAP_DISPLAY_HEIGHT;
+  int savedInfoBarHeight = currentInfoBarHeight;
+
+  bool writeImages = false;
+  if (sdCardPresent) {
+    SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+    writeImages = SD.exists(MAP_BENCH_DIR) || SD.mkdir(MAP_BENCH_DIR);
+  }
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);  // Framebuffer state only, no refresh
+
+  // Keep the render task off the cache for the whole run
+  tileCacheLock();
+
+  // Project the route once, so the route stage measures drawing only
+  if (navigationTrack) getRouteGeometry(navigationTrack, navigationTrackPointCount);
+
+  MapBenchStages stages[MAP_BENCH_VIEW_COUNT];
+  for (int v = 0; v < MAP_BENCH_VIEW_COUNT; v++) {
+    const MapBenchView& view = MAP_BENCH_VIEWS[v];
+    currentZoomIndex = view.zoomIndex;
+    zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+    mapRotation = view.rotation;
+    currentInfoBarHeight = view.navLayout ? MAP_INFO_BAR_HEIGHT_NAV : MAP_INFO_BAR_HEIGHT_NORMAL;
+    MAP_DISPLAY_HEIGHT = DISPLAY_HEIGHT - currentInfoBarHeight;
+    currentCenterY = view.navLayout ? CENTER_Y_NAV : CENTER_Y_NORMAL;
+
+    renderBenchView(lat, lon, view.route && navigationTrack != nullptr, &stages[v]);
+
+    if (writeImages) {
+      char path[48];
+      snprintf(path, sizeof(path), "%s/%s.pbm", MAP_BENCH_DIR, view.name);
+      if (!writeDisplayPbm(path)) Serial.printf("[BENCH] Failed to write %s\n", path);
+    }
+  }
+
+  tileCacheUnlock();
+
+  Serial.println("=== RENDER PIPELINE BENCHMARK ===");
+  Serial.printf("Center %.5f, %.5f, route: %s\n", lat, lon,
+                benchTrack ? "synthetic" : (navigationTrack ? "navigation track" : "none"));
+  Serial.println("view              tiles  read  select us  sd us     blit us   route us");
+  for (int v = 0; v < MAP_BENCH_VIEW_COUNT; v++) {
+    Serial.printf("%-16s  %5d  %4d  %9lu  %8lu  %8lu  %8lu\n",
+                  MAP_BENCH_VIEWS[v].name, stages[v].tiles, stages[v].tilesRead,
+                  stages[v].selectUs, stages[v].sdReadUs, stages[v].blitUs, stages[v].routeUs);
+  }
+  if (writeImages) Serial.printf("Images written to %s/\n", MAP_BENCH_DIR);
+  Serial.println("=================================");
+
+  currentZoomIndex = savedZoomIndex;
+  zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+  mapRotation = savedRotation;
+  currentCenterY = savedCenterY;
+  MAP_DISPLAY_HEIGHT = savedMapHeight;
+  currentInfoBarHeight = savedInfoBarHeight;
+  if (benchTrack) {
+    navigationTrack = savedTrack;
+    navigationTrackPointCount = savedTrackCount;
+    releaseRouteGeometry(benchTrack);
+    free(benchTrack);
+  }
+  invalidateMapCanvas();
+}
+
+#endif // MAP_BENCHMARK_H
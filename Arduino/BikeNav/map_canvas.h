@@ -0,0 +1,246 @@
+#ifndef MAP_CANVAS_H
+#define MAP_CANVAS_H
+
+#include <Arduino.h>
+
+// External tile access from tile_cache.h / map_rendering.h
+extern uint8_t* tileCacheLookup(int zoom, int tileX, int tileY);
+extern uint8_t* loadTileIntoCache(int zoom, int tileX, int tileY);
+extern bool isTileCacheReady();
+extern void tileCacheLock();
+extern void tileCacheUnlock();
+
+// --- MAP CANVAS ---
+// Unrotated world-space copy of the map around the view center, kept in
+// PSRAM between frames. Storage is toroidal: world pixel (x, y) lives at
+// (x & MASK, y & MASK), so scrolling never moves data - it only refills
+// the strips of the new square that were outside the old one. The rotated
+// screen is resampled from the canvas instead of from individual tiles.
+#define MAP_CANVAS_SIZE 512                        // World pixels per side, power of two (> rotated viewport extent 322)
+#define MAP_CANVAS_ROW_BYTES (MAP_CANVAS_SIZE / 8)
+#define MAP_CANVAS_MASK (MAP_CANVAS_SIZE - 1)
+
+struct MapCanvas {
+  uint8_t* bits;            // 1bpp, 1 = white, MSB first, 32KB PSRAM
+  bool valid;
+  int zoom;
+  int32_t validX, validY;   // World pixel top-left of the valid square (validX multiple of 8)
+  unsigned long framesReused;     // Resample only
+  unsigned long framesScrolled;   // Strip refill + resample
+  unsigned long framesFull;       // Whole canvas refilled
+  unsigned long tilesRead;        // Tile fetches for canvas fills
+  volatile uint32_t invalidations;  // Bumped on every drop, a fill racing one must not mark the canvas valid
+  bool logFrames;                 // Per-frame Serial line (off for the host equivalence test)
+};
+
+MapCanvas mapCanvas = {nullptr, false, -1, 0, 0, 0, 0, 0, 0, 0, true};
+
+// Drop the canvas contents, next frame refills it from tiles
+void invalidateMapCanvas() {
+  mapCanvas.invalidations++;
+  mapCanvas.valid = false;
+}
+
+// A tile was (re)written on SD card - drop the canvas if it shows that tile.
+// Called from saveTileToSD() on the BLE task. Canvas fills (loop() or the
+// render task) move zoom/validX/validY under the tile cache lock, so the
+// check takes it too: a fill is either done and seen here, or starts after
+// the invalidation.
+void mapCanvasNoteTileSaved(int zoom, int tileX, int tileY) {
+  int32_t x0 = (int32_t)tileX * 256;
+  int32_t y0 = (int32_t)tileY * 256;
+  tileCacheLock();
+  if (zoom == mapCanvas.zoom &&
+      x0 < mapCanvas.validX + MAP_CANVAS_SIZE && x0 + 256 > mapCanvas.validX &&
+      y0 < mapCanvas.validY + MAP_CANVAS_SIZE && y0 + 256 > mapCanvas.validY) {
+    invalidateMapCanvas();
+  }
+  tileCacheUnlock();
+}
+
+/**
+ * Copy world rect [x0, x1) x [y0, y1) from tiles into the canvas.
+ * x0/x1 must be multiples of 8; missing tiles fill white.
+ */
+static void fillMapCanvasRect(int zoom, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+  if (x0 >= x1 || y0 >= y1) return;
+
+  for (int32_t tileY = y0 >> 8; tileY <= (y1 - 1) >> 8; tileY++) {
+    for (int32_t tileX = x0 >> 8; tileX <= (x1 - 1) >> 8; tileX++) {
+      uint8_t* tileData = tileCacheLookup(zoom, tileX, tileY);
+      if (!tileData) tileData = loadTileIntoCache(zoom, tileX, tileY);
+      mapCanvas.tilesRead++;
+
+      int32_t tileLeft = tileX * 256;
+      int32_t tileTop = tileY * 256;
+      int32_t left = x0 > tileLeft ? x0 : tileLeft;
+      int32_t right = x1 < tileLeft + 256 ? x1 : tileLeft + 256;
+      int32_t top = y0 > tileTop ? y0 : tileTop;
+      int32_t bottom = y1 < tileTop + 256 ? y1 : tileTop + 256;
+      int srcByte = (left - tileLeft) >> 3;
+      int byteCount = (right - left) >> 3;
+      // A tile never wraps inside a canvas row: it starts at a multiple of 256
+      int dstByte = (left & MAP_CANVAS_MASK) >> 3;
+
+      for (int32_t y = top; y < bottom; y++) {
+        uint8_t* dst = mapCanvas.bits + (y & MAP_CANVAS_MASK) * MAP_CANVAS_ROW_BYTES + dstByte;
+        if (tileData) {
+          memcpy(dst, tileData + (y - tileTop) * 32 + srcByte, byteCount);
+        } else {
+          memset(dst, 0xFF, byteCount);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Resample the rotated map area of view r from the canvas. originX/Y is the
+ * world pixel at unrotated screen (0, 0). Writes into frame (framebuffer
+ * layout, see display_buffer.h) or, when frame is nullptr, into the display.
+ */
+static void resampleMapCanvas(int32_t originX, int32_t originY, const MapRotationSetup& r,
+                              int mapHeight, uint8_t* frame) {
+  bool direct = frame || isDisplayBufferDirect();
+  uint8_t rowMask[DISPLAY_BUFFER_ROW_BYTES];
+
+  for (int y = 0; y < mapHeight; y++) {
+    int32_t u = r.originU + y * r.rowDU;
+    int32_t v = r.originV + y * r.rowDV;
+    bool anyBlack = false;
+    if (direct) memset(rowMask, 0, sizeof(rowMask));
+
+    for (int x = 0; x < DISPLAY_WIDTH; x++, u += r.colDU, v += r.colDV) {
+      int32_t wx = (u >> 16) + originX;  // Arithmetic shift floors negative offsets
+      int32_t wy = (v >> 16) + originY;
+      uint8_t byteVal = mapCanvas.bits[(wy & MAP_CANVAS_MASK) * MAP_CANVAS_ROW_BYTES + ((wx & MAP_CANVAS_MASK) >> 3)];
+      if ((byteVal >> (7 - (wx & 7))) & 1) continue;  // White
+
+      if (direct) {
+        rowMask[x >> 3] |= 0x80 >> (x & 7);
+        anyBlack = true;
+      } else {
+        display.drawPixel(x, y, GxEPD_BLACK);
+      }
+    }
+
+    if (!anyBlack) continue;
+    if (frame) {
+      displayApplyRowMaskTo(frame, y, rowMask);
+    } else {
+      displayApplyRowMask(y, rowMask);
+    }
+  }
+}
+
+/**
+ * Draw the map area for a view centered on lat/lon through the canvas.
+ * Reuses the canvas as is when the rotated viewport still lies inside it,
+ * refills only the newly exposed strips after a small move, and refills
+ * everything after a jump or zoom change. The view (rotation, centerY,
+ * map height) is passed in, so the render task can compose a snapshot
+ * while the main loop changes the live one. frame as in resampleMapCanvas().
+ * Caller holds the tile cache lock. Returns false when the canvas is
+ * unavailable (no PSRAM/cache) - the caller renders tiles directly.
+ */
+bool composeMapCanvas(double lat, double lon, int zoom, const MapRotationSetup& r,
+                      int mapHeight, uint8_t* frame) {
+  if (!isTileCacheReady()) return false;
+  if (!mapCanvas.bits) {
+    mapCanvas.bits = (uint8_t*)ps_malloc(MAP_CANVAS_ROW_BYTES * MAP_CANVAS_SIZE);
+    if (!mapCanvas.bits) {
+      Serial.println("[CANVAS] ERROR: Failed to allocate map canvas");
+      return false;
+    }
+    mapCanvas.valid = false;
+  }
+
+  unsigned long start = micros();
+  uint32_t invalidationsBefore = mapCanvas.invalidations;
+
+  // World pixel at unrotated screen (0, 0), same rounding as calculateVisibleTiles()
+  int centerTileX, centerTileY;
+  double centerPixelX, centerPixelY;
+  getTileCoordinates(lat, lon, zoom, &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
+  int32_t originX = (int32_t)centerTileX * 256 + (int)centerPixelX - CENTER_X;
+  int32_t originY = (int32_t)centerTileY * 256 + (int)centerPixelY - r.centerY;
+
+  // World extent the rotated map area needs (1px margin for Q16 rounding)
+  float px[4], py[4];
+  getUnrotatedViewportFor(r, mapHeight, px, py);
+  float minX = px[0], maxX = px[0], minY = py[0], maxY = py[0];
+  for (int i = 1; i < 4; i++) {
+    if (px[i] < minX) minX = px[i];
+    if (px[i] > maxX) maxX = px[i];
+    if (py[i] < minY) minY = py[i];
+    if (py[i] > maxY) maxY = py[i];
+  }
+  int32_t needX0 = originX + (int32_t)floorf(minX) - 1;
+  int32_t needY0 = originY + (int32_t)floorf(minY) - 1;
+  int32_t needX1 = originX + (int32_t)ceilf(maxX) + 1;
+  int32_t needY1 = originY + (int32_t)ceilf(maxY) + 1;
+
+  bool inside = mapCanvas.valid && mapCanvas.zoom == zoom &&
+                needX0 >= mapCanvas.validX && needX1 <= mapCanvas.validX + MAP_CANVAS_SIZE &&
+                needY0 >= mapCanvas.validY && needY1 <= mapCanvas.validY + MAP_CANVAS_SIZE;
+  unsigned long tilesBefore = mapCanvas.tilesRead;
+  const char* mode = "reuse";
+
+  if (inside) {
+    mapCanvas.framesReused++;
+  } else {
+    // Re-center the valid square on the needed extent
+    int32_t newX = ((needX0 + needX1) / 2 - MAP_CANVAS_SIZE / 2) & ~7;
+    int32_t newY = (needY0 + needY1) / 2 - MAP_CANVAS_SIZE / 2;
+    int32_t newX1 = newX + MAP_CANVAS_SIZE;
+    int32_t newY1 = newY + MAP_CANVAS_SIZE;
+    int32_t oldX = mapCanvas.validX;
+    int32_t oldY = mapCanvas.validY;
+    int32_t oldX1 = oldX + MAP_CANVAS_SIZE;
+    int32_t oldY1 = oldY + MAP_CANVAS_SIZE;
+
+    bool overlaps = mapCanvas.valid && mapCanvas.zoom == zoom &&
+                    newX < oldX1 && newX1 > oldX && newY < oldY1 && newY1 > oldY;
+    if (overlaps) {
+      // Columns the old square did not cover (full height), then rows it did not cover
+      if (newX < oldX) fillMapCanvasRect(zoom, newX, newY, oldX, newY1);
+      if (newX1 > oldX1) fillMapCanvasRect(zoom, oldX1, newY, newX1, newY1);
+      int32_t keptX0 = newX > oldX ? newX : oldX;
+      int32_t keptX1 = newX1 < oldX1 ? newX1 : oldX1;
+      if (newY < oldY) fillMapCanvasRect(zoom, keptX0, newY, keptX1, oldY);
+      if (newY1 > oldY1) fillMapCanvasRect(zoom, keptX0, oldY1, keptX1, newY1);
+      mapCanvas.framesScrolled++;
+      mode = "scroll";
+    } else {
+      fillMapCanvasRect(zoom, newX, newY, newX1, newY1);
+      mapCanvas.framesFull++;
+      mode = "full";
+    }
+
+    mapCanvas.zoom = zoom;
+    mapCanvas.validX = newX;
+    mapCanvas.validY = newY;
+    mapCanvas.valid = true;
+  }
+
+  resampleMapCanvas(originX, originY, r, mapHeight, frame);
+
+  // A tile saved during the fill may be stale in the canvas, refill next frame
+  if (mapCanvas.invalidations != invalidationsBefore) mapCanvas.valid = false;
+
+  if (!mapCanvas.logFrames) return true;
+  Serial.printf("[CANVAS] %s: %lu tiles read, %lu us (reused %lu, scrolled %lu, full %lu)\n",
+                mode, mapCanvas.tilesRead - tilesBefore, micros() - start,
+                mapCanvas.framesReused, mapCanvas.framesScrolled, mapCanvas.framesFull);
+  return true;
+}
+
+// Live view into the display framebuffer
+bool renderMapFromCanvas(double lat, double lon, int zoom) {
+  tileCacheLock();
+  bool rendered = composeMapCanvas(lat, lon, zoom, getMapRotationSetup(), MAP_DISPLAY_HEIGHT, nullptr);
+  tileCacheUnlock();
+  return rendered;
+}
+
+#endif // MAP_CANVAS_H
@@ -0,0 +1,290 @@
+#ifndef MAP_LAYERS_H
+#define MAP_LAYERS_H
+
+#include <Arduino.h>
+#include "display_buffer.h"
+#include "frame_scheduler.h"
+#include "panel_diff.h"
+
+// External map view state from page_map.h / map_navigation.h
+extern bool navigationActive;
+extern TrackPoint* navigationTrack;
+extern int navigationTrackPointCount;
+extern bool speedometerSplitEnabled;
+extern unsigned long lastSpeedometerOverlayUpdate;
+extern const int SPEEDOMETER_SPLIT_HEIGHT;
+
+// External layer painters from map_rendering.h / page_map.h / page_speedometer.h
+extern void updateMapInfoBar();
+extern void drawPageDots();
+extern void drawSpeedometerSplitOverlay();
+extern void drawNotificationOverlay();
+
+// --- MAP FRAME LAYERS ---
+// A map frame is a stack of layers, bottom to top:
+//   base   - map area: tiles, route, position marker
+//   info   - info bar and page dots (bottom rows)
+//   speed  - speedometer split overlay (top rows)
+//   notice - notification card (top rows)
+// Each layer keeps its last drawing in a 1bpp buffer in framebuffer layout
+// with a dirty flag and the state it was drawn from. The base is by far the
+// most expensive (tile compose / SD reads, route clipping) and is reused as
+// long as the view (center, zoom, rotation, layout, route, tile contents)
+// does not change. The upper layers are opaque full-width bands: their mask
+// is whole rows, so compositing is a copy of 32-bit row words. A frame whose
+// changes are all above the base - new notification, info bar tick, speed
+// overlay update - never touches tiles or the route; flushDisplayDiff()
+// then pushes only the rows that changed.
+enum MapLayerId {
+  MAP_LAYER_BASE,
+  MAP_LAYER_INFO,
+  MAP_LAYER_SPEED,
+  MAP_LAYER_NOTICE,
+  MAP_LAYER_COUNT
+};
+
+const char* const MAP_LAYER_NAMES[MAP_LAYER_COUNT] = {"base", "info", "speed", "notice"};
+
+// The view the base layer was drawn for
+struct MapBaseKey {
+  int32_t pixelX, pixelY;   // Drawn center, world pixel at zoom
+  int zoom;
+  int rotation;
+  int centerY;
+  int mapHeight;
+  bool navigation;
+  bool scrubbed;            // Crosshair instead of arrow
+  const TrackPoint* track;
+  int trackCount;
+  uint32_t canvasGeneration;  // Bumped when tiles on screen were rewritten
+};
+
+struct MapLayer {
+  uint8_t* bits;            // Framebuffer layout, only rows [top, bottom) are used
+  int top, bottom;          // Logical rows the layer covers
+  bool valid;
+  bool dirty;               // Redraw before the next composite
+  uint32_t signature;       // Content the band was drawn from (notice)
+  unsigned long redraws;
+  unsigned long reuses;
+};
+
+struct MapLayerState {
+  MapLayer layers[MAP_LAYER_COUNT];
+  MapBaseKey baseKey;
+  bool allocFailed;
+  unsigned long layerFrames;  // Frames composited without base work
+};
+
+MapLayerState mapLayers = {};
+
+static bool allocateMapLayers() {
+  if (mapLayers.layers[0].bits) return true;
+  if (mapLayers.allocFailed) return false;
+
+  const size_t frameBytes = DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS;
+  uint8_t* block = (uint8_t*)ps_malloc(MAP_LAYER_COUNT * frameBytes);
+  if (!block) {
+    Serial.println("[LAYERS] ERROR: Failed to allocate layer buffers, drawing every layer");
+    mapLayers.allocFailed = true;
+    return false;
+  }
+  for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+    mapLayers.layers[i].bits = block + i * frameBytes;
+    mapLayers.layers[i].valid = false;
+  }
+  return true;
+}
+
+// Copy logical rows [top, bottom) between framebuffer-layout buffers
+static void copyLayerRows(uint8_t* dst, const uint8_t* src, int top, int bottom) {
+  if (top < 0) top = 0;
+  if (bottom > DISPLAY_BUFFER_ROWS) bottom = DISPLAY_BUFFER_ROWS;
+  if (top >= bottom) return;
+  // Logical rows run bottom-up in the buffer: [top, bottom) is one block
+  size_t offset = (size_t)(DISPLAY_BUFFER_ROWS - bottom) * DISPLAY_BUFFER_ROW_BYTES;
+  memcpy(dst + offset, src + offset, (size_t)(bottom - top) * DISPLAY_BUFFER_ROW_BYTES);
+}
+
+static uint32_t hashNoticeBytes(uint32_t hash, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ p[i]) * 16777619u;  // FNV-1a
+  }
+  return hash;
+}
+
+// Everything drawNotificationOverlay() shows
+static uint32_t noticeSignature() {
+  uint32_t hash = 2166136261u;
+  hash = hashNoticeBytes(hash, currentNotification.heading, strlen(currentNotification.heading));
+  hash = hashNoticeBytes(hash, currentNotification.line1, strlen(currentNotification.line1));
+  hash = hashNoticeBytes(hash, currentNotification.line2, strlen(currentNotification.line2));
+  if (currentNotification.hasDynamicIcon) {
+    hash = hashNoticeBytes(hash, currentNotification.iconData, sizeof(currentNotification.iconData));
+  } else {
+    hash = hashNoticeBytes(hash, &currentNotification.icon, sizeof(currentNotification.icon));
+  }
+  return hash;
+}
+
+static void fillMapBaseKey(MapBaseKey* key, const MapView& view) {
+  memset(key, 0, sizeof(*key));  // Padding takes part in memcmp()
+  int tileX, tileY;
+  double pixelX, pixelY;
+  getTileCoordinates(view.lat, view.lon, view.zoom, &tileX, &tileY, &pixelX, &pixelY);
+  key->pixelX = (int32_t)tileX * 256 + (int)pixelX;
+  key->pixelY = (int32_t)tileY * 256 + (int)pixelY;
+  key->zoom = view.zoom;
+  key->rotation = view.rotation;
+  key->centerY = view.centerY;
+  key->mapHeight = view.mapHeight;
+  key->navigation = navigationActive;
+  key->scrubbed = navigationActive && scrubOffsetMeters != 0;
+  key->track = navigationActive ? navigationTrack : nullptr;
+  key->trackCount = navigationActive ? navigationTrackPointCount : 0;
+  key->canvasGeneration = mapCanvas.invalidations;
+}
+
+// GPS jitter within the drawn pixel keeps the key
+static void liveMapBaseKey(MapBaseKey* key) {
+  double lat, lon;
+  getMapViewCenter(&lat, &lon);
+  fillMapBaseKey(key, getLiveMapView(lat, lon));
+}
+
+// Drop every cached layer; the next map frame redraws all of them
+void invalidateMapLayers() {
+  for (int i = 0; i < MAP_LAYER_COUNT; i++) mapLayers.layers[i].valid = false;
+}
+
+/**
+ * The framebuffer holds tiles, route and marker of the view: keep it as the
+ * base layer. The bands are redrawn on top of a new base.
+ */
+void captureMapBaseLayer(const MapView& view) {
+  MapLayer& base = mapLayers.layers[MAP_LAYER_BASE];
+  if (!isDisplayBufferDirect() || !allocateMapLayers()) return;
+
+  memcpy(base.bits, getDisplayBuffer(), DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS);
+  base.top = 0;
+  base.bottom = DISPLAY_BUFFER_ROWS;
+  base.valid = true;
+  base.dirty = false;
+  base.redraws++;
+  fillMapBaseKey(&mapLayers.baseKey, view);
+
+  mapLayers.layers[MAP_LAYER_INFO].dirty = true;
+  mapLayers.layers[MAP_LAYER_SPEED].dirty = true;
+}
+
+// The cached base shows the live view
+bool isMapBaseLayerCurrent() {
+  if (!mapLayers.layers[MAP_LAYER_BASE].valid) return false;
+  MapBaseKey live;
+  liveMapBaseKey(&live);
+  return memcmp(&live, &mapLayers.baseKey, sizeof(live)) == 0;
+}
+
+/**
+ * Draw the bands over the base in the framebuffer: dirty or changed bands
+ * are painted and kept, clean ones copied from their buffers. Without
+ * layer buffers every band is painted.
+ */
+void drawMapBandLayers() {
+  bool cache = isDisplayBufferDirect() && allocateMapLayers();
+  uint8_t* frame = getDisplayBuffer();
+
+  for (int id = MAP_LAYER_INFO; id < MAP_LAYER_COUNT; id++) {
+    MapLayer& layer = mapLayers.layers[id];
+    bool active;
+    int top, bottom;
+    uint32_t signature = 0;
+    if (id == MAP_LAYER_INFO) {
+      active = true;
+      top = MAP_DISPLAY_HEIGHT;
+      bottom = DISPLAY_HEIGHT;
+    } else if (id == MAP_LAYER_SPEED) {
+      active = speedometerSplitEnabled;
+      top = 0;
+      bottom = SPEEDOMETER_SPLIT_HEIGHT;
+    } else {
+      active = currentNotification.visible;
+      top = 0;
+      bottom = NOTIFICATION_HEIGHT;
+      if (active) signature = noticeSignature();
+    }
+
+    if (!active) {
+      layer.valid = false;  // Base shows through
+      continue;
+    }
+
+    bool reuse = cache && layer.valid && !layer.dirty &&
+                 layer.top == top && layer.bottom == bottom && layer.signature == signature;
+    if (reuse) {
+      copyLayerRows(frame, layer.bits, top, bottom);
+      layer.reuses++;
+      continue;
+    }
+
+    if (id == MAP_LAYER_INFO) {
+      updateMapInfoBar();
+      if (navigationActive) {
+        drawPageDots();
+      }
+    } else if (id == MAP_LAYER_SPEED) {
+      drawSpeedometerSplitOverlay();
+      lastSpeedometerOverlayUpdate = millis();
+    } else {
+      drawNotificationOverlay();
+    }
+
+    layer.redraws++;
+    if (!cache) continue;
+    copyLayerRows(layer.bits, frame, top, bottom);
+    layer.top = top;
+    layer.bottom = bottom;
+    layer.signature = signature;
+    layer.valid = true;
+    layer.dirty = false;
+  }
+}
+
+/**
+ * Recomposite the live map view from the cached base and push it, for
+ * changes above the base only (FrameRegion bits: info bar and speed
+ * overlay bands are redrawn, the notice follows the notification).
+ * Returns false when the base does not show the live view - the caller
+ * renders a full map frame.
+ */
+bool refreshMapLayers(uint8_t regions) {
+  if (!isMapBaseLayerCurrent()) return false;
+
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  display.firstPage();  // Single full-screen page, pushed by flushDisplayDiff()
+  if (!isDisplayBufferDirect()) return false;
+
+  if (regions & FRAME_REGION_INFO_BAR) mapLayers.layers[MAP_LAYER_INFO].dirty = true;
+  if (regions & FRAME_REGION_SPEEDO_OVERLAY) mapLayers.layers[MAP_LAYER_SPEED].dirty = true;
+
+  memcpy(getDisplayBuffer(), mapLayers.layers[MAP_LAYER_BASE].bits, DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS);
+  mapLayers.layers[MAP_LAYER_BASE].reuses++;
+  drawMapBandLayers();
+  flushDisplayDiff();
+  mapLayers.layerFrames++;
+  return true;
+}
+
+void printMapLayerStats() {
+  Serial.println("=== MAP LAYERS ===");
+  Serial.printf("Frames without base work: %lu\n", mapLayers.layerFrames);
+  for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+    const MapLayer& layer = mapLayers.layers[i];
+    Serial.printf("%-6s  drawn %lu, reused %lu%s\n", MAP_LAYER_NAMES[i], layer.redraws, layer.reuses,
+                  layer.valid ? "" : " (empty)");
+  }
+  Serial.println("==================");
+}
+
+#endif // MAP_LAYERS_H
@@ -8,6 +8,7 @@
 
 // External references from main program
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -327,6 +328,7 @@ Coordinate* findPointOnRoute(RouteProgress startProgress, float distanceMeters,
 void renderTripStatsView() {
   Serial.println("Rendering trip stats view");
 
+  invalidatePanelShadow();  // Not a map frame, the next one is pushed whole
   display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
   display.firstPage();
 
@@ -373,7 +375,7 @@ void renderTripStatsView() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 /**
@@ -467,6 +469,7 @@ void stopTripNavigation() {
 
   // Free navigation track from PSRAM
   if (navigationTrack != nullptr) {
+    releaseRouteGeometry(navigationTrack);
     free(navigationTrack);  // ps_malloc'd memory is freed with regular free()
     navigationTrack = nullptr;
     navigationTrackPointCount = 0;
@@ -538,6 +541,7 @@ void checkGPSPositionChange() {
   lastCheckLon = currentLon;
   firstCheck = false;
   gpsPositionChanged = true;  // Trigger immediate screen update
+  noteMapInput();
 }
 
 /**
@@ -1083,6 +1087,7 @@ void drawProgressArc(int centerX, int centerY, int radius, int thickness, float
 void renderNavigationStatsView() {
   Serial.println("Rendering navigation stats view");
 
+  invalidatePanelShadow();  // Not a map frame, the next one is pushed whole
   display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
   display.firstPage();
 
@@ -1216,7 +1221,7 @@ void renderNavigationStatsView() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // --- FUTURE NAVIGATION IMPLEMENTATIONS ---
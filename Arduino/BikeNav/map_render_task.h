@@ -0,0 +1,413 @@
+#ifndef MAP_RENDER_TASK_H
+#define MAP_RENDER_TASK_H
+
+#include <Arduino.h>
+#include "display_buffer.h"
+#include "frame_scheduler.h"
+#include "spi_bus.h"
+
+// External map view state from page_map.h / map_rendering.h
+extern int zoomLevel;
+extern int mapRotation;
+extern int currentZoomIndex;
+extern double currentLat;
+extern double currentLon;
+
+// External tile cache functions from tile_cache.h
+extern void tileCacheLock();
+extern void tileCacheUnlock();
+extern TileCacheClass setTileCacheAccessClass(TileCacheClass cls);
+
+// External panel update from panel_diff.h
+extern bool flushDisplayDiff();
+
+// --- MAP RENDER TASK ---
+// The map area (tile reads, canvas refill, rotation resampling) is composed
+// by a FreeRTOS task on the core loop() does not run on, so GPS bytes,
+// encoder steps and BLE work keep flowing while tiles load. loop() posts
+// render requests and flushes finished frames: it copies the map area into
+// the display framebuffer, draws route, marker, info bar and overlays on
+// top and refreshes the panel - the display is only ever touched by loop().
+//
+// Requests coalesce in a single slot: a request posted while another still
+// waits replaces it. Frames are double buffered: the task composes into the
+// back frame while the last finished one waits for loop(); a finished frame
+// loop() has not taken yet is replaced by the next one.
+//
+// Tile cache and map canvas are shared with loop() (prefetch, radar page,
+// trip preview) and guarded by the tile cache lock; the task holds it for a
+// whole frame. Its tile reads and loop()'s panel updates share the SPI bus
+// through the arbiter in spi_bus.h (reads as SPI_CLIENT_SD_READ, lent
+// the bus while the panel runs its waveform); the task only starts once the
+// arbiter exists.
+#define MAP_RENDER_TASK_CORE 0           // loop() runs on core 1
+#define MAP_RENDER_TASK_PRIORITY 1       // Same as loop(), below the BLE host task
+#define MAP_RENDER_TASK_STACK 8192
+#define MAP_RENDER_FRAME_BYTES (DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS)
+
+// Everything the task needs to compose a view; loop() may change the live
+// state while the request is in flight
+struct MapRenderRequest {
+  double lat, lon;
+  int zoom;
+  int rotation;
+  int centerY;
+  int mapHeight;
+  bool routeView;             // Tiles are route corridor (TILE_CLASS_ROUTE)
+  uint32_t sequence;
+  unsigned long inputMicros;  // Oldest input the frame answers, 0 = none
+};
+
+struct MapRenderTaskState {
+  TaskHandle_t handle;
+  uint8_t* frames[2];         // Framebuffer layout (display_buffer.h), PSRAM
+  SemaphoreHandle_t frameMutex;
+  int backFrame;              // Frame the task composes into
+  int readyFrame;             // Finished frame waiting for loop(), -1 = none
+  MapRenderRequest readyRequest;
+  bool readyComposed;         // False: no map area (canvas unavailable), loop() renders itself
+  unsigned long readyComposeUs;
+  MapRenderRequest pending;
+  bool hasPending;
+  uint32_t requestedSequence;
+  uint32_t shownSequence;     // Last request whose frame reached the panel
+  bool bypass;                // Render synchronously in loop() (fallback, benchmark)
+  unsigned long requests;
+  unsigned long coalesced;    // Requests replaced before the task picked them up
+  unsigned long framesComposed;
+  unsigned long framesDropped;  // Finished frames replaced before loop() took them
+};
+
+MapRenderTaskState mapRenderTask = {nullptr, {nullptr, nullptr}, nullptr, 0, -1};
+portMUX_TYPE mapRenderRequestMux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool takeMapRenderRequest(MapRenderRequest* request) {
+  portENTER_CRITICAL(&mapRenderRequestMux);
+  bool taken = mapRenderTask.hasPending;
+  if (taken) {
+    *request = mapRenderTask.pending;
+    mapRenderTask.hasPending = false;
+  }
+  portEXIT_CRITICAL(&mapRenderRequestMux);
+  return taken;
+}
+
+// Map area of one request into a frame, white where there is no map
+static bool composeMapRenderFrame(const MapRenderRequest& request, uint8_t* frame) {
+  memset(frame, 0xFF, MAP_RENDER_FRAME_BYTES);
+
+  MapRotationSetup setup;
+  computeMapRotationSetup(request.rotation, request.centerY, &setup);
+
+  tileCacheLock();
+  TileCacheClass previousClass = setTileCacheAccessClass(request.routeView ? TILE_CLASS_ROUTE : TILE_CLASS_BROWSE);
+  bool composed = composeMapCanvas(request.lat, request.lon, request.zoom, setup, request.mapHeight, frame);
+  setTileCacheAccessClass(previousClass);
+  tileCacheUnlock();
+  return composed;
+}
+
+static void mapRenderTaskLoop(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    MapRenderRequest request;
+    while (takeMapRenderRequest(&request)) {
+      unsigned long start = micros();
+      int back = mapRenderTask.backFrame;
+      bool composed = composeMapRenderFrame(request, mapRenderTask.frames[back]);
+      unsigned long composeUs = micros() - start;
+
+      // Publish; the frame loop() has not taken yet becomes the new back frame
+      xSemaphoreTake(mapRenderTask.frameMutex, portMAX_DELAY);
+      if (mapRenderTask.readyFrame >= 0) mapRenderTask.framesDropped++;
+      mapRenderTask.readyFrame = back;
+      mapRenderTask.backFrame = back ^ 1;
+      mapRenderTask.readyRequest = request;
+      mapRenderTask.readyComposed = composed;
+      mapRenderTask.readyComposeUs = composeUs;
+      mapRenderTask.framesComposed++;
+      xSemaphoreGive(mapRenderTask.frameMutex);
+    }
+  }
+}
+
+/**
+ * Allocate the two frames and start the render task. Needs PSRAM, the tile
+ * cache and the SPI bus arbiter (initSpiBus()); without them
+ * loadAndDisplayMap() keeps rendering in loop().
+ */
+bool startMapRenderTask() {
+  if (mapRenderTask.handle) return true;
+  if (!isTileCacheReady()) {
+    Serial.println("[RENDER] Tile cache unavailable, map renders in loop()");
+    return false;
+  }
+  if (!spiBus.mutex) {
+    Serial.println("[RENDER] SPI bus unarbitrated, map renders in loop()");
+    return false;
+  }
+
+  uint8_t* frames = (uint8_t*)ps_malloc(2 * MAP_RENDER_FRAME_BYTES);
+  if (!frames) {
+    Serial.println("[RENDER] ERROR: Failed to allocate render frames");
+    return false;
+  }
+  mapRenderTask.frameMutex = xSemaphoreCreateMutex();
+  if (!mapRenderTask.frameMutex) {
+    free(frames);
+    Serial.println("[RENDER] ERROR: Failed to create frame mutex");
+    return false;
+  }
+  mapRenderTask.frames[0] = frames;
+  mapRenderTask.frames[1] = frames + MAP_RENDER_FRAME_BYTES;
+  mapRenderTask.backFrame = 0;
+  mapRenderTask.readyFrame = -1;
+
+  if (xTaskCreatePinnedToCore(mapRenderTaskLoop, "mapRender", MAP_RENDER_TASK_STACK, nullptr,
+                              MAP_RENDER_TASK_PRIORITY, &mapRenderTask.handle,
+                              MAP_RENDER_TASK_CORE) != pdPASS) {
+    mapRenderTask.handle = nullptr;
+    vSemaphoreDelete(mapRenderTask.frameMutex);
+    mapRenderTask.frameMutex = nullptr;
+    free(frames);
+    Serial.println("[RENDER] ERROR: Failed to start render task");
+    return false;
+  }
+
+  Serial.printf("[RENDER] Render task started on core %d (2 x %d byte frames)\n",
+                MAP_RENDER_TASK_CORE, MAP_RENDER_FRAME_BYTES);
+  return true;
+}
+
+/**
+ * Post the live map view (centered on lat/lon) to the render task. Replaces
+ * a request the task has not started yet. Returns false when the task is
+ * not available - the caller renders synchronously.
+ */
+bool requestMapRender(double lat, double lon, bool routeView, unsigned long inputMicros) {
+  if (!mapRenderTask.handle || mapRenderTask.bypass) return false;
+  if (display.getRotation() != 2) return false;  // Frames use the direct framebuffer layout
+
+  MapRenderRequest request;
+  request.lat = lat;
+  request.lon = lon;
+  request.zoom = zoomLevel;
+  request.rotation = mapRotation;
+  request.centerY = currentCenterY;
+  request.mapHeight = MAP_DISPLAY_HEIGHT;
+  request.routeView = routeView;
+  request.sequence = ++mapRenderTask.requestedSequence;
+  request.inputMicros = inputMicros;
+
+  portENTER_CRITICAL(&mapRenderRequestMux);
+  if (mapRenderTask.hasPending) {
+    mapRenderTask.coalesced++;
+    // The stale request's input is still not on screen - measure from it
+    if (mapRenderTask.pending.inputMicros) request.inputMicros = mapRenderTask.pending.inputMicros;
+  }
+  mapRenderTask.pending = request;
+  mapRenderTask.hasPending = true;
+  portEXIT_CRITICAL(&mapRenderRequestMux);
+
+  mapRenderTask.requests++;
+  xTaskNotifyGive(mapRenderTask.handle);
+  return true;
+}
+
+// Copy the ready frame into the display framebuffer. Requires isDisplayBufferDirect().
+static bool takeMapRenderFrame(MapRenderRequest* request, bool* composed, unsigned long* composeUs) {
+  xSemaphoreTake(mapRenderTask.frameMutex, portMAX_DELAY);
+  int ready = mapRenderTask.readyFrame;
+  if (ready >= 0) {
+    memcpy(getDisplayBuffer(), mapRenderTask.frames[ready], MAP_RENDER_FRAME_BYTES);
+    *request = mapRenderTask.readyRequest;
+    *composed = mapRenderTask.readyComposed;
+    *composeUs = mapRenderTask.readyComposeUs;
+    mapRenderTask.readyFrame = -1;
+  }
+  xSemaphoreGive(mapRenderTask.frameMutex);
+  return ready >= 0;
+}
+
+static void dropMapRenderFrame() {
+  xSemaphoreTake(mapRenderTask.frameMutex, portMAX_DELAY);
+  if (mapRenderTask.readyFrame >= 0) {
+    mapRenderTask.readyFrame = -1;
+    mapRenderTask.framesDropped++;
+    // Superseded on screen by whatever page is showing; no longer in flight
+    mapRenderTask.shownSequence = mapRenderTask.readyRequest.sequence;
+  }
+  xSemaphoreGive(mapRenderTask.frameMutex);
+}
+
+/**
+ * Flush a finished frame to the panel. The foreground is drawn for the view
+ * the frame was composed for, so route and tiles agree even when the live
+ * rotation or zoom moved on (a newer request is then on its way).
+ * Call from loop(); does nothing while no frame is ready.
+ */
+void pollMapRenderTask() {
+  if (!mapRenderTask.handle || mapRenderTask.readyFrame < 0) return;
+
+  // Frames only matter while the map view is on screen
+  if (currentPage != PAGE_MAP || currentMapSubPage != MAP_SUBPAGE_MAP) {
+    dropMapRenderFrame();
+    return;
+  }
+
+  // Wait for the refresh slot; a newer frame may replace this one meanwhile
+  xSemaphoreTake(mapRenderTask.frameMutex, portMAX_DELAY);
+  bool answersInput = mapRenderTask.readyRequest.inputMicros != 0;
+  xSemaphoreGive(mapRenderTask.frameMutex);
+  FramePriority priority = answersInput ? FRAME_PRIORITY_INPUT : FRAME_PRIORITY_NAVIGATION;
+  if (!isFrameSlotOpen(priority)) return;
+
+  unsigned long start = micros();
+  MapRenderRequest request;
+  bool composed = false;
+  unsigned long composeUs = 0;
+  bool taken = false;
+
+  display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  display.firstPage();  // Single full-screen page, pushed by flushDisplayDiff()
+
+  taken = takeMapRenderFrame(&request, &composed, &composeUs);
+  if (taken && composed) {
+    MapView view = {request.lat, request.lon, request.zoom, request.rotation, request.centerY, request.mapHeight};
+    drawMapForeground(view);
+    flushDisplayDiff();
+  }
+
+  if (!taken) return;
+  if (!composed) {
+    // No canvas for this frame - render it the old way, in loop()
+    Serial.println("[RENDER] Frame without map area, rendering synchronously");
+    mapRenderTask.bypass = true;
+    if (request.inputMicros) mapInputMicros = request.inputMicros;
+    loadAndDisplayMap();
+    mapRenderTask.bypass = false;
+    mapRenderTask.shownSequence = request.sequence;
+    return;
+  }
+
+  mapRenderTask.shownSequence = request.sequence;
+  // Foreground was drawn with live state: pending info bar, overlays and notification are on screen
+  noteFrameUpdate(FRAME_REGIONS_MAP_VIEW & ~FRAME_REGION_MAP, priority, FRAME_KIND_MAP);
+  Serial.printf("[RENDER] Frame %lu composed in %lu ms (%lu requests, %lu coalesced, %lu frames dropped)\n",
+                (unsigned long)request.sequence, composeUs / 1000,
+                mapRenderTask.requests, mapRenderTask.coalesced, mapRenderTask.framesDropped);
+  recordMapLatency(mapLatencyTask, "task", request.inputMicros, micros() - start);
+}
+
+// Map view frames are composed on the task (not bypassed for a fallback or benchmark)
+bool isMapRenderTaskRunning() {
+  return mapRenderTask.handle && !mapRenderTask.bypass;
+}
+
+// True while a posted request has not reached the panel yet
+bool isMapRenderInFlight() {
+  return mapRenderTask.handle && mapRenderTask.shownSequence != mapRenderTask.requestedSequence;
+}
+
+#if BIKENAV_DEBUG_COMMANDS
+/**
+ * Debug: replay a scripted ride on the map view - GPS fixes 25 m apart,
+ * zoom steps and a burst of rotation steps - first rendering in loop(),
+ * then through the render task, and report input-to-refresh latency and
+ * the longest single loop() stall of each pass. GPS fixes and zoom steps
+ * wait for their frame, the rotation burst does not (exercises coalescing).
+ * Restores position, zoom and rotation afterwards.
+ */
+void benchmarkMapRenderLatency() {
+  struct ScriptStep { char input; int value; bool wait; };
+  const ScriptStep script[] = {
+    {'g', 1, true}, {'g', 1, true}, {'g', 1, true}, {'g', 1, true},
+    {'z', -1, true}, {'z', 1, true},
+    {'r', 15, false}, {'r', 15, false}, {'r', 15, false}, {'r', 15, true},
+    {'g', 1, true}, {'g', 1, true},
+  };
+  const int stepCount = sizeof(script) / sizeof(script[0]);
+  const double stepLat = 25.0 / 111320.0;  // 25 m north
+  const unsigned long timeoutUs = 5000000;
+
+  if (currentPage != PAGE_MAP || currentMapSubPage != MAP_SUBPAGE_MAP) {
+    Serial.println("[RENDER] Benchmark: open the map view first");
+    return;
+  }
+
+  double savedLat = currentLat;
+  double savedLon = currentLon;
+  int savedZoomIndex = currentZoomIndex;
+  int savedRotation = mapRotation;
+
+  for (int pass = 0; pass < 2; pass++) {
+    bool useTask = pass == 1;
+    if (useTask && !mapRenderTask.handle) {
+      Serial.println("[RENDER] Benchmark: render task not running, skipping task pass");
+      break;
+    }
+
+    currentLat = savedLat;
+    currentLon = savedLon;
+    currentZoomIndex = savedZoomIndex;
+    zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+    mapRotation = savedRotation;
+    invalidateMapCanvas();
+    mapRenderTask.bypass = !useTask;
+
+    MapLatencyStats& stats = useTask ? mapLatencyTask : mapLatencySync;
+    MapLatencyStats before = stats;
+    unsigned long coalescedBefore = mapRenderTask.coalesced;
+    unsigned long maxStallUs = 0;
+
+    for (int i = 0; i < stepCount; i++) {
+      const ScriptStep& step = script[i];
+      if (step.input == 'g') {
+        currentLat += step.value * stepLat;
+      } else if (step.input == 'z') {
+        currentZoomIndex = constrain(currentZoomIndex + step.value, 0, ZOOM_COUNT - 1);
+        zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+      } else {
+        mapRotation = (mapRotation + step.value) % 360;
+      }
+      noteMapInput();
+
+      unsigned long callStart = micros();
+      loadAndDisplayMap();
+      unsigned long stallUs = micros() - callStart;
+      if (stallUs > maxStallUs) maxStallUs = stallUs;
+      if (!step.wait) continue;
+
+      // Spin like loop() does until the frame is on the panel
+      unsigned long waitStart = micros();
+      while (isMapRenderInFlight() && micros() - waitStart < timeoutUs) {
+        callStart = micros();
+        pollMapRenderTask();
+        stallUs = micros() - callStart;
+        if (stallUs > maxStallUs) maxStallUs = stallUs;
+        delay(1);
+      }
+    }
+
+    unsigned long inputs = stats.inputs - before.inputs;
+    unsigned long frames = stats.frames - before.frames;
+    Serial.printf("[RENDER] Benchmark %s: %d inputs -> %lu frames, input->refresh avg %lu ms, longest loop stall %lu ms, %lu coalesced\n",
+                  useTask ? "task" : "sync", stepCount, frames,
+                  inputs ? (stats.latencyTotalUs - before.latencyTotalUs) / inputs / 1000 : 0,
+                  maxStallUs / 1000, mapRenderTask.coalesced - coalescedBefore);
+  }
+
+  mapRenderTask.bypass = false;
+  currentLat = savedLat;
+  currentLon = savedLon;
+  currentZoomIndex = savedZoomIndex;
+  zoomLevel = ZOOM_LEVELS[currentZoomIndex];
+  mapRotation = savedRotation;
+  printMapLatencyStats("sync", mapLatencySync);
+  printMapLatencyStats("task", mapLatencyTask);
+  loadAndDisplayMap();
+}
+#endif // BIKENAV_DEBUG_COMMANDS
+
+#endif // MAP_RENDER_TASK_H
@@ -6,6 +6,10 @@
 #include <SD.h>
 #include <math.h>
 #include "timezone.h"
+#include "display_buffer.h"
+#include "glyph_cache.h"
+#include "panel_diff.h"
+#include "spi_bus.h"
 
 // External references from main program
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
@@ -24,7 +28,17 @@ void drawSpeedometerSplitOverlay();
 // External tile cache functions
 extern uint8_t* tileCacheLookup(int zoom, int tileX, int tileY);
 extern uint8_t* tileCacheInsert(int zoom, int tileX, int tileY);
-extern void printTileCacheStats();
+extern bool tileCacheCommit(uint8_t* tileData);
+extern bool isTileCacheReady();
+extern TileCacheClass setTileCacheAccessClass(TileCacheClass cls);
+extern void tileCacheLock();
+extern void tileCacheUnlock();
+
+// External tile presence filter from tile_presence.h
+extern bool tilePresenceMayExist(int zoom, int tileX, int tileY);
+extern void tilePresenceNoteMiss();
+extern unsigned long takeTilePresenceFrameStats();
+extern unsigned long tilePresenceProbesAvoided;
 
 // External location marker function
 extern void drawLocationMarker(int x, int y, GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT>& display);
@@ -111,7 +125,6 @@ const int SCRUB_STEP_METERS[] = {10, 20, 30, 50, 75, 100, 150, 200, 250, 300};
 // Route line width per zoom level [18, 17, 16, 15, 14, 13, 12, 11, 10, 9]
 // Tunable: Adjust these values to change route thickness at different zoom levels
 const int ROUTE_LINE_WIDTH[] = {6, 4, 3, 3, 2, 2, 2, 2, 2, 2};
-const int MAX_ROUTE_SEGMENTS = 300;  // Maximum line segments to draw (performance optimization)
 
 // Center point on screen where GPS location is displayed
 const int CENTER_X = DISPLAY_WIDTH / 2;
@@ -131,18 +144,28 @@ struct TileInfo {
   int screenY;
 };
 
-TileInfo tilesToRender[25];  // Support up to 5x5 grid for rotated maps
+// The rotated map area fits in a (width + height) square, which overlaps
+// at most (width + height) / 256 + 2 tiles per axis
+const int MAX_VISIBLE_TILES_SPAN = (GxEPD2_290_BS::WIDTH + GxEPD2_290_BS::HEIGHT) / 256 + 2;
+const int MAX_VISIBLE_TILES = MAX_VISIBLE_TILES_SPAN * MAX_VISIBLE_TILES_SPAN;
+
+TileInfo tilesToRender[MAX_VISIBLE_TILES];
 int tileCount = 0;
+int tilesDrawnThisFrame = 0;  // Tiles that covered at least one screen pixel
 
 // --- FUNCTION PROTOTYPES ---
 void getTileCoordinates(double lat, double lon, int zoom, int* tileX, int* tileY, double* pixelX, double* pixelY);
-bool isTileVisible(int screenX, int screenY, int rotation);
+void collectVisibleTiles(int originTileX, int originTileY, int originScreenX, int originScreenY);
 void calculateVisibleTiles(double lat, double lon, int zoom);
+uint8_t* loadTileIntoCache(int zoom, int tileX, int tileY);
 bool loadAndRenderTile(int tileX, int tileY, int zoom, int screenX, int screenY);
 void updateMapInfoBar();
 void refreshMapInfoBar();
 void loadAndDisplayMap();
-void drawRadarOverlay(const uint8_t* frameData);
+bool isRadarCompositorDirect();
+void drawRadarOverlay(const uint8_t* frameData, int lightenPhase);
+bool renderMapFromCanvas(double lat, double lon, int zoom);  // map_canvas.h
+bool requestMapRender(double lat, double lon, bool routeView, unsigned long inputMicros);  // map_render_task.h
 
 // --- IMPLEMENTATIONS ---
 
@@ -160,139 +183,279 @@ void getTileCoordinates(double lat, double lon, int zoom, int* tileX, int* tileY
   *pixelY = (tileYFloat - *tileY) * 256;
 }
 
-// Helper function: check if a tile will be visible after rotation
-bool isTileVisible(int screenX, int screenY, int rotation) {
-  if (rotation == 0) {
-    // Simple rectangular check for non-rotated
-    return (screenX + 256 > 0 && screenX < DISPLAY_WIDTH &&
-            screenY + 256 > 0 && screenY < MAP_DISPLAY_HEIGHT);
-  }
-
-  // For rotated tiles we need to check both directions:
-  // 1. Do any tile corners (after rotation) fall inside viewport?
-  // 2. Do any viewport corners (after inverse rotation) fall inside tile?
+/**
+ * Move lat/lon to the middle of the world pixel it falls in at zoom. Tiles
+ * are placed by whole pixels anyway; drawing the route for the snapped
+ * center as well means GPS jitter inside one pixel draws the same frame,
+ * and the cached base layer (map_layers.h) stays valid.
+ */
+void snapToMapPixel(double* lat, double* lon, int zoom) {
+  int tileX, tileY;
+  double pixelX, pixelY;
+  getTileCoordinates(*lat, *lon, zoom, &tileX, &tileY, &pixelX, &pixelY);
+  double n = pow(2.0, zoom);
+  double x = tileX + (floor(pixelX) + 0.5) / 256.0;
+  double y = tileY + (floor(pixelY) + 0.5) / 256.0;
+  *lon = x / n * 360.0 - 180.0;
+  *lat = atan(sinh(M_PI * (1.0 - 2.0 * y / n))) * 180.0 / M_PI;
+}
 
-  float rotationRad = rotation * M_PI / 180.0;
-  float cosAngle = cos(rotationRad);
-  float sinAngle = sin(rotationRad);
+/**
+ * Center of the live map view, as loadAndDisplayMap() draws it: the
+ * scrubbed position while scrubbing a route, otherwise GPS, snapped to
+ * the world pixel.
+ */
+void getMapViewCenter(double* lat, double* lon) {
+  // Scrub offset persists across all modes (ZOOM, ROTATION, SCRUB)
+  bool scrubbed = scrubOffsetMeters != 0 && navigationActive;
+  *lat = scrubbed ? scrubLat : currentLat;
+  *lon = scrubbed ? scrubLon : currentLon;
+  snapToMapPixel(lat, lon, zoomLevel);
+}
 
-  // CHECK 1: Tile's 4 corners after rotation -> are they in viewport?
-  int tileCorners[4][2] = {
-    {screenX, screenY},              // Top-left
-    {screenX + 256, screenY},        // Top-right
-    {screenX, screenY + 256},        // Bottom-left
-    {screenX + 256, screenY + 256}   // Bottom-right
-  };
+// --- ROTATED TILE RENDERING ---
+// Destination driven: every screen pixel of the map area is rotated back
+// into unrotated screen space and samples exactly one source bit, so rotated
+// maps have no holes or double hits and cost scales with screen pixels.
+// Positions are Q16 and built from one per-frame setup with integer steps,
+// which makes neighbouring tiles agree exactly on their shared edges.
+struct MapRotationSetup {
+  int rotation;
+  int centerY;
+  float cosAngle, sinAngle;
+  int32_t originU, originV;   // Unrotated position of the center of screen pixel (0,0), Q16
+  int32_t colDU, colDV;       // Step per screen column, Q16
+  int32_t rowDU, rowDV;       // Step per screen row, Q16
+};
 
-  for (int i = 0; i < 4; i++) {
-    float x = tileCorners[i][0];
-    float y = tileCorners[i][1];
+MapRotationSetup mapRotationSetup = {-1, -1};
+
+// Setup for an explicit rotation/center, for views that are not the live one
+static void computeMapRotationSetup(int rotation, int centerY, MapRotationSetup* setup) {
+  double rotationRad = rotation * M_PI / 180.0;
+  double c = cos(rotationRad);
+  double s = sin(rotationRad);
+  double relX = 0.5 - CENTER_X;
+  double relY = 0.5 - centerY;
+
+  setup->rotation = rotation;
+  setup->centerY = centerY;
+  setup->cosAngle = c;
+  setup->sinAngle = s;
+  // Inverse rotation: unrotated = R(-angle) * (screen - center) + center
+  setup->originU = (int32_t)lround((relX * c + relY * s + CENTER_X) * 65536.0);
+  setup->originV = (int32_t)lround((-relX * s + relY * c + centerY) * 65536.0);
+  setup->colDU = (int32_t)lround(c * 65536.0);
+  setup->colDV = (int32_t)lround(-s * 65536.0);
+  setup->rowDU = (int32_t)lround(s * 65536.0);
+  setup->rowDV = (int32_t)lround(c * 65536.0);
+}
 
-    // Translate to center
-    float relX = x - CENTER_X;
-    float relY = y - currentCenterY;
+// Trig and origin are computed once per rotation/center change, not per tile
+static const MapRotationSetup& getMapRotationSetup() {
+  if (mapRotationSetup.rotation != mapRotation || mapRotationSetup.centerY != currentCenterY) {
+    computeMapRotationSetup(mapRotation, currentCenterY, &mapRotationSetup);
+  }
+  return mapRotationSetup;
+}
 
-    // Apply rotation
-    float rotatedX = relX * cosAngle - relY * sinAngle;
-    float rotatedY = relX * sinAngle + relY * cosAngle;
+// What a map frame shows. loop() draws the live view (the globals); a frame
+// composed by the render task carries the view of its request, and its
+// foreground is drawn for that view while the globals may have moved on.
+struct MapView {
+  double lat, lon;            // Map center (GPS or scrubbed position)
+  int zoom;
+  int rotation;
+  int centerY;
+  int mapHeight;
+};
 
-    // Translate back
-    int finalX = (int)(rotatedX + CENTER_X);
-    int finalY = (int)(rotatedY + currentCenterY);
+MapView getLiveMapView(double centerLat, double centerLon) {
+  MapView view = {centerLat, centerLon, zoomLevel, mapRotation, currentCenterY, MAP_DISPLAY_HEIGHT};
+  return view;
+}
 
-    // Check if this corner is visible
-    if (finalX >= 0 && finalX < DISPLAY_WIDTH &&
-        finalY >= 0 && finalY < MAP_DISPLAY_HEIGHT) {
-      return true;
-    }
+static int getRouteLineWidth(int zoom) {
+  for (int i = 0; i < ZOOM_COUNT; i++) {
+    if (ZOOM_LEVELS[i] == zoom) return ROUTE_LINE_WIDTH[i];
   }
+  return ROUTE_LINE_WIDTH[ZOOM_COUNT - 1];
+}
 
-  // CHECK 2: Viewport's 4 corners with inverse rotation -> are they in tile bounds?
-  // Use inverse rotation to transform viewport corners back to original tile space
-  float invCos = cosAngle;   // cos(-x) = cos(x)
-  float invSin = -sinAngle;  // sin(-x) = -sin(x)
-
-  int viewportCorners[4][2] = {
-    {0, 0},                              // Top-left
-    {DISPLAY_WIDTH - 1, 0},              // Top-right
-    {0, MAP_DISPLAY_HEIGHT - 1},         // Bottom-left
-    {DISPLAY_WIDTH - 1, MAP_DISPLAY_HEIGHT - 1}  // Bottom-right
-  };
+static inline int32_t floorDiv(int32_t n, int32_t d) {
+  int32_t q = n / d;
+  return (n % d != 0 && ((n < 0) != (d < 0))) ? q - 1 : q;
+}
 
-  for (int i = 0; i < 4; i++) {
-    float vx = viewportCorners[i][0];
-    float vy = viewportCorners[i][1];
+// Narrow [*start, *end) to the columns where 0 <= a + x * d < limit
+static void clipSpanQ16(int32_t a, int32_t d, int32_t limit, int* start, int* end) {
+  int lo, hi;
+  if (d == 0) {
+    if (a < 0 || a >= limit) *end = *start;
+    return;
+  }
+  if (d > 0) {
+    lo = -floorDiv(a, d);                       // ceil(-a / d)
+    hi = -floorDiv(a - limit, d);               // ceil((limit - a) / d)
+  } else {
+    lo = floorDiv(a - limit, -d) + 1;
+    hi = floorDiv(a, -d) + 1;
+  }
+  if (lo > *start) *start = lo;
+  if (hi < *end) *end = hi;
+}
 
-    // Translate to center
-    float relX = vx - CENTER_X;
-    float relY = vy - currentCenterY;
+/**
+ * Render one cached tile (unrotated top-left at screenX/screenY) rotated by
+ * mapRotation around (CENTER_X, currentCenterY). Walks the screen rows the
+ * tile can touch, clips each row to the exact column span inside the tile
+ * and samples one bit per output pixel. Returns the screen pixels covered.
+ */
+static int renderTileRotated(const uint8_t* tileData, int screenX, int screenY) {
+  const MapRotationSetup& r = getMapRotationSetup();
+  const int32_t tileLimit = 256 << 16;
+  bool direct = isDisplayBufferDirect();
 
-    // Apply inverse rotation
-    float origX = relX * invCos - relY * invSin;
-    float origY = relX * invSin + relY * invCos;
+  // Screen rows touched by the rotated tile (forward-rotated corner extent)
+  float minY = 1e9, maxY = -1e9;
+  for (int i = 0; i < 4; i++) {
+    float relX = screenX + ((i & 1) ? 256 : 0) - CENTER_X;
+    float relY = screenY + ((i & 2) ? 256 : 0) - currentCenterY;
+    float y = relX * r.sinAngle + relY * r.cosAngle + currentCenterY;
+    if (y < minY) minY = y;
+    if (y > maxY) maxY = y;
+  }
+  int rowStart = (int)floorf(minY) - 1;
+  int rowEnd = (int)ceilf(maxY) + 1;
+  if (rowStart < 0) rowStart = 0;
+  if (rowEnd > MAP_DISPLAY_HEIGHT) rowEnd = MAP_DISPLAY_HEIGHT;
+
+  int32_t tileU = (int32_t)screenX * 65536;
+  int32_t tileV = (int32_t)screenY * 65536;
+  uint8_t rowMask[DISPLAY_BUFFER_ROW_BYTES];
+  int covered = 0;
+
+  for (int y = rowStart; y < rowEnd; y++) {
+    // Tile-relative position of column 0 on this row
+    int32_t u = r.originU + y * r.rowDU - tileU;
+    int32_t v = r.originV + y * r.rowDV - tileV;
+
+    int x = 0;
+    int xEnd = DISPLAY_WIDTH;
+    clipSpanQ16(u, r.colDU, tileLimit, &x, &xEnd);
+    clipSpanQ16(v, r.colDV, tileLimit, &x, &xEnd);
+    if (x >= xEnd) continue;
+    covered += xEnd - x;
+
+    u += x * r.colDU;
+    v += x * r.colDV;
+    bool anyBlack = false;
+    if (direct) memset(rowMask, 0, sizeof(rowMask));
+
+    for (; x < xEnd; x++, u += r.colDU, v += r.colDV) {
+      int tx = u >> 16;
+      int ty = v >> 16;
+      if ((tileData[ty * 32 + (tx >> 3)] >> (7 - (tx & 7))) & 1) continue;  // White
+      if (radarMapLightenEnabled && ((tx + ty) & 1)) continue;
+
+      if (direct) {
+        rowMask[x >> 3] |= 0x80 >> (x & 7);
+        anyBlack = true;
+      } else {
+        display.drawPixel(x, y, GxEPD_BLACK);
+      }
+    }
 
-    // Translate back
-    float finalX = origX + CENTER_X;
-    float finalY = origY + currentCenterY;
+    if (anyBlack) displayApplyRowMask(y, rowMask);
+  }
+  return covered;
+}
 
-    // Check if this inverse-rotated viewport corner is inside the tile bounds
-    if (finalX >= screenX && finalX < screenX + 256 &&
-        finalY >= screenY && finalY < screenY + 256) {
-      return true;
+// x extent of a convex polygon inside the horizontal band top < y < bottom
+static bool getPolygonBandSpan(const float* px, const float* py, int n, float top, float bottom,
+                               float* minX, float* maxX) {
+  *minX = 1e9;
+  *maxX = -1e9;
+  for (int i = 0; i < n; i++) {
+    int j = (i + 1) % n;
+    if (py[i] >= top && py[i] <= bottom) {
+      if (px[i] < *minX) *minX = px[i];
+      if (px[i] > *maxX) *maxX = px[i];
+    }
+    // Edge crossings of the band borders
+    float borders[2] = {top, bottom};
+    for (int k = 0; k < 2; k++) {
+      float yb = borders[k];
+      if ((py[i] - yb) * (py[j] - yb) < 0) {
+        float x = px[i] + (px[j] - px[i]) * (yb - py[i]) / (py[j] - py[i]);
+        if (x < *minX) *minX = x;
+        if (x > *maxX) *maxX = x;
+      }
     }
   }
+  return *minX < *maxX;
+}
 
-  // CHECK 3: Check tile's center point after rotation
-  float tileCenterX = screenX + 128;
-  float tileCenterY = screenY + 128;
-
-  float relX = tileCenterX - CENTER_X;
-  float relY = tileCenterY - currentCenterY;
-
-  float rotatedCenterX = relX * cosAngle - relY * sinAngle + CENTER_X;
-  float rotatedCenterY = relX * sinAngle + relY * cosAngle + currentCenterY;
-
-  if (rotatedCenterX >= 0 && rotatedCenterX < DISPLAY_WIDTH &&
-      rotatedCenterY >= 0 && rotatedCenterY < MAP_DISPLAY_HEIGHT) {
-    return true;
+// Map area corners of a view rotated back into unrotated screen space (TL, TR, BR, BL)
+static void getUnrotatedViewportFor(const MapRotationSetup& r, int mapHeight, float* px, float* py) {
+  for (int i = 0; i < 4; i++) {
+    float relX = ((i == 1 || i == 2) ? DISPLAY_WIDTH : 0) - CENTER_X;
+    float relY = ((i >= 2) ? mapHeight : 0) - r.centerY;
+    px[i] = relX * r.cosAngle + relY * r.sinAngle + CENTER_X;
+    py[i] = -relX * r.sinAngle + relY * r.cosAngle + r.centerY;
   }
+}
 
-  // CHECK 4: Check viewport center in tile space
-  if (CENTER_X >= screenX && CENTER_X < screenX + 256 &&
-      currentCenterY >= screenY && currentCenterY < screenY + 256) {
-    return true;
-  }
+// Same for the live view
+static void getUnrotatedViewport(float* px, float* py) {
+  getUnrotatedViewportFor(getMapRotationSetup(), MAP_DISPLAY_HEIGHT, px, py);
+}
 
-  // CHECK 5: Check edge midpoints of tile (catches diagonal intersections)
-  int edgeMidpoints[4][2] = {
-    {screenX + 128, screenY},         // Top edge midpoint
-    {screenX + 256, screenY + 128},   // Right edge midpoint
-    {screenX + 128, screenY + 256},   // Bottom edge midpoint
-    {screenX, screenY + 128}          // Left edge midpoint
-  };
+/**
+ * Fill tilesToRender with exactly the tiles the rotated map area overlaps.
+ * The map area is rotated back into unrotated screen space (a convex
+ * quadrilateral); every tile row it crosses contributes the tile columns
+ * of the quadrilateral's x extent inside that row. No per-tile trig.
+ * originTileX/Y is the tile whose top-left corner is at originScreenX/Y.
+ */
+void collectVisibleTiles(int originTileX, int originTileY, int originScreenX, int originScreenY) {
+  tileCount = 0;
+  tilesDrawnThisFrame = 0;
 
+  float px[4], py[4];
+  float minY = 1e9, maxY = -1e9;
+  getUnrotatedViewport(px, py);
   for (int i = 0; i < 4; i++) {
-    float x = edgeMidpoints[i][0];
-    float y = edgeMidpoints[i][1];
-
-    float relX = x - CENTER_X;
-    float relY = y - currentCenterY;
-
-    float rotatedX = relX * cosAngle - relY * sinAngle + CENTER_X;
-    float rotatedY = relX * sinAngle + relY * cosAngle + currentCenterY;
+    px[i] -= originScreenX;
+    py[i] -= originScreenY;
+    if (py[i] < minY) minY = py[i];
+    if (py[i] > maxY) maxY = py[i];
+  }
 
-    if (rotatedX >= 0 && rotatedX < DISPLAY_WIDTH &&
-        rotatedY >= 0 && rotatedY < MAP_DISPLAY_HEIGHT) {
-      return true;
+  int firstRow = (int)floorf(minY / 256.0f);
+  int lastRow = (int)ceilf(maxY / 256.0f) - 1;
+  for (int row = firstRow; row <= lastRow; row++) {
+    float spanMinX, spanMaxX;
+    if (!getPolygonBandSpan(px, py, 4, row * 256.0f, (row + 1) * 256.0f, &spanMinX, &spanMaxX)) continue;
+
+    int firstCol = (int)floorf(spanMinX / 256.0f);
+    int lastCol = (int)ceilf(spanMaxX / 256.0f) - 1;
+    for (int col = firstCol; col <= lastCol; col++) {
+      if (tileCount >= MAX_VISIBLE_TILES) {
+        Serial.printf("ERROR: More than %d visible tiles, dropping %d/%d\n",
+                      MAX_VISIBLE_TILES, originTileX + col, originTileY + row);
+        continue;
+      }
+      tilesToRender[tileCount].tileX = originTileX + col;
+      tilesToRender[tileCount].tileY = originTileY + row;
+      tilesToRender[tileCount].screenX = originScreenX + col * 256;
+      tilesToRender[tileCount].screenY = originScreenY + row * 256;
+      tileCount++;
     }
   }
-
-  return false;
 }
 
 void calculateVisibleTiles(double lat, double lon, int zoom) {
-  tileCount = 0;
-
   int centerTileX, centerTileY;
   double centerPixelX, centerPixelY;
   getTileCoordinates(lat, lon, zoom, &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
@@ -300,38 +463,91 @@ void calculateVisibleTiles(double lat, double lon, int zoom) {
   int centerTileScreenX = CENTER_X - (int)centerPixelX;
   int centerTileScreenY = currentCenterY - (int)centerPixelY;
 
-  // Determine search range based on rotation
-  int searchRange;
-  if (mapRotation == 0) {
-    searchRange = 2;  // 5x5 grid for non-rotated (we'll filter with visibility check)
-  } else {
-    // For rotated maps, we need a bit larger search space
-    searchRange = 3;  // 7x7 grid (we'll filter with visibility check)
+  collectVisibleTiles(centerTileX, centerTileY, centerTileScreenX, centerTileScreenY);
+
+#if BIKENAV_DEBUG_COMMANDS
+  Serial.printf("Rotation: %d° - Loading %d tiles\n", mapRotation, tileCount);
+#endif
+}
+
+/**
+ * Read a tile file from SD card into the PSRAM cache.
+ * Returns the cached tile data, or nullptr if the tile is missing/invalid
+ * or the cache is not available. Shared by the renderer and the prefetcher.
+ */
+uint8_t* loadTileIntoCache(int zoom, int tileX, int tileY) {
+  if (!isTileCacheReady()) return nullptr;
+
+  // Never-downloaded tiles are answered from the presence filter, no SD walk
+  if (!tilePresenceMayExist(zoom, tileX, tileY)) return nullptr;
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+
+  // Build file path: /Map/{zoom}/{tileX}/{tileY}.bin
+  char tilePath[64];
+  sprintf(tilePath, "/Map/%d/%d/%d.bin", zoom, tileX, tileY);
+
+  if (!SD.exists(tilePath)) {
+    tilePresenceNoteMiss();
+    return nullptr;
   }
 
-  // Check each tile in the search range
-  for (int dy = -searchRange; dy <= searchRange; dy++) {
-    for (int dx = -searchRange; dx <= searchRange; dx++) {
-      int tileX = centerTileX + dx;
-      int tileY = centerTileY + dy;
-
-      int screenX = centerTileScreenX + (dx * 256);
-      int screenY = centerTileScreenY + (dy * 256);
-
-      // Check if this tile will be visible after rotation
-      if (isTileVisible(screenX, screenY, mapRotation)) {
-        if (tileCount < 25) {
-          tilesToRender[tileCount].tileX = tileX;
-          tilesToRender[tileCount].tileY = tileY;
-          tilesToRender[tileCount].screenX = screenX;
-          tilesToRender[tileCount].screenY = screenY;
-          tileCount++;
-        }
-      }
+  File file = SD.open(tilePath, FILE_READ);
+  if (!file) {
+    return nullptr;
+  }
+
+  // File should be exactly 8192 bytes (256x256 pixels / 8 bits per byte)
+  if (file.size() != 8192) {
+    file.close();
+    return nullptr;
+  }
+
+  // Get a cache buffer to read into, then hand it to the cache for compression
+  uint8_t* tileData = tileCacheInsert(zoom, tileX, tileY);
+  if (tileData) {
+    if (file.read(tileData, 8192) == 8192) {
+      tileCacheCommit(tileData);
+    } else {
+      tileData = nullptr;
     }
   }
+  file.close();
+  return tileData;
+}
 
-  Serial.printf("Rotation: %d° - Loading %d tiles\n", mapRotation, tileCount);
+// Tile rows [*firstRow, *lastRow) that land inside the map area when unrotated
+static bool getVisibleTileRows(int screenY, int* firstRow, int* lastRow) {
+  *firstRow = screenY < 0 ? -screenY : 0;
+  *lastRow = MAP_DISPLAY_HEIGHT - screenY < 256 ? MAP_DISPLAY_HEIGHT - screenY : 256;
+  return *firstRow < *lastRow;
+}
+
+/**
+ * North-up fast path: clip the tile to the map area in source space and
+ * blit the visible rows straight into the framebuffer. Returns the screen
+ * pixels covered.
+ */
+static int renderTileRowsDirect(const uint8_t* tileData, int screenX, int screenY) {
+  int firstRow, lastRow;
+  if (screenX >= DISPLAY_WIDTH || screenX + 256 <= 0) return 0;
+  if (!getVisibleTileRows(screenY, &firstRow, &lastRow)) return 0;
+
+  for (int y = firstRow; y < lastRow; y++) {
+    displayBlitRow(tileData + y * 32, 32, screenX, screenY + y, radarMapLightenEnabled ? (y & 1) : -1);
+  }
+
+  int left = screenX > 0 ? screenX : 0;
+  int right = screenX + 256 < DISPLAY_WIDTH ? screenX + 256 : DISPLAY_WIDTH;
+  return (lastRow - firstRow) * (right - left);
+}
+
+// Draw a tile held in memory: row blits when unrotated, resampling otherwise.
+// Returns the screen pixels covered.
+static int renderCachedTile(const uint8_t* tileData, int screenX, int screenY) {
+  if (mapRotation == 0 && isDisplayBufferDirect()) {
+    return renderTileRowsDirect(tileData, screenX, screenY);
+  }
+  return renderTileRotated(tileData, screenX, screenY);
 }
 
 /**
@@ -339,8 +555,9 @@ void calculateVisibleTiles(double lat, double lon, int zoom) {
  * Tile format: 256x256 pixels, 1 bit per pixel, packed (8KB total)
  * Uses PSRAM cache for fast access on repeated renders
  */
-bool loadAndRenderTile(int tileX, int tileY, int zoom, int screenX, int screenY) {
+static bool loadAndRenderTileLocked(int tileX, int tileY, int zoom, int screenX, int screenY) {
   uint8_t* tileData = nullptr;
+  bool directBlit = mapRotation == 0 && isDisplayBufferDirect();
   bool fromCache = false;
 
   // STEP 1: Try to get tile from PSRAM cache
@@ -348,193 +565,187 @@ bool loadAndRenderTile(int tileX, int tileY, int zoom, int screenX, int screenY)
   if (tileData) {
     // Cache HIT! Use cached data
     fromCache = true;
+  } else if (isTileCacheReady()) {
+    // Cache MISS - read tile from SD card into the cache
+    tileData = loadTileIntoCache(zoom, tileX, tileY);
+    if (!tileData) {
+      // Tile not on SD card - can't render
+      return false;
+    }
+    fromCache = false; // Just loaded, not from existing cache
   } else {
-    // Cache MISS - need to load from SD card
+    // Cache not available - fall back to line-by-line rendering (slower)
+    if (!tilePresenceMayExist(zoom, tileX, tileY)) return false;
+    SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+
     // Build file path: /Map/{zoom}/{tileX}/{tileY}.bin
     char tilePath[64];
     sprintf(tilePath, "/Map/%d/%d/%d.bin", zoom, tileX, tileY);
 
     if (!SD.exists(tilePath)) {
-      // Tile not on SD card - can't render
       return false;
     }
 
     File file = SD.open(tilePath, FILE_READ);
-    if (!file) {
-      return false;
-    }
-
-    // File should be exactly 8192 bytes (256x256 pixels / 8 bits per byte)
+    if (!file) return false;
     if (file.size() != 8192) {
       file.close();
       return false;
     }
 
-    // Get a cache slot to write into (may evict LRU tile)
-    tileData = tileCacheInsert(zoom, tileX, tileY);
-    if (tileData) {
-      // Read entire tile into cache
-      file.read(tileData, 8192);
-      fromCache = false; // Just loaded, not from existing cache
-    } else {
-      // Cache not available - fall back to line-by-line rendering (slower)
-      file.close();
+    uint8_t lineBuffer[32];
 
-      // Fallback: render directly from SD without cache
-      file = SD.open(tilePath, FILE_READ);
-      if (!file) return false;
-
-      float rotationRad = mapRotation * M_PI / 180.0;
-      float cosAngle = cos(rotationRad);
-      float sinAngle = sin(rotationRad);
-      uint8_t lineBuffer[32];
-
-      for (int y = 0; y < 256; y++) {
-        file.read(lineBuffer, 32);
-        for (int x = 0; x < 256; x++) {
-          uint8_t byteVal = lineBuffer[x / 8];
-          uint8_t bitIndex = 7 - (x % 8);
-          bool isWhite = (byteVal >> bitIndex) & 1;
-          if (isWhite) continue;
-          if (radarMapLightenEnabled && ((x + y) & 1)) continue;
-
-          int screenX_original = screenX + x;
-          int screenY_original = screenY + y;
-          int screenX_final = screenX_original;
-          int screenY_final = screenY_original;
-
-          if (mapRotation != 0) {
-            float relX = screenX_original - CENTER_X;
-            float relY = screenY_original - currentCenterY;
-            float rotatedX = relX * cosAngle - relY * sinAngle;
-            float rotatedY = relX * sinAngle + relY * cosAngle;
-            screenX_final = (int)(rotatedX + CENTER_X + 0.5);
-            screenY_final = (int)(rotatedY + currentCenterY + 0.5);
-          }
-
-          if (screenX_final >= 0 && screenX_final < DISPLAY_WIDTH &&
-              screenY_final >= 0 && screenY_final < MAP_DISPLAY_HEIGHT) {
-            display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
-          }
+    if (directBlit) {
+      // Only read the rows that are on screen
+      int firstRow, lastRow;
+      if (screenX < DISPLAY_WIDTH && screenX + 256 > 0 && getVisibleTileRows(screenY, &firstRow, &lastRow)) {
+        file.seek(firstRow * 32);
+        for (int y = firstRow; y < lastRow; y++) {
+          if (file.read(lineBuffer, 32) != 32) break;
+          displayBlitRow(lineBuffer, 32, screenX, screenY + y, radarMapLightenEnabled ? (y & 1) : -1);
         }
+        tilesDrawnThisFrame++;
       }
       file.close();
       return true;
     }
 
+    float rotationRad = mapRotation * M_PI / 180.0;
+    float cosAngle = cos(rotationRad);
+    float sinAngle = sin(rotationRad);
+    bool drewPixels = false;
+
+    for (int y = 0; y < 256; y++) {
+      file.read(lineBuffer, 32);
+      for (int x = 0; x < 256; x++) {
+        uint8_t byteVal = lineBuffer[x / 8];
+        uint8_t bitIndex = 7 - (x % 8);
+        bool isWhite = (byteVal >> bitIndex) & 1;
+        if (isWhite) continue;
+        if (radarMapLightenEnabled && ((x + y) & 1)) continue;
+
+        int screenX_original = screenX + x;
+        int screenY_original = screenY + y;
+        int screenX_final = screenX_original;
+        int screenY_final = screenY_original;
+
+        if (mapRotation != 0) {
+          float relX = screenX_original - CENTER_X;
+          float relY = screenY_original - currentCenterY;
+          float rotatedX = relX * cosAngle - relY * sinAngle;
+          float rotatedY = relX * sinAngle + relY * cosAngle;
+          screenX_final = (int)(rotatedX + CENTER_X + 0.5);
+          screenY_final = (int)(rotatedY + currentCenterY + 0.5);
+        }
+
+        if (screenX_final >= 0 && screenX_final < DISPLAY_WIDTH &&
+            screenY_final >= 0 && screenY_final < MAP_DISPLAY_HEIGHT) {
+          display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
+          drewPixels = true;
+        }
+      }
+    }
+    if (drewPixels) tilesDrawnThisFrame++;
     file.close();
+    return true;
   }
 
   // STEP 2: Render tile from memory (cache)
   // This is MUCH faster than reading from SD card!
+  if (renderCachedTile(tileData, screenX, screenY) > 0) tilesDrawnThisFrame++;
+  return true;
+}
 
-  // Pre-calculate rotation parameters
-  float rotationRad = mapRotation * M_PI / 180.0;
-  float cosAngle = cos(rotationRad);
-  float sinAngle = sin(rotationRad);
-
-  // Render from cached tile data
-  for (int y = 0; y < 256; y++) {
-    // Calculate byte offset for this line (32 bytes per line)
-    int lineOffset = y * 32;
-
-    for (int x = 0; x < 256; x++) {
-      // Extract bit (1 = white, 0 = black)
-      int byteIndex = lineOffset + (x / 8);
-      uint8_t byteVal = tileData[byteIndex];
-      uint8_t bitIndex = 7 - (x % 8);
-      bool isWhite = (byteVal >> bitIndex) & 1;
-
-      // Skip white pixels (background)
-      if (isWhite) {
-        continue;
-      }
-      if (radarMapLightenEnabled && ((x + y) & 1)) {
-        continue;
-      }
-
-      // Calculate original screen position (before rotation)
-      int screenX_original = screenX + x;
-      int screenY_original = screenY + y;
-
-      int screenX_final = screenX_original;
-      int screenY_final = screenY_original;
-
-      // Apply rotation around center point (CENTER_X, currentCenterY)
-      if (mapRotation != 0) {
-        // Translate to origin (relative to center point)
-        float relX = screenX_original - CENTER_X;
-        float relY = screenY_original - currentCenterY;
-
-        // Apply rotation
-        float rotatedX = relX * cosAngle - relY * sinAngle;
-        float rotatedY = relX * sinAngle + relY * cosAngle;
-
-        // Translate back
-        screenX_final = (int)(rotatedX + CENTER_X + 0.5);
-        screenY_final = (int)(rotatedY + currentCenterY + 0.5);
-      }
-
-      // Skip if outside display area
-      if (screenX_final < 0 || screenX_final >= DISPLAY_WIDTH ||
-          screenY_final < 0 || screenY_final >= MAP_DISPLAY_HEIGHT) {
-        continue;
-      }
-
-      // Draw pixel
-      display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
-    }
-  }
+// Holds the tile cache lock while the cached tile is drawn
+bool loadAndRenderTile(int tileX, int tileY, int zoom, int screenX, int screenY) {
+  tileCacheLock();
+  bool rendered = loadAndRenderTileLocked(tileX, tileY, zoom, screenX, screenY);
+  tileCacheUnlock();
+  return rendered;
+}
 
-  return true;
+// True when drawRadarOverlay() lightens the map itself (word-wise), so
+// tiles should render without the per-pixel radarMapLightenEnabled test
+bool isRadarCompositorDirect() {
+  return mapRotation == 0 && isDisplayBufferDirect();
 }
 
 /**
  * Draw radar overlay on top of map tiles (if enabled).
- * Uses same rotation as map tiles to stay aligned.
+ * Radar frame row y covers screen row y + (currentCenterY - DISPLAY_HEIGHT / 2).
+ * Unrotated with a direct framebuffer, rows are composed word-wise: the map
+ * is lightened with a checkerboard (lightenPhase >= 0, matching the tile
+ * pixel parity) and the radar frame ANDed in. Rotated views map every
+ * screen pixel back into the frame, same as the map resampling.
  */
-void drawRadarOverlay(const uint8_t* frameData) {
+void drawRadarOverlay(const uint8_t* frameData, int lightenPhase) {
   if (!radarOverlayEnabled || radarHasError || frameData == nullptr) return;
 
   const int bytesPerRow = RADAR_IMAGE_WIDTH / 8;
   int yOffset = currentCenterY - (DISPLAY_HEIGHT / 2);
 
-  float rotationRad = mapRotation * M_PI / 180.0;
-  float cosAngle = cos(rotationRad);
-  float sinAngle = sin(rotationRad);
-
-  for (int y = 0; y < RADAR_IMAGE_HEIGHT; y++) {
-    int screenY_original = y + yOffset;
-    int rowOffset = y * bytesPerRow;
-
-    for (int x = 0; x < RADAR_IMAGE_WIDTH; x++) {
-      int byteIndex = rowOffset + (x / 8);
-      uint8_t byteVal = frameData[byteIndex];
-      uint8_t bitIndex = 7 - (x % 8);
-      bool isWhite = (byteVal >> bitIndex) & 1;
-
-      if (isWhite) continue;
-
-      int screenX_original = x;
-      int screenX_final = screenX_original;
-      int screenY_final = screenY_original;
-
-      if (mapRotation != 0) {
-        float relX = screenX_original - CENTER_X;
-        float relY = screenY_original - currentCenterY;
-        float rotatedX = relX * cosAngle - relY * sinAngle;
-        float rotatedY = relX * sinAngle + relY * cosAngle;
-        screenX_final = (int)(rotatedX + CENTER_X + 0.5);
-        screenY_final = (int)(rotatedY + currentCenterY + 0.5);
-      }
+  if (isRadarCompositorDirect()) {
+    for (int y = 0; y < MAP_DISPLAY_HEIGHT; y++) {
+      int frameY = y - yOffset;
+      bool inFrame = frameY >= 0 && frameY < RADAR_IMAGE_HEIGHT;
+      displayComposeRow(y, inFrame ? frameData + frameY * bytesPerRow : nullptr, lightenPhase);
+    }
+    return;
+  }
 
-      if (screenX_final < 0 || screenX_final >= DISPLAY_WIDTH ||
-          screenY_final < 0 || screenY_final >= MAP_DISPLAY_HEIGHT) {
-        continue;
+  if (mapRotation == 0) {
+    for (int y = 0; y < MAP_DISPLAY_HEIGHT; y++) {
+      int frameY = y - yOffset;
+      if (frameY < 0 || frameY >= RADAR_IMAGE_HEIGHT) continue;
+      const uint8_t* frameRow = frameData + frameY * bytesPerRow;
+      for (int x = 0; x < RADAR_IMAGE_WIDTH; x++) {
+        if (frameRow[x >> 3] == 0xFF) {
+          x |= 7;  // Whole byte white
+          continue;
+        }
+        if ((frameRow[x >> 3] >> (7 - (x & 7))) & 1) continue;
+        display.drawPixel(x, y, GxEPD_BLACK);
       }
+    }
+    return;
+  }
 
-      display.drawPixel(screenX_final, screenY_final, GxEPD_BLACK);
+  // Rotated: same inverse Q16 mapping as renderTileRotated()
+  const MapRotationSetup& r = getMapRotationSetup();
+  bool direct = isDisplayBufferDirect();
+  uint8_t rowMask[DISPLAY_BUFFER_ROW_BYTES];
+  int32_t frameLimitU = (int32_t)RADAR_IMAGE_WIDTH * 65536;
+  int32_t frameLimitV = (int32_t)RADAR_IMAGE_HEIGHT * 65536;
+
+  for (int y = 0; y < MAP_DISPLAY_HEIGHT; y++) {
+    int32_t u = r.originU + y * r.rowDU;
+    int32_t v = r.originV + y * r.rowDV - yOffset * 65536;  // Frame row = screen row - yOffset
+
+    int x = 0;
+    int xEnd = DISPLAY_WIDTH;
+    clipSpanQ16(u, r.colDU, frameLimitU, &x, &xEnd);
+    clipSpanQ16(v, r.colDV, frameLimitV, &x, &xEnd);
+    if (x >= xEnd) continue;
+
+    u += x * r.colDU;
+    v += x * r.colDV;
+    bool anyBlack = false;
+    if (direct) memset(rowMask, 0, sizeof(rowMask));
+
+    for (; x < xEnd; x++, u += r.colDU, v += r.colDV) {
+      int fx = u >> 16;
+      int fy = v >> 16;
+      if ((frameData[fy * bytesPerRow + (fx >> 3)] >> (7 - (fx & 7))) & 1) continue;  // White
+
+      if (direct) {
+        rowMask[x >> 3] |= 0x80 >> (x & 7);
+        anyBlack = true;
+      } else {
+        display.drawPixel(x, y, GxEPD_BLACK);
+      }
     }
+
+    if (anyBlack) displayApplyRowMask(y, rowMask);
   }
 }
 
@@ -649,145 +860,367 @@ bool lineSegmentIntersectsRect(int x1, int y1, int x2, int y2,
   return false;
 }
 
+// --- THICK LINE RASTERIZER ---
+// A line of width w is the capsule of pixel centers within w/2 of the
+// segment (round caps, so consecutive segments get round joins). The
+// capsule is convex: every row is a single span, the hull of the spans of
+// the two end discs and of the rectangle between them.
+
+// Narrow [*lo, *hi] to the px where minV <= a * px + c <= maxV
+static inline void clipLinearSpan(float a, float c, float minV, float maxV, float* lo, float* hi) {
+  if (a == 0) {
+    if (c < minV || c > maxV) *lo = *hi + 1;  // Empty
+    return;
+  }
+  float p = (minV - c) / a;
+  float q = (maxV - c) / a;
+  if (p > q) { float t = p; p = q; q = t; }
+  if (p > *lo) *lo = p;
+  if (q < *hi) *hi = q;
+}
+
+/**
+ * Fill a lineWidth px thick segment with round caps, clipped to the rect
+ * [clipLeft, clipRight) x [clipTop, clipBottom). Spans go straight into the
+ * framebuffer when it is directly addressable, otherwise through
+ * drawFastHLine(). Returns false if nothing was drawn.
+ */
+bool drawThickLine(int x1, int y1, int x2, int y2, int lineWidth,
+                   int clipLeft, int clipTop, int clipRight, int clipBottom) {
+  float radius = lineWidth * 0.5f;
+  int top = (int)floorf(min(y1, y2) - radius);
+  int bottom = (int)ceilf(max(y1, y2) + radius);
+  if (top < clipTop) top = clipTop;
+  if (bottom > clipBottom - 1) bottom = clipBottom - 1;
+  if (top > bottom) return false;
+  if (max(x1, x2) + radius < clipLeft || min(x1, x2) - radius > clipRight - 1) return false;
+
+  float dx = x2 - x1;
+  float dy = y2 - y1;
+  float length2 = dx * dx + dy * dy;
+  float radiusLength = radius * sqrtf(length2);
+  float radius2 = radius * radius;
+  bool direct = isDisplayBufferDirect();
+  bool drawn = false;
+
+  for (int y = top; y <= bottom; y++) {
+    float left = 1e9f;
+    float right = -1e9f;
+
+    // End discs
+    float ry1 = y - y1;
+    if (ry1 * ry1 <= radius2) {
+      float h = sqrtf(radius2 - ry1 * ry1);
+      left = min(left, x1 - h);
+      right = max(right, x1 + h);
+    }
+    float ry2 = y - y2;
+    if (ry2 * ry2 <= radius2) {
+      float h = sqrtf(radius2 - ry2 * ry2);
+      left = min(left, x2 - h);
+      right = max(right, x2 + h);
+    }
+
+    // Body: 0 <= projection <= length2, |cross| <= radius * length (px = x - x1)
+    if (length2 > 0) {
+      float lo = -1e9f;
+      float hi = 1e9f;
+      clipLinearSpan(dx, ry1 * dy, 0, length2, &lo, &hi);
+      clipLinearSpan(dy, -ry1 * dx, -radiusLength, radiusLength, &lo, &hi);
+      if (lo <= hi) {
+        left = min(left, x1 + lo);
+        right = max(right, x1 + hi);
+      }
+    }
+
+    int spanStart = (int)ceilf(left);
+    int spanEnd = (int)floorf(right);
+    if (spanStart < clipLeft) spanStart = clipLeft;
+    if (spanEnd > clipRight - 1) spanEnd = clipRight - 1;
+    if (spanStart > spanEnd) continue;
+
+    if (direct) {
+      displayFillRowSpan(y, spanStart, spanEnd);
+    } else {
+      display.drawFastHLine(spanStart, y, spanEnd - spanStart + 1, GxEPD_BLACK);
+    }
+    drawn = true;
+  }
+  return drawn;
+}
+
+// Draw a route segment lineWidth px thick, clipped to a map area mapHeight
+// px tall. Returns false if the segment is entirely off screen.
+static bool drawRouteSegment(int x1, int y1, int x2, int y2, int lineWidth, int mapHeight) {
+  if (lineWidth == 1) {
+    if (!clipLineToRect(&x1, &y1, &x2, &y2, 0, 0, DISPLAY_WIDTH, mapHeight)) {
+      return false;
+    }
+    display.drawLine(x1, y1, x2, y2, GxEPD_BLACK);
+    return true;
+  }
+  return drawThickLine(x1, y1, x2, y2, lineWidth, 0, 0, DISPLAY_WIDTH, mapHeight);
+}
+
+struct RouteDrawStats {
+  int runCount;
+  int chunksVisited;
+  int segmentsDrawn;
+  int segmentsOffscreen;
+};
+
+/**
+ * Draw the kept segments of a projected route that touch the map view,
+ * lineWidth px thick.
+ */
+static void drawRouteGeometry(const RouteGeometry* geometry, const MapView& mapView,
+                              int lineWidth, RouteDrawStats* stats) {
+  // Points simplified to one pixel of error at this zoom
+  int level = getRouteLodLevel(mapView.zoom);
+  const int32_t* lodIndex = geometry->lodIndex[level];
+  int lodCount = geometry->lodCount[level];
+
+  RouteView view;
+  setupRouteView(&view, mapView.lat, mapView.lon, mapView.zoom, mapView.rotation, CENTER_X, mapView.centerY);
+
+  // Viewport bounding box in world space, grown by the brush and the
+  // simplification error (a kept segment stays within 1px of the track)
+  MapRotationSetup rotationSetup;
+  computeMapRotationSetup(mapView.rotation, mapView.centerY, &rotationSetup);
+  float px[4], py[4];
+  getUnrotatedViewportFor(rotationSetup, mapView.mapHeight, px, py);
+  float minU = px[0], maxU = px[0], minV = py[0], maxV = py[0];
+  for (int i = 1; i < 4; i++) {
+    if (px[i] < minU) minU = px[i];
+    if (px[i] > maxU) maxU = px[i];
+    if (py[i] < minV) minV = py[i];
+    if (py[i] > maxV) maxV = py[i];
+  }
+  RouteBox viewBox = getRouteViewBox(&view, mapView.zoom, minU, minV, maxU, maxV, lineWidth / 2 + 2);
+
+  // Only the track ranges whose chunks touch the viewport
+  RouteRun runs[ROUTE_MAX_RUNS];
+  stats->runCount = queryRouteRuns(geometry, viewBox, runs, &stats->chunksVisited);
+  stats->segmentsDrawn = 0;
+  stats->segmentsOffscreen = 0;
+  int nextSegment = 0;  // Kept segments before this one were already drawn
+
+  for (int r = 0; r < stats->runCount; r++) {
+    // Kept segments overlapping the run: from the last kept point at or
+    // before its start up to the first kept point at or after its end
+    int k = findRouteLodPosition(lodIndex, lodCount, runs[r].first);
+    if (k < nextSegment) k = nextSegment;
+    if (k >= lodCount - 1) continue;
+
+    int prevX, prevY;
+    routePointToScreen(&view, geometry->points[lodIndex[k]], &prevX, &prevY);
+
+    for (; k < lodCount - 1 && lodIndex[k] < runs[r].last; k++) {
+      int x, y;
+      routePointToScreen(&view, geometry->points[lodIndex[k + 1]], &x, &y);
+
+      if (drawRouteSegment(prevX, prevY, x, y, lineWidth, mapView.mapHeight)) {
+        stats->segmentsDrawn++;
+      } else {
+        stats->segmentsOffscreen++;
+      }
+      prevX = x;
+      prevY = y;
+    }
+    nextSegment = k;
+  }
+}
+
 /**
  * Draw navigation route on the map
- * Renders the GPX track with rotation applied
- * centerLat, centerLon: The map center coordinates (GPS position or scrubbed position)
+ * Renders the GPX track with the view's rotation applied
  */
-void drawNavigationRoute(double centerLat, double centerLon) {
+void drawNavigationRoute(const MapView& view) {
   // Check if we have a navigation track loaded
   if (navigationTrack == nullptr || navigationTrackPointCount < 2) {
     return;
   }
 
-  Serial.println("Drawing navigation route...");
+  // Track points projected once per track (integer world pixels)
+  RouteGeometry* geometry = getRouteGeometry(navigationTrack, navigationTrackPointCount);
+  if (!geometry) return;
+
+  // Get line width for the view's zoom level
+  int lineWidth = getRouteLineWidth(view.zoom);
+
+  RouteDrawStats stats;
+  drawRouteGeometry(geometry, view, lineWidth, &stats);
+
+#if BIKENAV_DEBUG_COMMANDS
+  Serial.printf("Route: %d px wide, %d segments (LOD level %d, total points=%d)\n",
+                lineWidth, geometry->lodCount[getRouteLodLevel(view.zoom)] - 1, getRouteLodLevel(view.zoom),
+                navigationTrackPointCount);
+  Serial.printf("Route index: %d ranges, %d/%d chunks visited\n",
+                stats.runCount, stats.chunksVisited, geometry->chunkCount);
+  Serial.printf("Route rendering complete: %d segments drawn, %d offscreen\n",
+                stats.segmentsDrawn, stats.segmentsOffscreen);
+#endif
+}
+
+// centerLat, centerLon: The map center coordinates (GPS position or scrubbed position)
+void drawNavigationRoute(double centerLat, double centerLon) {
+  drawNavigationRoute(getLiveMapView(centerLat, centerLon));
+}
 
-  // Get line width for current zoom level
-  int lineWidth = ROUTE_LINE_WIDTH[currentZoomIndex];
-  Serial.printf("Route line width: %d px (zoom level %d)\n", lineWidth, zoomLevel);
+#if BIKENAV_DEBUG_COMMANDS
+/**
+ * Debug: compare per-frame route projection on a synthetic 20,000 point
+ * (~300 km) track at zoom 16 - old per-segment getTileCoordinates() vs
+ * projected geometry (one-time build + integer transform per frame), and
+ * all points vs only the ranges the spatial index returns for the viewport.
+ */
+void benchmarkRouteProjection() {
+  const int BENCH_POINTS = 20000;
+  const int BENCH_ZOOM = 16;
+  TrackPoint* track = (TrackPoint*)ps_malloc(BENCH_POINTS * sizeof(TrackPoint));
+  if (!track) return;
+
+  // Random walk with ~15m steps heading north from the current position
+  double lat = gpsValid ? currentLat : 50.0;
+  double lon = gpsValid ? currentLon : 14.4;
+  for (int i = 0; i < BENCH_POINTS; i++) {
+    lat += (random(-100, 101)) * 1e-6 + 1.35e-4;
+    lon += (random(-100, 101)) * 1.5e-6;
+    track[i].lat = lat;
+    track[i].lon = lon;
+    track[i].elev = 0;
+  }
 
-  // Calculate downsampling step for performance
-  // Aim for MAX_ROUTE_SEGMENTS line segments maximum
-  int step = max(1, navigationTrackPointCount / MAX_ROUTE_SEGMENTS);
-  int segmentsToRender = navigationTrackPointCount / step;
-  Serial.printf("Rendering %d route segments (step=%d, total points=%d)\n",
-                segmentsToRender, step, navigationTrackPointCount);
+  Serial.println("=== ROUTE PROJECTION BENCHMARK ===");
 
-  // Get center tile coordinates (map center - GPS or scrubbed position)
+  // Old: two getTileCoordinates() per segment, every frame
   int centerTileX, centerTileY;
   double centerPixelX, centerPixelY;
-  getTileCoordinates(centerLat, centerLon, zoomLevel,
-                    &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
-
-  // Pre-calculate rotation parameters
-  float rotationRad = mapRotation * M_PI / 180.0;
-  float cosAngle = cos(rotationRad);
-  float sinAngle = sin(rotationRad);
-
-  int segmentsDrawn = 0;
-  int segmentsOffscreen = 0;
-
-  // Draw route segments
-  for (int i = 0; i < navigationTrackPointCount - step; i += step) {
-    // Get two consecutive points for this segment
-    double lat1 = navigationTrack[i].lat;
-    double lon1 = navigationTrack[i].lon;
-    double lat2 = navigationTrack[i + step].lat;
-    double lon2 = navigationTrack[i + step].lon;
-
-    // Convert point 1 to screen coordinates
-    int tile1X, tile1Y;
-    double pixel1X, pixel1Y;
-    getTileCoordinates(lat1, lon1, zoomLevel, &tile1X, &tile1Y, &pixel1X, &pixel1Y);
-
-    // Calculate screen position (non-rotated) - use double precision to avoid rounding errors
-    double screen1X_original = CENTER_X + (tile1X - centerTileX) * 256.0 + (pixel1X - centerPixelX);
-    double screen1Y_original = currentCenterY + (tile1Y - centerTileY) * 256.0 + (pixel1Y - centerPixelY);
-
-    // Convert point 2 to screen coordinates
-    int tile2X, tile2Y;
-    double pixel2X, pixel2Y;
-    getTileCoordinates(lat2, lon2, zoomLevel, &tile2X, &tile2Y, &pixel2X, &pixel2Y);
-
-    // Use double precision for accurate coordinate transformation
-    double screen2X_original = CENTER_X + (tile2X - centerTileX) * 256.0 + (pixel2X - centerPixelX);
-    double screen2Y_original = currentCenterY + (tile2Y - centerTileY) * 256.0 + (pixel2Y - centerPixelY);
-
-    // Apply rotation if needed
-    int screen1X_final, screen1Y_final, screen2X_final, screen2Y_final;
-
-    if (mapRotation != 0) {
-      // Rotate point 1 - use double precision for accuracy
-      double rel1X = screen1X_original - CENTER_X;
-      double rel1Y = screen1Y_original - currentCenterY;
-      double rotated1X = rel1X * cosAngle - rel1Y * sinAngle;
-      double rotated1Y = rel1X * sinAngle + rel1Y * cosAngle;
-      screen1X_final = (int)(rotated1X + CENTER_X + 0.5);
-      screen1Y_final = (int)(rotated1Y + currentCenterY + 0.5);
-
-      // Rotate point 2 - use double precision for accuracy
-      double rel2X = screen2X_original - CENTER_X;
-      double rel2Y = screen2Y_original - currentCenterY;
-      double rotated2X = rel2X * cosAngle - rel2Y * sinAngle;
-      double rotated2Y = rel2X * sinAngle + rel2Y * cosAngle;
-      screen2X_final = (int)(rotated2X + CENTER_X + 0.5);
-      screen2Y_final = (int)(rotated2Y + currentCenterY + 0.5);
-    } else {
-      // No rotation - round to nearest pixel
-      screen1X_final = (int)(screen1X_original + 0.5);
-      screen1Y_final = (int)(screen1Y_original + 0.5);
-      screen2X_final = (int)(screen2X_original + 0.5);
-      screen2Y_final = (int)(screen2Y_original + 0.5);
+  getTileCoordinates(track[0].lat, track[0].lon, BENCH_ZOOM, &centerTileX, &centerTileY, &centerPixelX, &centerPixelY);
+  unsigned long start = micros();
+  long checksum = 0;
+  for (int i = 0; i < BENCH_POINTS - 1; i++) {
+    for (int k = 0; k < 2; k++) {
+      int tileX, tileY;
+      double pixelX, pixelY;
+      getTileCoordinates(track[i + k].lat, track[i + k].lon, BENCH_ZOOM, &tileX, &tileY, &pixelX, &pixelY);
+      checksum += (int)(CENTER_X + (tileX - centerTileX) * 256.0 + (pixelX - centerPixelX));
     }
-
-    // Properly clip the line segment to the map display area to prevent drawing over info bar
-    // Use Cohen-Sutherland algorithm for accurate clipping
-    int clipped1X = screen1X_final;
-    int clipped1Y = screen1Y_final;
-    int clipped2X = screen2X_final;
-    int clipped2Y = screen2Y_final;
-
-    if (!clipLineToRect(&clipped1X, &clipped1Y, &clipped2X, &clipped2Y,
-                        0, 0, DISPLAY_WIDTH, MAP_DISPLAY_HEIGHT)) {
-      // Line is completely outside viewport - skip it
-      segmentsOffscreen++;
-      continue;
+  }
+  unsigned long oldUs = micros() - start;
+
+  // New: project once, then integer subtract + rotate per frame
+  RouteGeometry geometry = {};
+  start = micros();
+  bool built = buildRouteGeometry(&geometry, track, BENCH_POINTS);
+  unsigned long buildUs = micros() - start;
+  unsigned long frameUs = 0;
+  unsigned long indexedUs = 0;
+  int indexedPoints = 0;
+  if (built) {
+    RouteView view;
+    start = micros();
+    setupRouteView(&view, track[0].lat, track[0].lon, BENCH_ZOOM, 37, CENTER_X, currentCenterY);
+    for (int i = 0; i < BENCH_POINTS; i++) {
+      int x, y;
+      routePointToScreen(&view, geometry.points[i], &x, &y);
+      checksum += x;
+    }
+    frameUs = micros() - start;
+
+    // Indexed: viewport in the middle of the track, only its ranges
+    const TrackPoint& mid = track[BENCH_POINTS / 2];
+    start = micros();
+    setupRouteView(&view, mid.lat, mid.lon, BENCH_ZOOM, 37, CENTER_X, currentCenterY);
+    float px[4], py[4];
+    getUnrotatedViewport(px, py);
+    float minU = px[0], maxU = px[0], minV = py[0], maxV = py[0];
+    for (int i = 1; i < 4; i++) {
+      minU = min(minU, px[i]);
+      maxU = max(maxU, px[i]);
+      minV = min(minV, py[i]);
+      maxV = max(maxV, py[i]);
+    }
+    RouteBox viewBox = getRouteViewBox(&view, BENCH_ZOOM, minU, minV, maxU, maxV, 2);
+    RouteRun runs[ROUTE_MAX_RUNS];
+    int chunksVisited;
+    int runCount = queryRouteRuns(&geometry, viewBox, runs, &chunksVisited);
+    for (int r = 0; r < runCount; r++) {
+      for (int i = runs[r].first; i <= runs[r].last; i++) {
+        int x, y;
+        routePointToScreen(&view, geometry.points[i], &x, &y);
+        checksum += x;
+        indexedPoints++;
+      }
     }
+    indexedUs = micros() - start;
+  }
 
-    // Draw line with configured thickness
-    // For lineWidth=1: draw single line
-    // For lineWidth>1: draw with filled circle brush at each point
-    if (lineWidth == 1) {
-      display.drawLine(clipped1X, clipped1Y, clipped2X, clipped2Y, GxEPD_BLACK);
-    } else {
-      // Draw the main line first
-      display.drawLine(clipped1X, clipped1Y, clipped2X, clipped2Y, GxEPD_BLACK);
-
-      // Add thickness by drawing offset lines in a cross pattern
-      int halfWidth = lineWidth / 2;
-      for (int offset = 1; offset <= halfWidth; offset++) {
-        // Draw offset lines in 4 directions for better coverage at all angles
-        display.drawLine(clipped1X - offset, clipped1Y, clipped2X - offset, clipped2Y, GxEPD_BLACK);
-        display.drawLine(clipped1X + offset, clipped1Y, clipped2X + offset, clipped2Y, GxEPD_BLACK);
-        display.drawLine(clipped1X, clipped1Y - offset, clipped2X, clipped2Y - offset, GxEPD_BLACK);
-        display.drawLine(clipped1X, clipped1Y + offset, clipped2X, clipped2Y + offset, GxEPD_BLACK);
-
-        // Add diagonal offsets for even better coverage at 45-degree angles
+  Serial.printf("%d points, z%d: old %lu us/frame, projected %lu us/frame (+%lu us once per track) [%ld]\n",
+                BENCH_POINTS, BENCH_ZOOM, oldUs, frameUs, buildUs, checksum & 1);
+  Serial.printf("Indexed viewport: %d points in view ranges, %lu us/frame\n", indexedPoints, indexedUs);
+  Serial.println("==================================");
+
+  freeRouteGeometry(&geometry);
+  free(track);
+}
+
+/**
+ * Debug: time route segments drawn by the capsule rasterizer against the
+ * previous main line + 4 axis + 4 diagonal offset drawLine() calls, at the
+ * ROUTE_LINE_WIDTH values in use. Scribbles over the framebuffer - redraw
+ * the page afterwards.
+ */
+void benchmarkThickLines() {
+  const int BENCH_SEGMENTS = 500;
+  const int widths[] = {2, 3, 4, 6};
+  int coords[BENCH_SEGMENTS][4];
+  for (int i = 0; i < BENCH_SEGMENTS; i++) {
+    coords[i][0] = random(-20, DISPLAY_WIDTH + 20);
+    coords[i][1] = random(-20, MAP_DISPLAY_HEIGHT + 20);
+    coords[i][2] = coords[i][0] + random(-40, 41);
+    coords[i][3] = coords[i][1] + random(-40, 41);
+  }
+
+  Serial.println("=== THICK LINE BENCHMARK ===");
+  for (int w = 0; w < 4; w++) {
+    int lineWidth = widths[w];
+
+    display.fillScreen(GxEPD_WHITE);
+    unsigned long start = micros();
+    for (int i = 0; i < BENCH_SEGMENTS; i++) {
+      int x1 = coords[i][0], y1 = coords[i][1], x2 = coords[i][2], y2 = coords[i][3];
+      if (!clipLineToRect(&x1, &y1, &x2, &y2, 0, 0, DISPLAY_WIDTH, MAP_DISPLAY_HEIGHT)) continue;
+      display.drawLine(x1, y1, x2, y2, GxEPD_BLACK);
+      for (int offset = 1; offset <= lineWidth / 2; offset++) {
+        display.drawLine(x1 - offset, y1, x2 - offset, y2, GxEPD_BLACK);
+        display.drawLine(x1 + offset, y1, x2 + offset, y2, GxEPD_BLACK);
+        display.drawLine(x1, y1 - offset, x2, y2 - offset, GxEPD_BLACK);
+        display.drawLine(x1, y1 + offset, x2, y2 + offset, GxEPD_BLACK);
         if (offset == 1) {
-          display.drawLine(clipped1X - offset, clipped1Y - offset, clipped2X - offset, clipped2Y - offset, GxEPD_BLACK);
-          display.drawLine(clipped1X + offset, clipped1Y - offset, clipped2X + offset, clipped2Y - offset, GxEPD_BLACK);
-          display.drawLine(clipped1X - offset, clipped1Y + offset, clipped2X - offset, clipped2Y + offset, GxEPD_BLACK);
-          display.drawLine(clipped1X + offset, clipped1Y + offset, clipped2X + offset, clipped2Y + offset, GxEPD_BLACK);
+          display.drawLine(x1 - 1, y1 - 1, x2 - 1, y2 - 1, GxEPD_BLACK);
+          display.drawLine(x1 + 1, y1 - 1, x2 + 1, y2 - 1, GxEPD_BLACK);
+          display.drawLine(x1 - 1, y1 + 1, x2 - 1, y2 + 1, GxEPD_BLACK);
+          display.drawLine(x1 + 1, y1 + 1, x2 + 1, y2 + 1, GxEPD_BLACK);
         }
       }
     }
+    unsigned long offsetLinesUs = micros() - start;
 
-    segmentsDrawn++;
-  }
+    display.fillScreen(GxEPD_WHITE);
+    start = micros();
+    for (int i = 0; i < BENCH_SEGMENTS; i++) {
+      drawRouteSegment(coords[i][0], coords[i][1], coords[i][2], coords[i][3], lineWidth, MAP_DISPLAY_HEIGHT);
+    }
+    unsigned long capsuleUs = micros() - start;
 
-  Serial.printf("Route rendering complete: %d segments drawn, %d offscreen\n",
-                segmentsDrawn, segmentsOffscreen);
+    Serial.printf("Width %d: offset lines %lu us, capsules %lu us (%d segments)\n",
+                  lineWidth, offsetLinesUs, capsuleUs, BENCH_SEGMENTS);
+  }
+  display.fillScreen(GxEPD_WHITE);
+  Serial.println("============================");
 }
+#endif // BIKENAV_DEBUG_COMMANDS
 
 void updateMapInfoBar() {
   // Use navigation info bar if navigation is active
@@ -952,9 +1385,7 @@ void updateNavigationInfoBar() {
     }
 
     // Draw distance next to turn icon (larger font)
-    u8g2_display.setFont(u8g2_font_helvB14_tf);
-    u8g2_display.setCursor(2 + TURN_ICON_SIZE + 4, line1Y + 16);  // Adjusted to fit better
-    u8g2_display.print(distStr);
+    drawGlyphText(GLYPH_FONT_HELVB14, 2 + TURN_ICON_SIZE + 4, line1Y + 16, distStr);  // Adjusted to fit better
   }
 
   // Draw mode icon and value on the right (to avoid interfering with turn distance)
@@ -977,8 +1408,7 @@ void updateNavigationInfoBar() {
     }
   }
 
-  u8g2_display.setFont(u8g2_font_helvB08_tf);
-  int modeTextWidth = u8g2_display.getUTF8Width(modeStr);
+  int modeTextWidth = glyphTextWidth(GLYPH_FONT_HELVB08, modeStr);
 
   // Position icon on the right side with padding
   int modeIconX = DISPLAY_WIDTH - SMALL_ICON_SIZE - 4;  // 4px padding from right edge
@@ -986,8 +1416,7 @@ void updateNavigationInfoBar() {
 
   // Position text below the icon, right-aligned
   int modeTextX = DISPLAY_WIDTH - modeTextWidth - 4;  // 4px padding from right edge
-  u8g2_display.setCursor(modeTextX, line1Y + SMALL_ICON_SIZE + 11);
-  u8g2_display.print(modeStr);
+  drawGlyphText(GLYPH_FONT_HELVB08, modeTextX, line1Y + SMALL_ICON_SIZE + 11, modeStr);
 
   // --- LINE 2: Battery icon (left) and Time (right) - matching centralized status bar ---
   // Calculate baseline Y position (matching centralized status bar)
@@ -1001,11 +1430,7 @@ void updateNavigationInfoBar() {
 
   char percentStr[6];
   snprintf(percentStr, sizeof(percentStr), "%.0f%%", batteryPercent);
-  u8g2_display.setFont(u8g2_font_helvB08_tf);
-  u8g2_display.setCursor(23, textY);
-  u8g2_display.print(percentStr);
-
-  int percentWidth = u8g2_display.getUTF8Width(percentStr);
+  int percentWidth = drawGlyphText(GLYPH_FONT_HELVB08, 23, textY, percentStr);
   int iconsStartX = 23 + percentWidth + 3;
   int statusIconY = textY - 11;  // Icons aligned to baseline
 
@@ -1028,10 +1453,9 @@ void updateNavigationInfoBar() {
     snprintf(timeStr, sizeof(timeStr), "--:--");
   }
 
-  int timeTextWidth = u8g2_display.getUTF8Width(timeStr);
+  int timeTextWidth = glyphTextWidth(GLYPH_FONT_HELVB08, timeStr);
   int timeX = DISPLAY_WIDTH - timeTextWidth - 1;  // 1px margin from right edge (matching centralized status bar)
-  u8g2_display.setCursor(timeX, textY);
-  u8g2_display.print(timeStr);
+  drawGlyphText(GLYPH_FONT_HELVB08, timeX, textY, timeStr);
 }
 
 // Refresh just the info bar (for mode changes)
@@ -1047,96 +1471,163 @@ void refreshMapInfoBar() {
     if (navigationActive) {
       drawPageDots();
     }
-  } while (display.nextPage());
+  } while (nextDisplayPage());
+  invalidatePanelShadowRows(MAP_DISPLAY_HEIGHT, currentInfoBarHeight);
 }
 
-void loadAndDisplayMap() {
-  Serial.println("Loading map tiles from SD card...");
+// --- INPUT-TO-REFRESH LATENCY ---
+// Time from the input that made the map stale (encoder step, GPS fix) to the
+// end of the panel refresh showing it, and how long loop() was blocked for
+// that frame. Kept apart for synchronous and render task frames.
+struct MapLatencyStats {
+  unsigned long frames;
+  unsigned long blockedTotalUs;
+  unsigned long blockedMaxUs;
+  unsigned long inputs;          // Frames that answered an input
+  unsigned long latencyTotalUs;
+  unsigned long latencyMaxUs;
+};
 
-  // Use scrubbed position if scrub offset is active, otherwise use GPS position
-  // Scrub offset persists across all modes (ZOOM, ROTATION, SCRUB)
-  double centerLat = currentLat;
-  double centerLon = currentLon;
-  if (scrubOffsetMeters != 0 && navigationActive) {
-    centerLat = scrubLat;
-    centerLon = scrubLon;
+MapLatencyStats mapLatencySync = {0, 0, 0, 0, 0, 0};
+MapLatencyStats mapLatencyTask = {0, 0, 0, 0, 0, 0};
+unsigned long mapInputMicros = 0;  // Oldest input not on screen yet, 0 = none
+
+// The live view changed; keeps the oldest input not yet handed to a frame
+void noteMapInput() {
+  if (mapInputMicros == 0) mapInputMicros = micros() | 1;
+}
+
+// Input the next frame answers (0 = none)
+unsigned long takeMapInput() {
+  unsigned long input = mapInputMicros;
+  mapInputMicros = 0;
+  return input;
+}
+
+void recordMapLatency(MapLatencyStats& stats, const char* path, unsigned long inputMicros, unsigned long blockedUs) {
+  stats.frames++;
+  stats.blockedTotalUs += blockedUs;
+  if (blockedUs > stats.blockedMaxUs) stats.blockedMaxUs = blockedUs;
+  if (inputMicros == 0) {
+    Serial.printf("[RENDER] %s frame: loop blocked %lu ms\n", path, blockedUs / 1000);
+    return;
+  }
+
+  unsigned long latencyUs = micros() - inputMicros;
+  stats.inputs++;
+  stats.latencyTotalUs += latencyUs;
+  if (latencyUs > stats.latencyMaxUs) stats.latencyMaxUs = latencyUs;
+  Serial.printf("[RENDER] %s frame: input->refresh %lu ms, loop blocked %lu ms\n",
+                path, latencyUs / 1000, blockedUs / 1000);
+}
+
+void printMapLatencyStats(const char* path, const MapLatencyStats& stats) {
+  if (stats.frames == 0) return;
+  Serial.printf("[RENDER] %s: %lu frames, input->refresh avg %lu ms max %lu ms (%lu inputs), loop blocked avg %lu ms max %lu ms\n",
+                path, stats.frames,
+                stats.inputs ? stats.latencyTotalUs / stats.inputs / 1000 : 0, stats.latencyMaxUs / 1000, stats.inputs,
+                stats.blockedTotalUs / stats.frames / 1000, stats.blockedMaxUs / 1000);
+}
+
+// External layer compositing from map_layers.h
+extern void captureMapBaseLayer(const MapView& view);
+extern void drawMapBandLayers();
+
+// Route and position marker of the view, info bar and overlays on top of the map area
+void drawMapForeground(const MapView& view) {
+  // Radar overlay rendering is handled only on the radar page.
+
+  // Draw navigation route on top of tiles (if navigation is active)
+  if (navigationActive && navigationTrack != nullptr) {
+    drawNavigationRoute(view);
   }
 
+  int centerY = view.centerY;
+
+  // Draw location marker or navigation arrow on top
+  // When scrubbed (offset != 0), draw crosshair marker regardless of mode
+  if (navigationActive) {
+    if (scrubOffsetMeters != 0) {
+      // Draw scrub position marker (crosshair + ring for high visibility)
+      // Outer ring
+      display.drawCircle(CENTER_X, centerY, 8, GxEPD_BLACK);
+      display.drawCircle(CENTER_X, centerY, 7, GxEPD_BLACK);
+      // Inner dot
+      display.fillCircle(CENTER_X, centerY, 2, GxEPD_BLACK);
+      // Crosshair lines
+      display.drawLine(CENTER_X - 12, centerY, CENTER_X - 10, centerY, GxEPD_BLACK);
+      display.drawLine(CENTER_X + 10, centerY, CENTER_X + 12, centerY, GxEPD_BLACK);
+      display.drawLine(CENTER_X, centerY - 12, CENTER_X, centerY - 10, GxEPD_BLACK);
+      display.drawLine(CENTER_X, centerY + 10, CENTER_X, centerY + 12, GxEPD_BLACK);
+    } else {
+      // Normal navigation arrow at GPS position
+      drawNavigationArrow(CENTER_X, centerY, display);
+    }
+  } else {
+    drawLocationMarker(CENTER_X, centerY, display);
+  }
+
+  // Tiles, route and marker are the base layer of this view; info bar, page
+  // dots, speed overlay and notification are bands composited on top
+  captureMapBaseLayer(view);
+  drawMapBandLayers();
+}
+
+void loadAndDisplayMap() {
+  // Use scrubbed position if scrub offset is active, otherwise use GPS position
+  double centerLat, centerLon;
+  getMapViewCenter(&centerLat, &centerLon);
+
+  // Tiles around the rider during navigation are route corridor; scrubbing or
+  // plain map browsing must not push them out of the cache
+  bool routeView = navigationActive && scrubOffsetMeters == 0;
+  unsigned long inputMicros = takeMapInput();
+
+  // Compose the map area on the render task; pollMapRenderTask() flushes it
+  if (requestMapRender(centerLat, centerLon, routeView, inputMicros)) return;
+
+  unsigned long start = micros();
+
   calculateVisibleTiles(centerLat, centerLon, zoomLevel);
+  TileCacheClass previousClass = setTileCacheAccessClass(routeView ? TILE_CLASS_ROUTE : TILE_CLASS_BROWSE);
 
   // Start display update - ONE e-ink refresh for ALL tiles
   display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
-  display.firstPage();
+  display.firstPage();  // Single full-screen page, pushed by flushDisplayDiff()
 
-  do {
-    display.fillScreen(GxEPD_WHITE);
-    radarMapLightenEnabled = false;
+  display.fillScreen(GxEPD_WHITE);
+  radarMapLightenEnabled = false;
 
-    // Load and render ALL tiles from SD card
+  // Draw through the persistent map canvas; without it, render ALL tiles directly
+  if (!renderMapFromCanvas(centerLat, centerLon, zoomLevel)) {
     for (int i = 0; i < tileCount; i++) {
       int tileX = tilesToRender[i].tileX;
       int tileY = tilesToRender[i].tileY;
       int screenX = tilesToRender[i].screenX;
       int screenY = tilesToRender[i].screenY;
 
-      Serial.printf("Tile %d/%d: x=%d y=%d z=%d\n",
-                    i+1, tileCount, tileX, tileY, zoomLevel);
-
-      if (!loadAndRenderTile(tileX, tileY, zoomLevel, screenX, screenY)) {
-        Serial.println("Tile not found on SD card");
-      }
-    }
-
-    // Radar overlay rendering is handled only on the radar page.
-
-    // Draw navigation route on top of tiles (if navigation is active)
-    if (navigationActive && navigationTrack != nullptr) {
-      drawNavigationRoute(centerLat, centerLon);
-    }
-
-    // Draw location marker or navigation arrow on top
-    // When scrubbed (offset != 0), draw crosshair marker regardless of mode
-    if (navigationActive) {
-      if (scrubOffsetMeters != 0) {
-        // Draw scrub position marker (crosshair + ring for high visibility)
-        // Outer ring
-        display.drawCircle(CENTER_X, currentCenterY, 8, GxEPD_BLACK);
-        display.drawCircle(CENTER_X, currentCenterY, 7, GxEPD_BLACK);
-        // Inner dot
-        display.fillCircle(CENTER_X, currentCenterY, 2, GxEPD_BLACK);
-        // Crosshair lines
-        display.drawLine(CENTER_X - 12, currentCenterY, CENTER_X - 10, currentCenterY, GxEPD_BLACK);
-        display.drawLine(CENTER_X + 10, currentCenterY, CENTER_X + 12, currentCenterY, GxEPD_BLACK);
-        display.drawLine(CENTER_X, currentCenterY - 12, CENTER_X, currentCenterY - 10, GxEPD_BLACK);
-        display.drawLine(CENTER_X, currentCenterY + 10, CENTER_X, currentCenterY + 12, GxEPD_BLACK);
-      } else {
-        // Normal navigation arrow at GPS position
-        drawNavigationArrow(CENTER_X, currentCenterY, display);
-      }
-    } else {
-      drawLocationMarker(CENTER_X, currentCenterY, display);
-    }
-
-    // Draw info bar
-    updateMapInfoBar();
-
-    // Draw page dots (only show during navigation mode)
-    if (navigationActive) {
-      drawPageDots();
+      bool found = loadAndRenderTile(tileX, tileY, zoomLevel, screenX, screenY);
+#if BIKENAV_DEBUG_COMMANDS
+      Serial.printf("Tile %d/%d: x=%d y=%d z=%d%s\n",
+                    i+1, tileCount, tileX, tileY, zoomLevel, found ? "" : " not found on SD card");
+#endif
     }
+#if BIKENAV_DEBUG_COMMANDS
+    Serial.printf("Tiles selected: %d, drew pixels: %d\n", tileCount, tilesDrawnThisFrame);
+#endif
+  }
 
-    if (speedometerSplitEnabled) {
-      drawSpeedometerSplitOverlay();
-      lastSpeedometerOverlayUpdate = millis();
-    }
+  drawMapForeground(getLiveMapView(centerLat, centerLon));
 
-    // Draw notification overlay
-    drawNotificationOverlay();
+  flushDisplayDiff();
 
-  } while (display.nextPage());
+  setTileCacheAccessClass(previousClass);
 
-  Serial.println("Map fully loaded and displayed");
-  printTileCacheStats();  // Show cache performance
+#if BIKENAV_DEBUG_COMMANDS
+  Serial.printf("SD probes avoided this frame: %lu (total %lu)\n",
+                takeTilePresenceFrameStats(), tilePresenceProbesAvoided);
+#endif
+  recordMapLatency(mapLatencySync, "sync", inputMicros, micros() - start);
 }
 
 #endif // MAP_RENDERING_H
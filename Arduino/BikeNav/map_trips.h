@@ -9,6 +9,9 @@
 #include <stdint.h>
 #include <time.h>
 #include <math.h>
+#include "display_buffer.h"
+#include "panel_diff.h"
+#include "spi_bus.h"
 
 // External references from main program
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
@@ -30,6 +33,17 @@ extern void drawPageDots();
 extern void getTileCoordinates(double lat, double lon, int zoom, int* tileX, int* tileY, double* pixelX, double* pixelY);
 extern uint8_t* tileCacheLookup(int zoom, int tileX, int tileY);
 extern uint8_t* tileCacheInsert(int zoom, int tileX, int tileY);
+extern bool tileCacheCommit(uint8_t* tileData);
+extern bool tilePresenceMayExist(int zoom, int tileX, int tileY);
+extern TileCacheClass setTileCacheAccessClass(TileCacheClass cls);
+extern void tileCacheLock();
+extern void tileCacheUnlock();
+
+// External tile index from ble_handler.h
+extern const char* MAP_INDEX_PATH;
+extern const uint8_t TILE_INV_RECORD_SIZE;
+extern bool drawThickLine(int x1, int y1, int x2, int y2, int lineWidth,
+                          int clipLeft, int clipTop, int clipRight, int clipBottom);
 
 // --- TRIP DETAIL STATE ---
 char selectedTripDirName[64] = "";  // Directory name of selected trip
@@ -63,6 +77,31 @@ TrackPoint* loadedTrack = nullptr;  // PSRAM-allocated track points
 int loadedTrackPointCount = 0;      // Number of points in loaded track
 char loadedTrackName[64] = "";      // Name of currently loaded trip
 
+#include "route_geometry.h"  // Projected track geometry (needs TrackPoint)
+
+// --- TRIP PREVIEW CACHE STRUCTURES ---
+// /Trips/<dir>/<dir>_preview.bin: this header, then the rendered preview
+// rect as 1bpp rows ((width + 7) / 8 bytes, MSB first, 1 = white)
+#define TRIP_PREVIEW_MAGIC 0x56504E42  // "BNPV"
+
+struct __attribute__((packed)) TripPreviewHeader {
+  uint32_t magic;
+  uint16_t width, height;         // Preview rect in pixels
+  uint8_t zoom;                   // Preview zoom level
+  uint8_t reserved;
+  int32_t pointCount;             // Track summary
+  float minLat, maxLat, minLon, maxLon;
+  uint32_t gpxSize;               // GPX the preview was drawn from
+  uint32_t gpxLastWrite;
+  uint32_t tileIndexSize;         // /Map/index.bin size covered by the check below
+  int32_t minTileX, minTileY;     // Tiles under the preview rect at zoom
+  int32_t maxTileX, maxTileY;
+};
+
+TripPreviewHeader tripPreview;           // Header of the selected trip's preview file
+bool tripPreviewCached = false;          // tripPreview is valid for tripPreviewDirName
+char tripPreviewDirName[64] = "";
+
 // --- FUNCTION PROTOTYPES ---
 int countTripsOnSD();
 bool getTripNameByIndex(int index, char* outName, size_t maxLen);
@@ -81,12 +120,16 @@ bool loadTripForDetails(const char* tripDirName);
 // Map preview functions
 void calculateTrackBoundingBox(double* minLat, double* maxLat, double* minLon, double* maxLon);
 int calculateBestZoomLevel(double minLat, double maxLat, double minLon, double maxLon, int displayWidth, int displayHeight, int margin);
-void renderTripMapPreview(int x, int y, int width, int height);
+void renderTripMapPreview(int x, int y, int width, int height, TripPreviewHeader* outInfo = nullptr);
+bool ensureTripTrackLoaded();
+bool loadTripPreviewHeader(const char* tripDirName);
+bool drawTripPreview(int x, int y, int width, int height);
 
 // --- IMPLEMENTATIONS ---
 
 // Helper to count trips on SD card
 int countTripsOnSD() {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   File tripsDir = SD.open("/Trips");
   if (!tripsDir) return 0;
 
@@ -105,6 +148,7 @@ int countTripsOnSD() {
 
 // Helper to read trip list metadata (name + createdAt) from JSON
 bool readTripListMetadata(const char* tripDirName, char* outName, size_t maxLen, uint64_t* outCreatedAt) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   if (outCreatedAt) *outCreatedAt = 0;
   if (outName && maxLen > 0) outName[0] = '\0';
 
@@ -187,6 +231,7 @@ bool getTripNameByIndex(int index, char* outName, size_t maxLen) {
 // Helper to get trip directory name by index (newest first)
 bool getTripDirNameByIndex(int index, char* outName, size_t maxLen) {
   if (index < 0 || !outName || maxLen == 0) return false;
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
 
   int tripCount = countTripsOnSD();
   if (tripCount <= 0) return false;
@@ -231,6 +276,7 @@ bool getTripDirNameByIndex(int index, char* outName, size_t maxLen) {
 
 // Helper to read full trip metadata JSON
 bool readTripMetadata(const char* tripDirName, StaticJsonDocument<512>& doc) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   char metaPath[96];
   snprintf(metaPath, sizeof(metaPath), "/Trips/%s/%s_meta.json", tripDirName, tripDirName);
 
@@ -254,6 +300,7 @@ bool readTripMetadata(const char* tripDirName, StaticJsonDocument<512>& doc) {
 // Free currently loaded track from PSRAM
 void freeLoadedTrack() {
   if (loadedTrack != nullptr) {
+    releaseRouteGeometry(loadedTrack);
     free(loadedTrack);  // ps_malloc'd memory is freed with regular free()
     loadedTrack = nullptr;
   }
@@ -265,6 +312,7 @@ void freeLoadedTrack() {
 // Parse GPX file and load track points into PSRAM
 // Returns true on success, false on failure
 bool parseAndLoadGPX(const char* tripDirName) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   unsigned long parseStartTime = millis();
 
   // Construct GPX file path
@@ -436,6 +484,9 @@ bool parseAndLoadGPX(const char* tripDirName) {
                   loadedTrack[loadedTrackPointCount-1].elev);
   }
 
+  // Project once now so the first map frame does not pay for it
+  getRouteGeometry(loadedTrack, loadedTrackPointCount);
+
   return true;
 }
 
@@ -575,6 +626,9 @@ bool parseAndLoadGPXFromMemory(const char* tripName, const uint8_t* gpxData, uin
                   loadedTrack[loadedTrackPointCount-1].elev);
   }
 
+  // Project once now so the first map frame does not pay for it
+  getRouteGeometry(loadedTrack, loadedTrackPointCount);
+
   return true;
 }
 
@@ -585,6 +639,13 @@ bool loadTripForDetails(const char* tripDirName) {
   // Free any previously loaded track
   freeLoadedTrack();
 
+  // A valid cached preview needs no GPX until navigation starts
+  if (loadTripPreviewHeader(tripDirName)) {
+    Serial.printf("Trip preview cached (%d points, z%d), GPX parse deferred\n",
+                  tripPreview.pointCount, tripPreview.zoom);
+    return true;
+  }
+
   // Parse and load GPX file into PSRAM
   if (!parseAndLoadGPX(tripDirName)) {
     Serial.println("ERROR: Failed to load GPX data");
@@ -660,7 +721,7 @@ int calculateBestZoomLevel(double minLat, double maxLat, double minLon, double m
 }
 
 // Render map preview with track overlay
-void renderTripMapPreview(int x, int y, int width, int height) {
+void renderTripMapPreview(int x, int y, int width, int height, TripPreviewHeader* outInfo) {
   if (loadedTrack == nullptr || loadedTrackPointCount == 0) {
     Serial.println("No track loaded for preview");
     return;
@@ -697,7 +758,23 @@ void renderTripMapPreview(int x, int y, int width, int height) {
   Serial.printf("Center: lat=%.6f, lon=%.6f, tile=(%d,%d), screen=(%d,%d)\n",
                 centerLat, centerLon, centerTileX, centerTileY, centerScreenX, centerScreenY);
 
-  // Render tiles in the preview area
+  if (outInfo) {
+    outInfo->zoom = previewZoom;
+    outInfo->pointCount = loadedTrackPointCount;
+    outInfo->minLat = minLat;
+    outInfo->maxLat = maxLat;
+    outInfo->minLon = minLon;
+    outInfo->maxLon = maxLon;
+    // Tiles under the first and last pixel of the preview rect
+    outInfo->minTileX = centerTileX + (int)floorf((float)(x - centerScreenX) / 256);
+    outInfo->minTileY = centerTileY + (int)floorf((float)(y - centerScreenY) / 256);
+    outInfo->maxTileX = centerTileX + (int)floorf((float)(x + width - 1 - centerScreenX) / 256);
+    outInfo->maxTileY = centerTileY + (int)floorf((float)(y + height - 1 - centerScreenY) / 256);
+  }
+
+  // Render tiles in the preview area (probationary, must not evict the route corridor)
+  tileCacheLock();
+  TileCacheClass previousClass = setTileCacheAccessClass(TILE_CLASS_BROWSE);
   int tilesRendered = 0;
   for (int dy = -2; dy <= 2; dy++) {
     for (int dx = -2; dx <= 2; dx++) {
@@ -719,15 +796,22 @@ void renderTripMapPreview(int x, int y, int width, int height) {
           char tilePath[64];
           sprintf(tilePath, "/Map/%d/%d/%d.bin", previewZoom, tileX, tileY);
 
-          if (SD.exists(tilePath)) {
-            File file = SD.open(tilePath, FILE_READ);
-            if (file && file.size() == 8192) {
-              tileData = tileCacheInsert(previewZoom, tileX, tileY);
-              if (tileData) {
-                file.read(tileData, 8192);
+          if (tilePresenceMayExist(previewZoom, tileX, tileY)) {
+            SpiBusTransaction bus(SPI_CLIENT_SD_READ);  // Inside the tile cache lock, as in loadTileIntoCache()
+            if (SD.exists(tilePath)) {
+              File file = SD.open(tilePath, FILE_READ);
+              if (file && file.size() == 8192) {
+                tileData = tileCacheInsert(previewZoom, tileX, tileY);
+                if (tileData) {
+                  if (file.read(tileData, 8192) == 8192) {
+                    tileCacheCommit(tileData);
+                  } else {
+                    tileData = nullptr;
+                  }
+                }
               }
+              if (file) file.close();
             }
-            if (file) file.close();
           }
         }
 
@@ -764,47 +848,30 @@ void renderTripMapPreview(int x, int y, int width, int height) {
     }
   }
 
+  setTileCacheAccessClass(previousClass);
+  tileCacheUnlock();
   Serial.printf("Rendered %d tiles for preview\n", tilesRendered);
 
-  // Draw track route (simplified for performance)
-  // Downsample: draw every Nth point based on track density
-  int step = max(1, loadedTrackPointCount / 200);  // Max 200 line segments
-
-  Serial.printf("Drawing route with step=%d (%d points)\n", step, loadedTrackPointCount / step);
-
-  for (int i = 0; i < loadedTrackPointCount - step; i += step) {
-    double lat1 = loadedTrack[i].lat;
-    double lon1 = loadedTrack[i].lon;
-    double lat2 = loadedTrack[i + step].lat;
-    double lon2 = loadedTrack[i + step].lon;
-
-    // Convert to screen coordinates
-    int tile1X, tile1Y, tile2X, tile2Y;
-    double pixel1X, pixel1Y, pixel2X, pixel2Y;
-    getTileCoordinates(lat1, lon1, previewZoom, &tile1X, &tile1Y, &pixel1X, &pixel1Y);
-    getTileCoordinates(lat2, lon2, previewZoom, &tile2X, &tile2Y, &pixel2X, &pixel2Y);
-
-    // Use double precision to avoid rounding errors at high zoom levels
-    int screen1X = (int)(centerScreenX + (tile1X - centerTileX) * 256.0 + pixel1X + 0.5);
-    int screen1Y = (int)(centerScreenY + (tile1Y - centerTileY) * 256.0 + pixel1Y + 0.5);
-    int screen2X = (int)(centerScreenX + (tile2X - centerTileX) * 256.0 + pixel2X + 0.5);
-    int screen2Y = (int)(centerScreenY + (tile2Y - centerTileY) * 256.0 + pixel2Y + 0.5);
-
-    // Draw 3px wide line (draw main line + offset lines for thickness)
-    // Draw the main line first
-    display.drawLine(screen1X, screen1Y, screen2X, screen2Y, GxEPD_BLACK);
-
-    // Add thickness by drawing offset lines in cross pattern (1px offset for 3px total width)
-    display.drawLine(screen1X - 1, screen1Y, screen2X - 1, screen2Y, GxEPD_BLACK);
-    display.drawLine(screen1X + 1, screen1Y, screen2X + 1, screen2Y, GxEPD_BLACK);
-    display.drawLine(screen1X, screen1Y - 1, screen2X, screen2Y - 1, GxEPD_BLACK);
-    display.drawLine(screen1X, screen1Y + 1, screen2X, screen2Y + 1, GxEPD_BLACK);
-
-    // Add diagonal offsets for better coverage at 45-degree angles
-    display.drawLine(screen1X - 1, screen1Y - 1, screen2X - 1, screen2Y - 1, GxEPD_BLACK);
-    display.drawLine(screen1X + 1, screen1Y - 1, screen2X + 1, screen2Y - 1, GxEPD_BLACK);
-    display.drawLine(screen1X - 1, screen1Y + 1, screen2X - 1, screen2Y + 1, GxEPD_BLACK);
-    display.drawLine(screen1X + 1, screen1Y + 1, screen2X + 1, screen2Y + 1, GxEPD_BLACK);
+  // Draw track route, simplified to one pixel of error at the preview zoom
+  RouteGeometry* geometry = getRouteGeometry(loadedTrack, loadedTrackPointCount);
+  int level = getRouteLodLevel(previewZoom);
+  int lodCount = geometry ? geometry->lodCount[level] : 0;
+
+  Serial.printf("Drawing route with LOD level %d (%d points)\n", level, lodCount);
+
+  // Same sub-pixel offset as the tiles (they are placed with a truncated center pixel)
+  RouteView view;
+  setupRouteView(&view, centerLat, centerLon, previewZoom, 0,
+                 x + width / 2 + (float)(centerPixelX - (int)centerPixelX),
+                 y + height / 2 + (float)(centerPixelY - (int)centerPixelY));
+
+  for (int i = 0; i + 1 < lodCount; i++) {
+    int screen1X, screen1Y, screen2X, screen2Y;
+    routePointToScreen(&view, geometry->points[geometry->lodIndex[level][i]], &screen1X, &screen1Y);
+    routePointToScreen(&view, geometry->points[geometry->lodIndex[level][i + 1]], &screen2X, &screen2Y);
+
+    // 3px wide line with round joins, clipped to the preview area
+    drawThickLine(screen1X, screen1Y, screen2X, screen2Y, 3, x, y, x + width, y + height);
   }
 
   // Draw start marker (filled circle)
@@ -844,6 +911,225 @@ void renderTripMapPreview(int x, int y, int width, int height) {
   Serial.println("Map preview rendering complete");
 }
 
+// --- TRIP PREVIEW CACHE ---
+// The rendered preview is stored next to the GPX on first render. It is
+// reused while the GPX has the same size and write time, and no tile under
+// the preview rect has been saved since: tiles saved after the preview are
+// the records appended to /Map/index.bin past tileIndexSize.
+
+static void getTripPreviewPath(const char* tripDirName, char* path, size_t maxLen) {
+  snprintf(path, maxLen, "/Trips/%s/%s_preview.bin", tripDirName, tripDirName);
+}
+
+// GPX size and write time, the preview's key on the track it shows
+static bool getTripGpxStamp(const char* tripDirName, uint32_t* size, uint32_t* lastWrite) {
+  char gpxPath[96];
+  snprintf(gpxPath, sizeof(gpxPath), "/Trips/%s/%s.gpx", tripDirName, tripDirName);
+  File gpxFile = SD.open(gpxPath, FILE_READ);
+  if (!gpxFile) return false;
+  *size = gpxFile.size();
+  *lastWrite = (uint32_t)gpxFile.getLastWrite();
+  gpxFile.close();
+  return true;
+}
+
+/**
+ * Check tiles saved since the preview was rendered. Returns false if one
+ * lies under the preview (or the index was rebuilt); otherwise advances
+ * header->tileIndexSize and sets *advanced so the caller can persist it.
+ */
+static bool checkTripPreviewTiles(TripPreviewHeader* header, bool* advanced) {
+  *advanced = false;
+  File indexFile = SD.open(MAP_INDEX_PATH, FILE_READ);
+  uint32_t indexSize = indexFile ? indexFile.size() : 0;
+  if (indexSize == header->tileIndexSize) {
+    if (indexFile) indexFile.close();
+    return true;
+  }
+  if (indexSize < header->tileIndexSize) {
+    if (indexFile) indexFile.close();
+    return false;  // Index rebuilt, tiles may have changed anywhere
+  }
+
+  uint8_t records[TILE_INV_RECORD_SIZE * 32];
+  indexFile.seek(header->tileIndexSize);
+  uint32_t remaining = indexSize - header->tileIndexSize;
+  bool valid = true;
+  while (valid && remaining >= TILE_INV_RECORD_SIZE) {
+    size_t chunk = min(remaining, (uint32_t)sizeof(records)) / TILE_INV_RECORD_SIZE * TILE_INV_RECORD_SIZE;
+    if (indexFile.read(records, chunk) != chunk) {
+      valid = false;
+      break;
+    }
+    for (size_t i = 0; i < chunk; i += TILE_INV_RECORD_SIZE) {
+      const uint8_t* record = records + i;
+      int32_t tileX = (int32_t)(((uint32_t)record[1] << 24) | ((uint32_t)record[2] << 16) | ((uint32_t)record[3] << 8) | record[4]);
+      int32_t tileY = (int32_t)(((uint32_t)record[5] << 24) | ((uint32_t)record[6] << 16) | ((uint32_t)record[7] << 8) | record[8]);
+      if (record[0] == header->zoom &&
+          tileX >= header->minTileX && tileX <= header->maxTileX &&
+          tileY >= header->minTileY && tileY <= header->maxTileY) {
+        valid = false;
+        break;
+      }
+    }
+    remaining -= chunk;
+  }
+  indexFile.close();
+
+  if (valid) {
+    header->tileIndexSize = indexSize;
+    *advanced = true;
+  }
+  return valid;
+}
+
+/**
+ * Read and validate the trip's preview header into tripPreview.
+ * Returns true if the cached preview can be shown without the GPX.
+ */
+bool loadTripPreviewHeader(const char* tripDirName) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+  tripPreviewCached = false;
+
+  char path[128];
+  getTripPreviewPath(tripDirName, path, sizeof(path));
+  File file = SD.open(path, FILE_READ);
+  if (!file) return false;
+
+  TripPreviewHeader header;
+  bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+            header.magic == TRIP_PREVIEW_MAGIC &&
+            file.size() == sizeof(header) + (size_t)((header.width + 7) / 8) * header.height;
+  file.close();
+  if (!ok) return false;
+
+  uint32_t gpxSize, gpxLastWrite;
+  if (!getTripGpxStamp(tripDirName, &gpxSize, &gpxLastWrite) ||
+      gpxSize != header.gpxSize || gpxLastWrite != header.gpxLastWrite) {
+    Serial.println("Trip preview stale: GPX changed");
+    return false;
+  }
+
+  bool advanced;
+  if (!checkTripPreviewTiles(&header, &advanced)) {
+    Serial.println("Trip preview stale: tiles changed");
+    return false;
+  }
+  if (advanced) {
+    // Skip the records just checked next time
+    File patch = SD.open(path, "r+");
+    if (patch) {
+      patch.write((const uint8_t*)&header, sizeof(header));
+      patch.close();
+    }
+  }
+
+  tripPreview = header;
+  tripPreviewCached = true;
+  strncpy(tripPreviewDirName, tripDirName, sizeof(tripPreviewDirName) - 1);
+  tripPreviewDirName[sizeof(tripPreviewDirName) - 1] = '\0';
+  return true;
+}
+
+// Parse the selected trip's GPX if the details view skipped it
+bool ensureTripTrackLoaded() {
+  if (loadedTrack != nullptr && loadedTrackPointCount > 0) return true;
+  if (selectedTripDirName[0] == '\0') return false;
+  return parseAndLoadGPX(selectedTripDirName);
+}
+
+// Blit the cached preview bitmap into the rect; false if it doesn't fit
+static bool blitCachedTripPreview(int x, int y, int width, int height) {
+  if (tripPreview.width != width || tripPreview.height != height) return false;
+
+  char path[128];
+  getTripPreviewPath(tripPreviewDirName, path, sizeof(path));
+  int rowBytes = (width + 7) / 8;
+  size_t bitmapSize = (size_t)rowBytes * height;
+  uint8_t* bitmap = (uint8_t*)malloc(bitmapSize);
+  if (!bitmap) return false;
+
+  bool ok;
+  {
+    SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+    File file = SD.open(path, FILE_READ);
+    ok = file && file.seek(sizeof(TripPreviewHeader)) && file.read(bitmap, bitmapSize) == bitmapSize;
+    if (file) file.close();
+  }
+
+  if (ok) {
+    display.fillRect(x, y, width, height, GxEPD_WHITE);
+    for (int row = 0; row < height; row++) {
+      displayBlitRow(bitmap + row * rowBytes, rowBytes, x, y + row, -1);
+    }
+  }
+  free(bitmap);
+  return ok;
+}
+
+// Store the rendered preview rect with its header
+static void saveTripPreview(const char* tripDirName, int x, int y, int width, int height,
+                            TripPreviewHeader* header) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+  header->magic = TRIP_PREVIEW_MAGIC;
+  header->width = width;
+  header->height = height;
+  header->reserved = 0;
+  if (!getTripGpxStamp(tripDirName, &header->gpxSize, &header->gpxLastWrite)) return;
+  File indexFile = SD.open(MAP_INDEX_PATH, FILE_READ);
+  header->tileIndexSize = indexFile ? indexFile.size() : 0;
+  if (indexFile) indexFile.close();
+
+  char path[128];
+  getTripPreviewPath(tripDirName, path, sizeof(path));
+  File file = SD.open(path, FILE_WRITE);
+  if (!file) {
+    Serial.printf("ERROR: Failed to write trip preview: %s\n", path);
+    return;
+  }
+  file.write((const uint8_t*)header, sizeof(TripPreviewHeader));
+  uint8_t rowData[(GxEPD2_290_BS::WIDTH + 7) / 8];
+  for (int row = 0; row < height; row++) {
+    displayReadRow(y + row, x, width, rowData);
+    file.write(rowData, (width + 7) / 8);
+  }
+  file.close();
+
+  tripPreview = *header;
+  tripPreviewCached = true;
+  strncpy(tripPreviewDirName, tripDirName, sizeof(tripPreviewDirName) - 1);
+  tripPreviewDirName[sizeof(tripPreviewDirName) - 1] = '\0';
+  Serial.printf("Trip preview cached: %s (%dx%d)\n", path, width, height);
+}
+
+/**
+ * Draw the selected trip's map preview: the cached bitmap when valid,
+ * otherwise render it from the GPX and tiles and cache the result.
+ * Returns false if there is nothing to show.
+ */
+bool drawTripPreview(int x, int y, int width, int height) {
+  bool regularTrip = !isNavigateHomeMode && selectedTripDirName[0] != '\0';
+  bool direct = isDisplayBufferDirect() && x >= 0 && x + width <= DISPLAY_WIDTH;
+
+  if (regularTrip && direct && tripPreviewCached &&
+      strcmp(tripPreviewDirName, selectedTripDirName) == 0) {
+    if (blitCachedTripPreview(x, y, width, height)) {
+      Serial.println("Trip preview drawn from cache");
+      return true;
+    }
+  }
+
+  if (regularTrip && !ensureTripTrackLoaded()) return false;
+  if (loadedTrack == nullptr || loadedTrackPointCount == 0) return false;
+
+  TripPreviewHeader header = {};
+  renderTripMapPreview(x, y, width, height, &header);
+  if (regularTrip && direct) {
+    saveTripPreview(selectedTripDirName, x, y, width, height, &header);
+  }
+  return true;
+}
+
 // Helper to recursively delete a directory
 void deleteDirectory(File dir) {
   while (true) {
@@ -867,6 +1153,7 @@ void deleteDirectory(File dir) {
 
 // Delete trip from SD card (GPX, metadata, and folder)
 bool deleteTripFromSD(const char* tripDirName) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   char tripPath[64];
   snprintf(tripPath, sizeof(tripPath), "/Trips/%s", tripDirName);
 
@@ -1102,6 +1389,7 @@ void renderTripDetailView() {
   // Note: Navigate Home trips don't have metadata from SD card
   // In the future, we could parse metadata from the BLE-received data
 
+  invalidatePanelShadow();  // Not a map frame, the next one is pushed whole
   display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
   display.firstPage();
 
@@ -1283,10 +1571,12 @@ void renderTripDetailView() {
         u8g2_display.setCursor((DISPLAY_WIDTH - line2Width) / 2, mapPlaceholderTop + mapPlaceholderHeight / 2 + 6);
         u8g2_display.print(line2);
       }
-    } else if (loadedTrack != nullptr && loadedTrackPointCount > 0) {
+    } else if ((loadedTrack != nullptr && loadedTrackPointCount > 0) ||
+               (tripPreviewCached && !isNavigateHome &&
+                strcmp(tripPreviewDirName, selectedTripDirName) == 0)) {
       // Draw border for map preview area
       display.drawRect(4, mapPlaceholderTop, DISPLAY_WIDTH - 8, mapPlaceholderHeight, GxEPD_BLACK);
-      renderTripMapPreview(4, mapPlaceholderTop, DISPLAY_WIDTH - 8, mapPlaceholderHeight);
+      drawTripPreview(4, mapPlaceholderTop, DISPLAY_WIDTH - 8, mapPlaceholderHeight);
     } else {
       // Regular trip mode - show loading message without border
       u8g2_display.setFont(u8g2_font_helvB10_tf);
@@ -1460,7 +1750,7 @@ void renderTripDetailView() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 #endif // MAP_TRIPS_H
@@ -5,6 +5,7 @@
 #include <Arduino.h>
 #include <GxEPD2_BW.h>
 #include <U8g2_for_Adafruit_GFX.h>
+#include "frame_scheduler.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
@@ -355,7 +356,7 @@ void drawNotificationOverlay() {
  * Call this from main loop or page update functions
  * Similar to updateStatusBar() - coordinates with user activity and respects debouncing
  * @param forceUpdate If true, bypass user activity check (use when page is already re-rendering)
- * @return true if refresh was performed
+ * @return true if a refresh was scheduled
  */
 bool updateNotificationDisplay(bool forceUpdate = false) {
   if (!notificationRenderState.initialized) {
@@ -384,9 +385,9 @@ bool updateNotificationDisplay(bool forceUpdate = false) {
     return false;
   }
 
-  // Perform refresh - call the page render function
-  Serial.println("Notification: Performing smart refresh");
-  forceNotificationRefresh();
+  // Refresh the page in the next frame slot (merged with other pending refreshes)
+  Serial.println("Notification: Requesting smart refresh");
+  submitFrame(FRAME_REGION_PAGE, FRAME_PRIORITY_STATUS);
 
   // Clear pending flag
   notificationRenderState.pendingRefresh = false;
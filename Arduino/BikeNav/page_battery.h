@@ -8,6 +8,7 @@
 #include "battery_manager.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -124,7 +125,7 @@ void renderBatteryInfoPage() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 #endif
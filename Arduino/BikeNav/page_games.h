@@ -8,6 +8,7 @@
 #include "controls_helper.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -504,7 +505,7 @@ void renderDifficultySelect() {
     drawStatusBar();
 
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // Draw game board
@@ -567,7 +568,7 @@ void renderGameBoard() {
     }
 
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // Draw game over dialog
@@ -707,7 +708,7 @@ void renderGameOverDialog() {
     u8g2_display.print(button2Text);
 
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // --- PAGE INTERFACE FUNCTIONS ---
@@ -9,6 +9,7 @@
 #include "status_bar.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -113,7 +114,7 @@ void renderMainMenu() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void handleMainMenuEncoder(int delta) {
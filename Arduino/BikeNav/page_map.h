@@ -7,9 +7,11 @@
 #include <ArduinoJson.h>
 #include "notification_system.h"
 #include "controls_helper.h"
+#include "frame_scheduler.h"
 
 // External references from main program
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -235,7 +237,14 @@ ElevationGraphData elevGraphData = {nullptr, nullptr, 0, 0, 0, 0, 0, false};
 // IMPORTANT: map_trips.h must come first as it defines TrackPoint structure
 #include "map_trips.h"
 #include "map_rendering.h"
+#include "map_canvas.h"     // Persistent world-space canvas behind the map view
+#include "map_render_task.h"  // Map composition on the second core
+#if BIKENAV_DEBUG_COMMANDS
+#include "map_benchmark.h"    // Per-stage render pipeline benchmark
+#endif
+#include "map_layers.h"       // Cached base / band layers of the map frame
 #include "map_navigation.h"
+#include "tile_prefetch.h"  // Route-ahead tile prefetch during navigation
 #include "page_trips.h"  // Standalone trips page
 
 // --- SHARED UI FUNCTIONS ---
@@ -361,6 +370,11 @@ bool hasElevationData() {
   return false;  // All elevations are 0
 }
 
+// The live map (not a stats, trips or profile sub-page) is on screen
+bool isMapViewShown() {
+  return currentPage == PAGE_MAP && currentMapSubPage == MAP_SUBPAGE_MAP;
+}
+
 void renderMapPage() {
   switch (currentMapSubPage) {
     case MAP_SUBPAGE_MAP:
@@ -456,7 +470,7 @@ void updateMapPage() {
     scrubOffsetMeters = 0;
     scrubPending = false;
     Serial.println("Navigation stopped: exiting SCRUB mode");
-    refreshMapInfoBar();
+    submitFrame(FRAME_REGION_INFO_BAR, FRAME_PRIORITY_NAVIGATION);
   }
   // Also reset scrub offset if navigation stops in any mode
   if (!navigationActive && scrubOffsetMeters != 0) {
@@ -471,7 +485,7 @@ void updateMapPage() {
       (millis() - lastScrubChange >= SCRUB_TIMEOUT_MS)) {
     scrubOffsetMeters = 0;
     Serial.println("Scrub timeout: resetting to GPS position");
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_NAVIGATION);
     lastMapUpdate = millis();
     return;  // Don't check other updates if we just reset scrub
   }
@@ -483,7 +497,7 @@ void updateMapPage() {
     if (autoRotationEnabled && navigationActive) {
       calculateAutoRotation();
     }
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);
     lastMapUpdate = millis();
     return;  // Don't check periodic update if we just did a scrub redraw
   }
@@ -495,7 +509,7 @@ void updateMapPage() {
     if (navigationActive) {
       updateNavigationState();
     }
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);
     lastMapUpdate = millis();
     return;  // Don't check periodic update if we just did a rotation redraw
   }
@@ -513,7 +527,7 @@ void updateMapPage() {
       if (navigationActive) {
         updateNavigationState();
       }
-      loadAndDisplayMap();
+      submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_NAVIGATION);
       lastMapUpdate = millis();
       return;  // Don't check periodic update if we just did a GPS update
     }
@@ -529,7 +543,7 @@ void updateMapPage() {
     if (navigationActive) {
       updateNavigationState();
     }
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_NAVIGATION);
     lastMapUpdate = millis();
   }
 
@@ -537,7 +551,7 @@ void updateMapPage() {
     unsigned long now = millis();
     if (!rotationPending && !scrubPending &&
         now - lastSpeedometerOverlayUpdate >= SPEEDOMETER_OVERLAY_UPDATE_INTERVAL) {
-      renderSpeedometerSplitOverlay();
+      submitFrame(FRAME_REGION_SPEEDO_OVERLAY, FRAME_PRIORITY_NAVIGATION);
       lastSpeedometerOverlayUpdate = now;
     }
   }
@@ -607,6 +621,7 @@ void handleMapEncoder(int delta) {
 
   // Only allow map interaction on map view
   if (currentMapSubPage != MAP_SUBPAGE_MAP) return;
+  noteMapInput();
 
   if (currentMapMode == MAP_MODE_ZOOM) {
     // ZOOM MODE: Change zoom level
@@ -627,7 +642,7 @@ void handleMapEncoder(int delta) {
       lastScrubChange = millis();
     }
 
-    loadAndDisplayMap();  // Load and display immediately
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);  // Shown in this loop's frame slot
     lastMapUpdate = millis();
   } else if (currentMapMode == MAP_MODE_ROTATION) {
     // ROTATION MODE: Update rotation immediately in memory, defer display refresh
@@ -695,14 +710,15 @@ void handleMapEncoder(int delta) {
 void handleMapButton() {
   // If there's a pending rotation or scrub redraw, force it now before mode change
   // This ensures the user sees the final state before switching modes
+  // (merged with the info bar refresh below into one frame)
   if (rotationPending) {
     rotationPending = false;
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);
     lastMapUpdate = millis();
   }
   if (scrubPending) {
     scrubPending = false;
-    loadAndDisplayMap();
+    submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);
     lastMapUpdate = millis();
   }
 
@@ -728,7 +744,7 @@ void handleMapButton() {
       Serial.println("Map mode: ZOOM (scrub offset preserved)");
     }
     // Refresh info bar to show new mode icon immediately
-    refreshMapInfoBar();
+    submitFrame(FRAME_REGION_INFO_BAR, FRAME_PRIORITY_INPUT);
   } else if (currentMapSubPage == MAP_SUBPAGE_HEIGHT_PROFILE) {
     // Toggle between upcoming and total trip stat views
     if (currentElevStatView == ELEV_STATS_UPCOMING) {
@@ -818,6 +834,9 @@ void handleMapButton() {
           const char* tripNameToStart = selectedTripDirName[0] != '\0' ? selectedTripDirName : loadedTrackName;
           Serial.printf("Starting navigation for trip: %s\n", tripNameToStart);
 
+          // The details view may have shown a cached preview without parsing the GPX
+          ensureTripTrackLoaded();
+
           // Start trip navigation (transfers ownership of loadedTrack to navigationTrack)
           startTripNavigation(tripNameToStart);
 
@@ -1017,7 +1036,7 @@ void resetMapView() {
   }
 
   // Immediately redraw the map with new view settings
-  loadAndDisplayMap();
+  submitFrame(FRAME_REGION_MAP, FRAME_PRIORITY_INPUT);
   lastMapUpdate = millis();
 
   Serial.println("Reset: View reset complete");
@@ -1087,6 +1106,7 @@ void handleMapOptions() {
     // Show navigation stop confirmation
     Serial.println("Active navigation - showing stop confirmation");
 
+    invalidatePanelShadow();  // Not a map frame, the next one is pushed whole
     display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
     display.firstPage();
 
@@ -1135,7 +1155,7 @@ void handleMapOptions() {
 
       drawNotificationOverlay();
 
-    } while (display.nextPage());
+    } while (nextDisplayPage());
 
     // Wait for button press
     bool waiting = true;
@@ -1754,13 +1774,7 @@ void drawElevationGraph(int graphX, int graphY, int graphWidth, int graphHeight)
     if (y2 > graphY + graphHeight) y2 = graphY + graphHeight;
 
     // Draw thick line with uniform width regardless of angle
-    // Main line
-    display.drawLine(x1, y1, x2, y2, GxEPD_BLACK);
-    // Offsets in all directions for uniform thickness
-    display.drawLine(x1 - 1, y1, x2 - 1, y2, GxEPD_BLACK);
-    display.drawLine(x1 + 1, y1, x2 + 1, y2, GxEPD_BLACK);
-    display.drawLine(x1, y1 - 1, x2, y2 - 1, GxEPD_BLACK);
-    display.drawLine(x1, y1 + 1, x2, y2 + 1, GxEPD_BLACK);
+    drawThickLine(x1, y1, x2, y2, 3, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
   }
 
   // --- Draw "you are here" vertical line at start ---
@@ -1782,6 +1796,7 @@ void renderHeightProfileView() {
   // Process elevation data for current distance selection
   processElevationData();
 
+  invalidatePanelShadow();  // Not a map frame, the next one is pushed whole
   display.setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
   display.firstPage();
 
@@ -1923,7 +1938,7 @@ void renderHeightProfileView() {
     // --- Draw notification overlay ---
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 #endif // PAGE_MAP_H
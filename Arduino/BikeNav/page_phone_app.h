@@ -7,6 +7,7 @@
 #include "status_bar.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -462,7 +463,7 @@ void renderPhoneAppPage() {
             drawConfirmationPopup("Locate phone?", locatePhoneConfirmSelection);
         }
 
-    } while (display.nextPage());
+    } while (nextDisplayPage());
 }
 
 void updatePhoneAppPage() {
@@ -547,7 +548,7 @@ void handlePhoneAppButton() {
                 int textWidth = u8g2_display.getUTF8Width("Phone ringing...");
                 u8g2_display.setCursor((DISPLAY_WIDTH - textWidth) / 2, DISPLAY_HEIGHT / 2);
                 u8g2_display.print("Phone ringing...");
-            } while (display.nextPage());
+            } while (nextDisplayPage());
 
             delay(1500);
         } else {
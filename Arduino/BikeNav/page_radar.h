@@ -10,6 +10,7 @@
 #include "status_bar.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -44,6 +45,194 @@ int findNextReadyRadarFrameOffset(int startOffset, int endOffset) {
   return endOffset + 1;
 }
 
+// Route and position marker on top of the radar map
+void drawRadarDecorations(double centerLat, double centerLon) {
+  if (navigationActive && navigationTrack != nullptr) {
+    drawNavigationRoute(centerLat, centerLon);
+  }
+
+  if (navigationActive) {
+    if (scrubOffsetMeters != 0) {
+      display.drawCircle(CENTER_X, currentCenterY, 8, GxEPD_BLACK);
+      display.drawCircle(CENTER_X, currentCenterY, 7, GxEPD_BLACK);
+      display.fillCircle(CENTER_X, currentCenterY, 2, GxEPD_BLACK);
+      display.drawLine(CENTER_X - 12, currentCenterY, CENTER_X - 10, currentCenterY, GxEPD_BLACK);
+      display.drawLine(CENTER_X + 10, currentCenterY, CENTER_X + 12, currentCenterY, GxEPD_BLACK);
+      display.drawLine(CENTER_X, currentCenterY - 12, CENTER_X, currentCenterY - 10, GxEPD_BLACK);
+      display.drawLine(CENTER_X, currentCenterY + 10, CENTER_X, currentCenterY + 12, GxEPD_BLACK);
+    } else {
+      drawNavigationArrow(CENTER_X, currentCenterY, display);
+    }
+  } else {
+    drawLocationMarker(CENTER_X, currentCenterY, display);
+  }
+}
+
+// --- PRECOMPOSED RADAR FRAMES ---
+// The radar page view only changes with position, zoom and navigation
+// state, so its layers are rendered once into PSRAM framebuffer copies:
+// the tile map, and the decorations (route, marker) drawn once on white
+// and once on black. Untouched decoration pixels are 1 on white and 0 on
+// black, so (frame & onWhite) | onBlack puts them back exactly, white
+// outlines included. Every ready radar frame is then composed into its
+// own full-screen buffer, and stepping or animating is one memcpy.
+#define RADAR_LAYER_BYTES (DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS)
+
+struct RadarLayers {
+  uint8_t* base;              // Tiles only, 1 = white
+  uint8_t* decorOnWhite;
+  uint8_t* decorOnBlack;
+  uint8_t* frames;            // RADAR_MAX_FRAMES composed screens
+  bool frameComposed[RADAR_MAX_FRAMES];
+  uint16_t frameGeneration[RADAR_MAX_FRAMES];  // radarFrameGeneration each was composed from
+  bool valid;
+  int lightenPhase;           // Checkerboard phase of the tile pixels
+  // View the layers were rendered for
+  double centerLat, centerLon;
+  int zoom, zoomIndex, mapHeight, centerY;
+  bool navigation, scrubbing;
+  const TrackPoint* track;
+  int trackPointCount;
+};
+
+RadarLayers radarLayers = {};
+
+// A tile was (re)written on SD card - re-render the base layer if it may show it
+void radarLayersNoteTileSaved(int zoom) {
+  if (radarLayers.valid && zoom == radarLayers.zoom) {
+    radarLayers.valid = false;
+  }
+}
+
+static bool allocateRadarLayers() {
+  if (radarLayers.base) return true;
+  uint8_t* block = (uint8_t*)ps_malloc(RADAR_LAYER_BYTES * (3 + RADAR_MAX_FRAMES));
+  if (!block) {
+    Serial.println("[RADAR] ERROR: Failed to allocate precomposed frame buffers");
+    return false;
+  }
+  radarLayers.base = block;
+  radarLayers.decorOnWhite = block + RADAR_LAYER_BYTES;
+  radarLayers.decorOnBlack = block + RADAR_LAYER_BYTES * 2;
+  radarLayers.frames = block + RADAR_LAYER_BYTES * 3;
+  radarLayers.valid = false;
+  return true;
+}
+
+static bool radarLayersMatchView(double centerLat, double centerLon) {
+  return radarLayers.valid &&
+         radarLayers.centerLat == centerLat && radarLayers.centerLon == centerLon &&
+         radarLayers.zoom == radarZoomLevel && radarLayers.zoomIndex == currentZoomIndex &&
+         radarLayers.mapHeight == MAP_DISPLAY_HEIGHT && radarLayers.centerY == currentCenterY &&
+         radarLayers.navigation == navigationActive &&
+         radarLayers.scrubbing == (scrubOffsetMeters != 0) &&
+         radarLayers.track == navigationTrack &&
+         radarLayers.trackPointCount == navigationTrackPointCount;
+}
+
+// Framebuffer words = (word & onWhite) | onBlack
+static void applyRadarDecorations() {
+  uint8_t* buffer = getDisplayBuffer();
+  for (int i = 0; i < RADAR_LAYER_BYTES; i += 4) {
+    uint32_t word, onWhite, onBlack;
+    memcpy(&word, buffer + i, 4);
+    memcpy(&onWhite, radarLayers.decorOnWhite + i, 4);
+    memcpy(&onBlack, radarLayers.decorOnBlack + i, 4);
+    word = (word & onWhite) | onBlack;
+    memcpy(buffer + i, &word, 4);
+  }
+}
+
+// Render tiles and decorations for the current view into the layers
+static void buildRadarLayers(double centerLat, double centerLon) {
+  uint8_t* buffer = getDisplayBuffer();
+
+  display.fillScreen(GxEPD_WHITE);
+  calculateVisibleTiles(centerLat, centerLon, radarZoomLevel);
+  radarMapLightenEnabled = false;
+  for (int i = 0; i < tileCount; i++) {
+    if (!loadAndRenderTile(tilesToRender[i].tileX, tilesToRender[i].tileY, radarZoomLevel,
+                           tilesToRender[i].screenX, tilesToRender[i].screenY)) {
+      Serial.println("Radar map: Tile not found on SD card");
+    }
+  }
+  memcpy(radarLayers.base, buffer, RADAR_LAYER_BYTES);
+  // Every tile sits at an even world offset, so any tile gives the phase
+  radarLayers.lightenPhase = tileCount > 0 ? (tilesToRender[0].screenX + tilesToRender[0].screenY) & 1 : -1;
+
+  display.fillScreen(GxEPD_WHITE);
+  drawRadarDecorations(centerLat, centerLon);
+  memcpy(radarLayers.decorOnWhite, buffer, RADAR_LAYER_BYTES);
+  display.fillScreen(GxEPD_BLACK);
+  drawRadarDecorations(centerLat, centerLon);
+  memcpy(radarLayers.decorOnBlack, buffer, RADAR_LAYER_BYTES);
+
+  for (int i = 0; i < RADAR_MAX_FRAMES; i++) {
+    radarLayers.frameComposed[i] = false;
+  }
+  radarLayers.valid = true;
+  radarLayers.centerLat = centerLat;
+  radarLayers.centerLon = centerLon;
+  radarLayers.zoom = radarZoomLevel;
+  radarLayers.zoomIndex = currentZoomIndex;
+  radarLayers.mapHeight = MAP_DISPLAY_HEIGHT;
+  radarLayers.centerY = currentCenterY;
+  radarLayers.navigation = navigationActive;
+  radarLayers.scrubbing = scrubOffsetMeters != 0;
+  radarLayers.track = navigationTrack;
+  radarLayers.trackPointCount = navigationTrackPointCount;
+}
+
+/**
+ * Draw the radar map area from the precomposed layers, rebuilding the
+ * layers when the view changed and composing ready frames that are new
+ * or were replaced since. Returns false when the layers cannot be used
+ * (no PSRAM, framebuffer not directly addressable) - the caller renders
+ * tiles instead.
+ */
+static bool drawRadarMapFromLayers(double centerLat, double centerLon) {
+  if (!isDisplayBufferDirect() || !allocateRadarLayers()) return false;
+
+  unsigned long start = micros();
+  bool rebuilt = !radarLayersMatchView(centerLat, centerLon);
+  if (rebuilt) buildRadarLayers(centerLat, centerLon);
+
+  uint8_t* buffer = getDisplayBuffer();
+  bool overlay = radarOverlayEnabled && !radarHasError;
+  int composed = 0;
+  if (overlay) {
+    for (int offset = -RADAR_MAX_PAST_FRAMES; offset <= RADAR_MAX_FUTURE_FRAMES; offset++) {
+      int index = radarFrameOffsetToIndex(offset);
+      // Snapshot before composing: a frame the BLE task rewrites meanwhile
+      // keeps a newer generation and is composed again next time
+      uint16_t generation = radarFrameGeneration[index];
+      const uint8_t* frameData = getRadarFrameData(offset);
+      if (!frameData) continue;
+      if (radarLayers.frameComposed[index] && radarLayers.frameGeneration[index] == generation) continue;
+
+      memcpy(buffer, radarLayers.base, RADAR_LAYER_BYTES);
+      drawRadarOverlay(frameData, radarLayers.lightenPhase);
+      applyRadarDecorations();
+      memcpy(radarLayers.frames + index * RADAR_LAYER_BYTES, buffer, RADAR_LAYER_BYTES);
+      radarLayers.frameComposed[index] = true;
+      radarLayers.frameGeneration[index] = generation;
+      composed++;
+    }
+  }
+
+  int index = radarFrameOffsetToIndex(radarFrameOffset);
+  if (overlay && isRadarFrameReady(radarFrameOffset)) {
+    memcpy(buffer, radarLayers.frames + index * RADAR_LAYER_BYTES, RADAR_LAYER_BYTES);
+  } else {
+    memcpy(buffer, radarLayers.base, RADAR_LAYER_BYTES);
+    applyRadarDecorations();
+  }
+
+  Serial.printf("[RADAR] Map from layers: %s, %d frames composed, %lu us\n",
+                rebuilt ? "rebuilt" : "cached", composed, micros() - start);
+  return true;
+}
+
 void drawRadarMapContent() {
   int previousZoom = zoomLevel;
   int previousRotation = mapRotation;
@@ -64,42 +253,35 @@ void drawRadarMapContent() {
     centerLon = scrubLon;
   }
 
-  calculateVisibleTiles(centerLat, centerLon, radarZoomLevel);
-
-  const uint8_t* overlayFrame = getRadarFrameData(radarFrameOffset);
-  radarMapLightenEnabled = radarOverlayEnabled && overlayFrame != nullptr;
-  for (int i = 0; i < tileCount; i++) {
-    int tileX = tilesToRender[i].tileX;
-    int tileY = tilesToRender[i].tileY;
-    int screenX = tilesToRender[i].screenX;
-    int screenY = tilesToRender[i].screenY;
-
-    if (!loadAndRenderTile(tileX, tileY, radarZoomLevel, screenX, screenY)) {
-      Serial.println("Radar map: Tile not found on SD card");
+  if (!drawRadarMapFromLayers(centerLat, centerLon)) {
+    calculateVisibleTiles(centerLat, centerLon, radarZoomLevel);
+
+    // Lighten the map under the radar: word-wise in the compositor when it
+    // can, otherwise per pixel inside the tile renderers
+    const uint8_t* overlayFrame = getRadarFrameData(radarFrameOffset);
+    bool lighten = radarOverlayEnabled && overlayFrame != nullptr;
+    bool composeLighten = lighten && isRadarCompositorDirect();
+    radarMapLightenEnabled = lighten && !composeLighten;
+    for (int i = 0; i < tileCount; i++) {
+      int tileX = tilesToRender[i].tileX;
+      int tileY = tilesToRender[i].tileY;
+      int screenX = tilesToRender[i].screenX;
+      int screenY = tilesToRender[i].screenY;
+
+      if (!loadAndRenderTile(tileX, tileY, radarZoomLevel, screenX, screenY)) {
+        Serial.println("Radar map: Tile not found on SD card");
+      }
     }
-  }
-  radarMapLightenEnabled = false;
+    radarMapLightenEnabled = false;
 
-  drawRadarOverlay(overlayFrame);
-
-  if (navigationActive && navigationTrack != nullptr) {
-    drawNavigationRoute(centerLat, centerLon);
-  }
-
-  if (navigationActive) {
-    if (scrubOffsetMeters != 0) {
-      display.drawCircle(CENTER_X, currentCenterY, 8, GxEPD_BLACK);
-      display.drawCircle(CENTER_X, currentCenterY, 7, GxEPD_BLACK);
-      display.fillCircle(CENTER_X, currentCenterY, 2, GxEPD_BLACK);
-      display.drawLine(CENTER_X - 12, currentCenterY, CENTER_X - 10, currentCenterY, GxEPD_BLACK);
-      display.drawLine(CENTER_X + 10, currentCenterY, CENTER_X + 12, currentCenterY, GxEPD_BLACK);
-      display.drawLine(CENTER_X, currentCenterY - 12, CENTER_X, currentCenterY - 10, GxEPD_BLACK);
-      display.drawLine(CENTER_X, currentCenterY + 10, CENTER_X, currentCenterY + 12, GxEPD_BLACK);
-    } else {
-      drawNavigationArrow(CENTER_X, currentCenterY, display);
+    // Checkerboard phase of tile pixel parity: every tile sits at an even
+    // world offset, so any tile's screen position gives it
+    int lightenPhase = -1;
+    if (composeLighten && tileCount > 0) {
+      lightenPhase = (tilesToRender[0].screenX + tilesToRender[0].screenY) & 1;
     }
-  } else {
-    drawLocationMarker(CENTER_X, currentCenterY, display);
+    drawRadarOverlay(overlayFrame, lightenPhase);
+    drawRadarDecorations(centerLat, centerLon);
   }
 
   zoomLevel = previousZoom;
@@ -136,6 +318,7 @@ void renderRadarOverlayImage(int yOffset) {
     return;
   }
   const int bytesPerRow = RADAR_IMAGE_WIDTH / 8;
+  bool direct = isDisplayBufferDirect();
 
   for (int y = 0; y < RADAR_IMAGE_HEIGHT; y++) {
     int screenY = y + yOffset;
@@ -143,6 +326,11 @@ void renderRadarOverlayImage(int yOffset) {
       continue;
     }
 
+    if (direct) {
+      displayComposeRow(screenY, frameData + y * bytesPerRow, -1);
+      continue;
+    }
+
     int rowOffset = y * bytesPerRow;
     for (int x = 0; x < RADAR_IMAGE_WIDTH; x++) {
       int byteIndex = rowOffset + (x / 8);
@@ -376,7 +564,7 @@ void renderRadarPage() {
     drawStatusBar();
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void updateRadarPage() {
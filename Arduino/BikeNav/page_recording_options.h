@@ -5,12 +5,14 @@
 #include <U8g2_for_Adafruit_GFX.h>
 #include <TinyGPS++.h>
 #include <time.h>
+#include "spi_bus.h"
 #include "notification_system.h"
 #include "status_bar.h"
 #include "bitmaps.h"
 
 // External references
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -93,6 +95,7 @@ void getRecordingName(char* outName, size_t maxLen) {
   baseName[sizeof(baseName) - 1] = '\0';
 
   int suffix = 1;
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   while (true) {
     // Check if directory exists on SD card
     char checkPath[96];
@@ -534,7 +537,7 @@ void renderRecordingOptionsPage() {
     // --- NOTIFICATION OVERLAY ---
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void updateRecordingOptionsPage() {
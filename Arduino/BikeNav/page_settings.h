@@ -7,6 +7,7 @@
 #include "bitmaps.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -610,7 +611,7 @@ void renderSettingsPage() {
       renderBTDialog();
     }
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // --- UPDATE FUNCTION (for animations) ---
@@ -8,6 +8,7 @@
 #include "status_bar.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -587,7 +588,7 @@ void renderSnakeMenu() {
 
     drawStatusBar();
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void renderSnakeGame() {
@@ -610,7 +611,7 @@ void renderSnakeGame() {
     drawSnakeContinuous();
 
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void renderSnakeGameOver() {
@@ -695,7 +696,7 @@ void renderSnakeGameOver() {
     // Menu button (not shown for now - just play again)
 
     drawNotificationOverlay();
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 // --- PAGE INTERFACE FUNCTIONS ---
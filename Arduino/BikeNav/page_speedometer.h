@@ -6,8 +6,12 @@
 #include <TinyGPS++.h>
 #include "notification_system.h"
 #include "status_bar.h"
+#include "glyph_cache.h"
+#include "panel_diff.h"
+#include "frame_scheduler.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -371,7 +375,7 @@ void renderSpeedometerPage() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void drawSpeedometerSplitOverlay() {
@@ -396,24 +400,18 @@ void drawSpeedometerSplitOverlay() {
   const char* unitText = "km/h";
   const int unitPadding = 4;
 
-  u8g2_display.setFont(u8g2_font_fub30_tn);
-  int speedWidth = u8g2_display.getUTF8Width(speedText);
-  u8g2_display.setFont(u8g2_font_helvB08_tf);
-  int unitWidth = u8g2_display.getUTF8Width(unitText);
+  int speedWidth = glyphTextWidth(GLYPH_FONT_FUB30, speedText);
+  int unitWidth = glyphTextWidth(GLYPH_FONT_HELVB08, unitText);
 
   int totalWidth = speedWidth + unitPadding + unitWidth;
   int speedX = (DISPLAY_WIDTH - totalWidth) / 2;
   int speedY = SPEEDOMETER_SPLIT_HEIGHT - 4;
 
-  u8g2_display.setFont(u8g2_font_fub30_tn);
-  u8g2_display.setCursor(speedX, speedY);
-  u8g2_display.print(speedText);
+  drawGlyphText(GLYPH_FONT_FUB30, speedX, speedY, speedText);
 
-  u8g2_display.setFont(u8g2_font_helvB08_tf);
   int unitX = speedX + speedWidth + unitPadding;
   int unitY = speedY;
-  u8g2_display.setCursor(unitX, unitY);
-  u8g2_display.print(unitText);
+  drawGlyphText(GLYPH_FONT_HELVB08, unitX, unitY, unitText);
 
   if (!gpsValid || !gps.speed.isValid()) {
     u8g2_display.setFont(u8g2_font_helvB08_tf);
@@ -432,16 +430,18 @@ void renderSpeedometerSplitOverlay() {
     if (currentNotification.visible) {
       drawNotificationOverlay();
     }
-  } while (display.nextPage());
+  } while (nextDisplayPage());
+  invalidatePanelShadowRows(0, SPEEDOMETER_SPLIT_HEIGHT);
 }
 
 void updateSpeedometerPage() {
   bool gpsDialogChanged = updateSpeedometerData();
 
+  // Live speed re-renders the page once per navigation frame slot
   if (gpsValid && gps.speed.isValid()) {
-    renderSpeedometerPage();
+    submitFrame(FRAME_REGION_PAGE, FRAME_PRIORITY_NAVIGATION);
   } else if (!gpsValid && gpsDialogChanged) {
-    renderSpeedometerPage();
+    submitFrame(FRAME_REGION_PAGE, FRAME_PRIORITY_NAVIGATION);
   }
 
   // Let the status bar handle its own smart refresh
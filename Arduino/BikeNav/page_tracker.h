@@ -4,11 +4,13 @@
 #include <GxEPD2_BW.h>
 #include <U8g2_for_Adafruit_GFX.h>
 #include <SD.h>
+#include "spi_bus.h"
 #include "notification_system.h"
 #include "status_bar.h"
 #include "bitmaps.h"
 
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -35,6 +37,7 @@ int lastRecordingCount = -1;
 
 // Count recordings on SD card
 int countRecordingsOnSD() {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   File recordingsDir = SD.open("/Recordings");
   if (!recordingsDir) return 0;
 
@@ -53,6 +56,7 @@ int countRecordingsOnSD() {
 
 // Get recording name by index (reads from metadata JSON)
 bool getRecordingNameByIndex(int index, char* outName, size_t maxLen) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   File recordingsDir = SD.open("/Recordings");
   if (!recordingsDir) return false;
 
@@ -109,6 +113,7 @@ bool getRecordingNameByIndex(int index, char* outName, size_t maxLen) {
 }
 
 bool getRecordingDirNameByIndex(int index, char* outName, size_t maxLen) {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   File recordingsDir = SD.open("/Recordings");
   if (!recordingsDir) return false;
 
@@ -365,7 +370,7 @@ void renderTrackerPage() {
     // --- NOTIFICATION OVERLAY ---
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 }
 
 void updateTrackerPage() {
@@ -4,12 +4,14 @@
 #include <GxEPD2_BW.h>
 #include <U8g2_for_Adafruit_GFX.h>
 #include <SD.h>
+#include "spi_bus.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 
 // External references from main program
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -249,7 +251,7 @@ void renderTripsPage() {
     // Draw notification overlay
     drawNotificationOverlay();
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 
   tripsNeedsRedraw = false;
 }
@@ -408,6 +410,7 @@ static int compareTripsByCreatedAtDesc(const void* left, const void* right) {
 }
 
 void refreshTripsCache() {
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
   cachedTripCount = countTripsOnSD();
 
   cachedTripsOnPage = 0;
@@ -0,0 +1,141 @@
+#ifndef PANEL_BUSY_H
+#define PANEL_BUSY_H
+
+#include <Arduino.h>
+#include "display_buffer.h"
+#include "spi_bus.h"
+
+// External references from BikeNav.ino
+extern void readGPSSerial();
+
+// --- PANEL BUSY OVERLAP ---
+// A panel update is an SPI transfer of the window (a few ms) followed by the
+// waveform (hundreds of ms), during which GxEPD2 polls the BUSY pin with
+// delay(1) and loop() stands still: no GPS parsing, the UART FIFO fills up
+// and a whole refresh worth of NMEA is parsed in one burst afterwards.
+// GxEPD2 has no asynchronous flush, but it calls a busy callback on every
+// poll. The callback here does the loop() work that cannot touch the panel
+// or the SD card (both share the SPI bus) - GPS parsing and position
+// tracking - and then sleeps until the BUSY falling edge interrupt or the
+// next slice instead of burning delay(1). The render task on the other core
+// keeps composing the next frame in the meantime. A flush holding the SPI
+// bus (spi_bus.h) lends it to waiting SD clients for the sleep.
+// Service gaps (time between two chances to run that work) are kept as a
+// histogram per mode while a flush is in progress.
+#define PANEL_BUSY_SLICE_MS 2           // Longest sleep between two GPS drains
+#define PANEL_GAP_BUCKETS 10
+
+const unsigned long PANEL_GAP_BUCKET_MS[PANEL_GAP_BUCKETS - 1] = {1, 2, 5, 10, 20, 50, 100, 200, 500};
+
+struct PanelGapHistogram {
+  unsigned long counts[PANEL_GAP_BUCKETS];
+  unsigned long flushes;
+  unsigned long maxGapUs;
+  unsigned long gpsPolls;        // Busy callbacks that drained the GPS UART
+};
+
+struct PanelBusyState {
+  bool overlap;                  // Busy callback installed
+  bool inFlush;
+  TaskHandle_t waiter;           // Task blocked in the busy callback
+  unsigned long lastServiceUs;
+  unsigned long wakeups;         // BUSY falling edges
+  PanelGapHistogram blocking;    // delay(1) polling inside GxEPD2
+  PanelGapHistogram overlapped;
+};
+
+PanelBusyState panelBusy = {false, false, nullptr, 0, 0};
+
+static inline PanelGapHistogram& activePanelGapHistogram() {
+  return panelBusy.overlap ? panelBusy.overlapped : panelBusy.blocking;
+}
+
+static void recordPanelServiceGap() {
+  unsigned long now = micros();
+  unsigned long gapUs = now - panelBusy.lastServiceUs;
+  panelBusy.lastServiceUs = now;
+
+  PanelGapHistogram& h = activePanelGapHistogram();
+  int bucket = 0;
+  while (bucket < PANEL_GAP_BUCKETS - 1 && gapUs >= PANEL_GAP_BUCKET_MS[bucket] * 1000) bucket++;
+  h.counts[bucket]++;
+  if (gapUs > h.maxGapUs) h.maxGapUs = gapUs;
+}
+
+void IRAM_ATTR panelBusyISR() {
+  panelBusy.wakeups++;
+  TaskHandle_t waiter = panelBusy.waiter;
+  if (!waiter) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(waiter, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// Called by GxEPD2 from _waitWhileBusy() on every BUSY poll
+static void panelBusyCallback(const void* parameter) {
+  (void)parameter;
+  if (panelBusy.inFlush) recordPanelServiceGap();
+
+  readGPSSerial();
+  activePanelGapHistogram().gpsPolls++;
+
+  bool lent = lendSpiBus();
+  panelBusy.waiter = xTaskGetCurrentTaskHandle();
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PANEL_BUSY_SLICE_MS));
+  panelBusy.waiter = nullptr;
+  if (lent) reclaimSpiBus();  // GxEPD2 transfers again once BUSY falls
+}
+
+// Install (or remove) the busy callback; without it GxEPD2 polls with delay(1)
+void setPanelBusyOverlap(bool enabled) {
+  panelBusy.overlap = enabled;
+  display.epd2.setBusyCallback(enabled ? panelBusyCallback : nullptr, nullptr);
+}
+
+/**
+ * Call once after display.init(): BUSY falls when the waveform is done,
+ * the interrupt wakes the loop task sleeping in the busy callback.
+ */
+void initPanelBusyOverlap(int busyPin) {
+  attachInterrupt(digitalPinToInterrupt(busyPin), panelBusyISR, FALLING);
+  setPanelBusyOverlap(true);
+  Serial.printf("[PANEL] Busy overlap on (BUSY pin %d, %d ms slices)\n", busyPin, PANEL_BUSY_SLICE_MS);
+}
+
+// Bracket the displayWindow() calls of a flush
+void beginPanelBusyWindow() {
+  panelBusy.inFlush = true;
+  panelBusy.lastServiceUs = micros();
+}
+
+void endPanelBusyWindow() {
+  recordPanelServiceGap();
+  panelBusy.inFlush = false;
+  activePanelGapHistogram().flushes++;
+}
+
+static void printPanelGapHistogram(const char* label, const PanelGapHistogram& h) {
+  unsigned long total = 0;
+  for (int i = 0; i < PANEL_GAP_BUCKETS; i++) total += h.counts[i];
+  Serial.printf("%s: %lu flushes, %lu gaps, %lu GPS polls, longest gap %lu ms\n",
+                label, h.flushes, total, h.gpsPolls, h.maxGapUs / 1000);
+  if (!total) return;
+  for (int i = 0; i < PANEL_GAP_BUCKETS; i++) {
+    if (!h.counts[i]) continue;
+    if (i < PANEL_GAP_BUCKETS - 1) {
+      Serial.printf("  < %4lu ms  %6lu  (%.0f%%)\n", PANEL_GAP_BUCKET_MS[i], h.counts[i], 100.0f * h.counts[i] / total);
+    } else {
+      Serial.printf(" >= %4lu ms  %6lu  (%.0f%%)\n", PANEL_GAP_BUCKET_MS[i - 1], h.counts[i], 100.0f * h.counts[i] / total);
+    }
+  }
+}
+
+void printPanelBusyStats() {
+  Serial.println("=== PANEL BUSY GAPS ===");
+  Serial.printf("Overlap %s, BUSY wakeups: %lu\n", panelBusy.overlap ? "on" : "off", panelBusy.wakeups);
+  printPanelGapHistogram("Blocking", panelBusy.blocking);
+  printPanelGapHistogram("Overlapped", panelBusy.overlapped);
+  Serial.println("=======================");
+}
+
+#endif // PANEL_BUSY_H
@@ -0,0 +1,288 @@
+#ifndef PANEL_DIFF_H
+#define PANEL_DIFF_H
+
+#include <Arduino.h>
+#include "display_buffer.h"
+#include "panel_busy.h"
+
+// External references from BikeNav.ino
+extern const int DISPLAY_WIDTH;
+extern const int DISPLAY_HEIGHT;
+
+// External map view state from page_map.h / map_render_task.h
+extern bool isMapViewShown();
+extern bool isMapRenderInFlight();
+
+// --- DIFFERENTIAL PANEL UPDATES ---
+// Map frames are drawn into the full-screen framebuffer, but an update
+// often changes only a band of it (info bar distance, marker, notification).
+// The last frame pushed is kept as a shadow of the panel. A new frame is
+// compared with it one 32-bit word at a time, and only the rectangles that
+// changed are written and refreshed through displayWindow().
+// Every window costs a panel waveform of its own, whatever its size, so
+// neighbouring rectangles are merged whenever one larger window is cheaper.
+// On this panel a whole frame transfers faster than one waveform runs, so
+// changes end up in a single bounding window; the gain is the skipped
+// unchanged frames and the smaller transfer.
+// Any update that bypasses flushDisplayDiff() must invalidate the shadow:
+// all of it (other pages) or the rows it rewrote (partial windows).
+#define PANEL_DIFF_WORDS_PER_ROW (DISPLAY_BUFFER_ROW_BYTES / 4)   // 32 px per word
+#define PANEL_DIFF_MAX_RECTS 8
+#define PANEL_WRITE_PASSES 2             // Window is written to both controller RAMs (fast partial update)
+#define PANEL_REFRESH_COST_BYTES 16384   // Fixed cost of one window refresh in SPI byte equivalents (waveform >> transfer)
+
+struct PanelRect {
+  int x0, y0, x1, y1;   // Logical pixels, [x0, x1) x [y0, y1), x multiple of 32
+};
+
+struct PanelShadow {
+  uint8_t* bits;        // Last frame pushed, framebuffer layout, PSRAM
+  bool valid;
+  int unknownTop;       // Rows [unknownTop, unknownBottom) rewritten by other updates
+  int unknownBottom;
+};
+
+struct PanelDiffStats {
+  unsigned long updates;       // Flushes that pushed at least one window
+  unsigned long skipped;       // Frames identical to what the panel shows
+  unsigned long fullUpdates;   // Shadow invalid, whole screen pushed
+  unsigned long windows;
+  unsigned long bytesPushed;
+  unsigned long bytesFullEquivalent;   // What full-screen pushes would have sent
+  unsigned long busyUs;        // Inside displayWindow(): SPI transfer + panel refresh
+  unsigned long busyMaxUs;
+};
+
+PanelShadow panelShadow = {nullptr, false, 0, 0};
+PanelDiffStats panelDiffStats = {0};
+
+// The panel no longer shows the shadow (other page, init, sleep screen)
+void invalidatePanelShadow() {
+  panelShadow.valid = false;
+}
+
+// A partial window update outside flushDisplayDiff() rewrote these rows
+void invalidatePanelShadowRows(int y, int height) {
+  int bottom = y + height;
+  if (panelShadow.unknownTop >= panelShadow.unknownBottom) {
+    panelShadow.unknownTop = y;
+    panelShadow.unknownBottom = bottom;
+    return;
+  }
+  if (y < panelShadow.unknownTop) panelShadow.unknownTop = y;
+  if (bottom > panelShadow.unknownBottom) panelShadow.unknownBottom = bottom;
+}
+
+static inline unsigned long panelRectBytes(const PanelRect& r) {
+  return (unsigned long)(r.x1 - r.x0) / 8 * (r.y1 - r.y0) * PANEL_WRITE_PASSES;
+}
+
+static inline unsigned long panelRectCost(const PanelRect& r) {
+  return panelRectBytes(r) + PANEL_REFRESH_COST_BYTES;
+}
+
+static PanelRect unionPanelRects(const PanelRect& a, const PanelRect& b) {
+  PanelRect u;
+  u.x0 = min(a.x0, b.x0);
+  u.y0 = min(a.y0, b.y0);
+  u.x1 = max(a.x1, b.x1);
+  u.y1 = max(a.y1, b.y1);
+  return u;
+}
+
+/**
+ * Changed rectangles between the framebuffer and the shadow: runs of
+ * changed rows, each as wide as the changed words in it. Returns the count;
+ * more runs than maxRects merge into the last one.
+ */
+static int collectPanelDiffRects(const uint8_t* frame, PanelRect* rects, int maxRects) {
+  int count = 0;
+  bool inRun = false;
+
+  for (int y = 0; y < DISPLAY_BUFFER_ROWS; y++) {
+    int physicalRow = DISPLAY_BUFFER_ROWS - 1 - y;
+    const uint8_t* now = frame + physicalRow * DISPLAY_BUFFER_ROW_BYTES;
+    const uint8_t* was = panelShadow.bits + physicalRow * DISPLAY_BUFFER_ROW_BYTES;
+    bool unknown = y >= panelShadow.unknownTop && y < panelShadow.unknownBottom;
+
+    int firstWord = PANEL_DIFF_WORDS_PER_ROW;
+    int lastWord = -1;
+    for (int w = 0; w < PANEL_DIFF_WORDS_PER_ROW; w++) {
+      uint32_t a, b;
+      memcpy(&a, now + w * 4, 4);  // Buffer sits inside the display object, alignment unknown
+      memcpy(&b, was + w * 4, 4);
+      if (a == b && !unknown) continue;
+      // Physical word w holds logical x = 128 - 32 (w + 1) .. 128 - 32 w - 1
+      int logicalWord = PANEL_DIFF_WORDS_PER_ROW - 1 - w;
+      if (logicalWord < firstWord) firstWord = logicalWord;
+      if (logicalWord > lastWord) lastWord = logicalWord;
+    }
+
+    if (lastWord < 0) {
+      inRun = false;
+      continue;
+    }
+    if (inRun) {
+      PanelRect& r = rects[count - 1];
+      r.x0 = min(r.x0, firstWord * 32);
+      r.x1 = max(r.x1, (lastWord + 1) * 32);
+      r.y1 = y + 1;
+      continue;
+    }
+    if (count == maxRects) {
+      // Out of slots: grow the last rectangle over this run
+      PanelRect& r = rects[count - 1];
+      r.x0 = min(r.x0, firstWord * 32);
+      r.x1 = max(r.x1, (lastWord + 1) * 32);
+      r.y1 = y + 1;
+    } else {
+      rects[count++] = {firstWord * 32, y, (lastWord + 1) * 32, y + 1};
+    }
+    inRun = true;
+  }
+  return count;
+}
+
+/**
+ * Merge rectangles while one window over a pair costs less than the two:
+ * always merges the pair with the largest saving first.
+ */
+static int mergePanelRects(PanelRect* rects, int count) {
+  while (count > 1) {
+    long bestSaving = 0;
+    int bestA = -1, bestB = -1;
+    for (int a = 0; a < count; a++) {
+      for (int b = a + 1; b < count; b++) {
+        PanelRect u = unionPanelRects(rects[a], rects[b]);
+        long saving = (long)(panelRectCost(rects[a]) + panelRectCost(rects[b])) - (long)panelRectCost(u);
+        if (saving > bestSaving) {
+          bestSaving = saving;
+          bestA = a;
+          bestB = b;
+        }
+      }
+    }
+    if (bestA < 0) break;
+    rects[bestA] = unionPanelRects(rects[bestA], rects[bestB]);
+    rects[bestB] = rects[--count];
+  }
+  return count;
+}
+
+/**
+ * Push a finished full-screen frame (setPartialWindow(0, 0, W, H), drawn
+ * after firstPage() - instead of the nextPage() loop). Only the changed
+ * rectangles are written and refreshed; an unchanged frame is not pushed
+ * at all. Returns true when the panel was updated.
+ */
+bool flushDisplayDiff() {
+  uint8_t* frame = getDisplayBuffer();
+  const size_t frameBytes = DISPLAY_BUFFER_ROW_BYTES * DISPLAY_BUFFER_ROWS;
+  const unsigned long fullBytes = frameBytes * PANEL_WRITE_PASSES;
+
+  if (!panelShadow.bits) {
+    panelShadow.bits = (uint8_t*)ps_malloc(frameBytes);
+    if (!panelShadow.bits) Serial.println("[PANEL] ERROR: Failed to allocate panel shadow, pushing full frames");
+    panelShadow.valid = false;
+  }
+
+  PanelRect rects[PANEL_DIFF_MAX_RECTS];
+  int count;
+  bool full = !panelShadow.bits || !panelShadow.valid || !isDisplayBufferDirect();
+  if (full) {
+    rects[0] = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+    count = 1;
+  } else {
+    count = mergePanelRects(rects, collectPanelDiffRects(frame, rects, PANEL_DIFF_MAX_RECTS));
+  }
+
+  panelShadow.unknownTop = panelShadow.unknownBottom = 0;
+  if (count == 0) {
+    panelDiffStats.skipped++;
+#if BIKENAV_DEBUG_COMMANDS
+    Serial.println("[PANEL] Frame unchanged, no refresh");
+#endif
+    return false;
+  }
+
+  unsigned long bytes = 0;
+  acquireSpiBus(SPI_CLIENT_DISPLAY);
+  unsigned long start = micros();
+  beginPanelBusyWindow();
+  for (int i = 0; i < count; i++) {
+    display.displayWindow(rects[i].x0, rects[i].y0, rects[i].x1 - rects[i].x0, rects[i].y1 - rects[i].y0);
+    bytes += panelRectBytes(rects[i]);
+  }
+  endPanelBusyWindow();
+  unsigned long busyUs = micros() - start;
+  releaseSpiBus();
+
+  if (panelShadow.bits) {
+    memcpy(panelShadow.bits, frame, frameBytes);
+    panelShadow.valid = isDisplayBufferDirect();
+  }
+
+  panelDiffStats.updates++;
+  if (full) panelDiffStats.fullUpdates++;
+  panelDiffStats.windows += count;
+  panelDiffStats.bytesPushed += bytes;
+  panelDiffStats.bytesFullEquivalent += fullBytes;
+  panelDiffStats.busyUs += busyUs;
+  if (busyUs > panelDiffStats.busyMaxUs) panelDiffStats.busyMaxUs = busyUs;
+
+#if BIKENAV_DEBUG_COMMANDS
+  Serial.printf("[PANEL] %s: %d window(s), first %d,%d %dx%d, %lu/%lu bytes, busy %lu ms\n",
+                full ? "full" : "diff", count, rects[0].x0, rects[0].y0,
+                rects[0].x1 - rects[0].x0, rects[0].y1 - rects[0].y0, bytes, fullBytes, busyUs / 1000);
+#endif
+  return true;
+}
+
+void printPanelDiffStats() {
+  const PanelDiffStats& s = panelDiffStats;
+  Serial.println("=== PANEL UPDATES ===");
+  Serial.printf("Updates: %lu (%lu full), unchanged frames skipped: %lu, windows: %lu\n",
+                s.updates, s.fullUpdates, s.skipped, s.windows);
+  Serial.printf("SPI bytes: %lu of %lu full-frame (%.0f%%)\n", s.bytesPushed, s.bytesFullEquivalent,
+                s.bytesFullEquivalent ? 100.0f * s.bytesPushed / s.bytesFullEquivalent : 0.0f);
+  Serial.printf("Panel busy: avg %lu ms, max %lu ms\n",
+                s.updates ? s.busyUs / s.updates / 1000 : 0, s.busyMaxUs / 1000);
+  Serial.println("=====================");
+}
+
+#if BIKENAV_DEBUG_COMMANDS
+/**
+ * Debug: push the map frame on screen as full-screen updates, first with
+ * GxEPD2's own busy polling, then with the busy callback, and print the
+ * service gap histograms of both passes (they restart from zero). Leaves
+ * the overlap setting as it was.
+ */
+void benchmarkPanelBusyOverlap() {
+  const int flushesPerPass = 6;
+
+  if (!isMapViewShown() || isMapRenderInFlight()) {
+    Serial.println("[PANEL] Benchmark: open the map view and wait for its frame first");
+    return;
+  }
+
+  bool savedOverlap = panelBusy.overlap;
+  memset(&panelBusy.blocking, 0, sizeof(panelBusy.blocking));
+  memset(&panelBusy.overlapped, 0, sizeof(panelBusy.overlapped));
+
+  for (int pass = 0; pass < 2; pass++) {
+    setPanelBusyOverlap(pass == 1);
+    unsigned long start = millis();
+    for (int i = 0; i < flushesPerPass; i++) {
+      invalidatePanelShadow();  // Whole frame: transfer plus a full window waveform
+      flushDisplayDiff();
+    }
+    Serial.printf("[PANEL] Benchmark %s: %d flushes in %lu ms\n",
+                  pass == 1 ? "overlapped" : "blocking", flushesPerPass, millis() - start);
+  }
+  printPanelBusyStats();
+
+  setPanelBusyOverlap(savedOverlap);
+}
+#endif // BIKENAV_DEBUG_COMMANDS
+
+#endif // PANEL_DIFF_H
@@ -10,6 +10,7 @@
 #include <math.h> // Required for sqrt in noise generation
 #include <esp_random.h> // Use the ESP32 Hardware True Random Number Generator
 #include <SPI.h>
+#include "spi_bus.h"
 #include <esp_bt.h>
 #include <BLEDevice.h>
 #if defined(__has_include)
@@ -25,6 +26,7 @@
 
 // External references for display and UI
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -272,7 +274,7 @@ void renderShutdownScreen() {
 
     u8g2_display.setCursor(textX, textY);
     u8g2_display.print(shutdownMsg);
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 
   // Brief pause to show the message
   delay(800);
@@ -320,7 +322,7 @@ void renderShutdownScreen() {
     u8g2_display.setCursor((DISPLAY_WIDTH - msgWidth) / 2, boxY + boxHeight - 10);
     u8g2_display.print(wakeMsg);
 
-  } while (display.nextPage());
+  } while (nextDisplayPage());
 
   Serial.println("Shutdown screen rendered with procedural noise and Floyd-Steinberg dithering");
 }
@@ -420,6 +422,7 @@ void goToDeepSleep() {
   // This completely cuts power to the display controller (lowest power mode)
   // The e-ink screen will retain the shutdown image without any power
   Serial.println("Powering off e-paper display...");
+  acquireSpiBus(SPI_CLIENT_DISPLAY);  // Kept until sleep: no SD or panel traffic from other tasks
   display.powerOff();
   Serial.println("Display powered off");
 
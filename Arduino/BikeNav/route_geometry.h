@@ -0,0 +1,406 @@
+#ifndef ROUTE_GEOMETRY_H
+#define ROUTE_GEOMETRY_H
+
+#include <Arduino.h>
+#include <math.h>
+
+// Requires TrackPoint (map_trips.h)
+
+// --- ROUTE GEOMETRY ---
+// Track points projected once into integer world pixels two zooms finer
+// than the finest map zoom (quarter pixels at z18, still fits int32). Every map
+// zoom is a scale away, so zoom changes cost nothing and per-frame route
+// drawing needs no trig or double math.
+// Built once per loaded track and kept in PSRAM until the track is freed.
+#define ROUTE_PROJECTION_ZOOM 20     // ZOOM_LEVELS[0] + 2 sub-pixel bits
+#define ROUTE_GEOMETRY_SLOTS 2       // Navigation track + trip preview track
+
+// Level of detail: one simplified point list per map zoom, level 0 = z18
+// down to level 9 = z9 (same order as ZOOM_LEVELS). Level l keeps every
+// point needed to stay within one screen pixel of the full track at its
+// zoom, which is 2^(l + 2) projection units.
+#define ROUTE_LOD_LEVELS 10
+#define ROUTE_LOD_FINEST_ZOOM 18
+
+// Spatial index: bounding boxes of fixed runs of track segments (chunks),
+// and of runs of chunks (blocks). A viewport query tests every block, then
+// the chunks of the blocks it hits, so its cost follows what is on screen.
+#define ROUTE_CHUNK_SEGMENTS 32
+#define ROUTE_BLOCK_CHUNKS 32
+#define ROUTE_MAX_RUNS 64            // Visible point ranges per query (extra ranges merge)
+
+struct RoutePoint {
+  int32_t x;   // World pixel at ROUTE_PROJECTION_ZOOM
+  int32_t y;
+};
+
+struct RouteBox {
+  int32_t minX, minY, maxX, maxY;   // Projection units, inclusive
+};
+
+struct RouteRun {
+  int first, last;                  // Track point index range
+};
+
+struct RouteGeometry {
+  const TrackPoint* track;   // Track this geometry belongs to (nullptr = free slot)
+  int count;
+  RoutePoint* points;        // PSRAM, one per track point
+  int32_t* lodIndex[ROUTE_LOD_LEVELS];   // Kept point indices per level, ascending (one PSRAM block)
+  int lodCount[ROUTE_LOD_LEVELS];
+  RouteBox* chunkBoxes;              // PSRAM, chunks then blocks in one block
+  RouteBox* blockBoxes;
+  int chunkCount;
+  int blockCount;
+};
+
+RouteGeometry routeGeometrySlots[ROUTE_GEOMETRY_SLOTS] = {};
+int routeGeometryNextSlot = 0;
+
+// Web Mercator world pixel at ROUTE_PROJECTION_ZOOM (fractional)
+void projectRouteWorld(double lat, double lon, double* x, double* y) {
+  double worldSize = ldexp(256.0, ROUTE_PROJECTION_ZOOM);
+  double latRad = lat * M_PI / 180.0;
+  *x = (lon + 180.0) / 360.0 * worldSize;
+  *y = (1.0 - asinh(tan(latRad)) / M_PI) / 2.0 * worldSize;
+}
+
+static void freeRouteGeometry(RouteGeometry* geometry) {
+  if (geometry->points) free(geometry->points);
+  if (geometry->lodIndex[0]) free(geometry->lodIndex[0]);
+  if (geometry->chunkBoxes) free(geometry->chunkBoxes);
+  memset(geometry, 0, sizeof(RouteGeometry));
+}
+
+// Distance (projection units) of point p from segment a-b
+static float routeSegmentDistance(const RoutePoint& p, const RoutePoint& a, const RoutePoint& b) {
+  float dx = (float)(b.x - a.x);
+  float dy = (float)(b.y - a.y);
+  float px = (float)(p.x - a.x);
+  float py = (float)(p.y - a.y);
+  float lengthSq = dx * dx + dy * dy;
+  if (lengthSq > 0) {
+    float t = (px * dx + py * dy) / lengthSq;
+    if (t > 1.0f) {
+      px -= dx;
+      py -= dy;
+    } else if (t > 0) {
+      // Perpendicular distance, cross product in 64-bit to keep precision on long segments
+      int64_t cross = (int64_t)(p.x - a.x) * (b.y - a.y) - (int64_t)(p.y - a.y) * (b.x - a.x);
+      return fabsf((float)cross) / sqrtf(lengthSq);
+    }
+  }
+  return sqrtf(px * px + py * py);
+}
+
+/**
+ * Douglas-Peucker significance of every point: the largest tolerance at
+ * which the simplifier would still keep it. Capped by the parent split so
+ * a threshold on the value gives exactly the Douglas-Peucker result for
+ * that tolerance. Endpoints are always kept. Iterative (explicit stack).
+ */
+static bool computeRouteSignificance(const RoutePoint* points, int count, float* significance) {
+  struct Span { int32_t first, last; float cap; };
+  Span* stack = (Span*)ps_malloc(count * sizeof(Span));
+  if (!stack) return false;
+
+  for (int i = 0; i < count; i++) significance[i] = 0;
+  significance[0] = significance[count - 1] = 1e30f;
+
+  int top = 0;
+  stack[top++] = {0, count - 1, 1e30f};
+  while (top > 0) {
+    Span span = stack[--top];
+    if (span.last - span.first < 2) continue;
+
+    int split = -1;
+    float maxDistance = -1;
+    for (int i = span.first + 1; i < span.last; i++) {
+      float d = routeSegmentDistance(points[i], points[span.first], points[span.last]);
+      if (d > maxDistance) {
+        maxDistance = d;
+        split = i;
+      }
+    }
+
+    float value = maxDistance < span.cap ? maxDistance : span.cap;
+    significance[split] = value;
+    stack[top++] = {span.first, split, value};
+    stack[top++] = {split, span.last, value};
+  }
+
+  free(stack);
+  return true;
+}
+
+/**
+ * Build the per-zoom simplified index lists from the projected points.
+ */
+static bool buildRouteLod(RouteGeometry* geometry) {
+  int count = geometry->count;
+  float* significance = (float*)ps_malloc(count * sizeof(float));
+  if (!significance) return false;
+  if (!computeRouteSignificance(geometry->points, count, significance)) {
+    free(significance);
+    return false;
+  }
+
+  // Size all levels, then fill them from one block
+  int total = 0;
+  for (int level = 0; level < ROUTE_LOD_LEVELS; level++) {
+    float tolerance = ldexpf(1.0f, level + ROUTE_PROJECTION_ZOOM - ROUTE_LOD_FINEST_ZOOM);
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+      if (significance[i] > tolerance) kept++;
+    }
+    geometry->lodCount[level] = kept;
+    total += kept;
+  }
+
+  int32_t* block = (int32_t*)ps_malloc(total * sizeof(int32_t));
+  if (!block) {
+    free(significance);
+    return false;
+  }
+
+  for (int level = 0; level < ROUTE_LOD_LEVELS; level++) {
+    float tolerance = ldexpf(1.0f, level + ROUTE_PROJECTION_ZOOM - ROUTE_LOD_FINEST_ZOOM);
+    geometry->lodIndex[level] = block;
+    for (int i = 0; i < count; i++) {
+      if (significance[i] > tolerance) *block++ = i;
+    }
+  }
+
+  free(significance);
+  return true;
+}
+
+static void growRouteBox(RouteBox* box, const RouteBox& other) {
+  if (other.minX < box->minX) box->minX = other.minX;
+  if (other.minY < box->minY) box->minY = other.minY;
+  if (other.maxX > box->maxX) box->maxX = other.maxX;
+  if (other.maxY > box->maxY) box->maxY = other.maxY;
+}
+
+static inline bool routeBoxesOverlap(const RouteBox& a, const RouteBox& b) {
+  return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY;
+}
+
+// Chunk c covers points [c * ROUTE_CHUNK_SEGMENTS, (c + 1) * ROUTE_CHUNK_SEGMENTS]
+static bool buildRouteIndex(RouteGeometry* geometry) {
+  int segments = geometry->count - 1;
+  int chunks = segments > 0 ? (segments + ROUTE_CHUNK_SEGMENTS - 1) / ROUTE_CHUNK_SEGMENTS : 0;
+  int blocks = (chunks + ROUTE_BLOCK_CHUNKS - 1) / ROUTE_BLOCK_CHUNKS;
+  if (chunks == 0) return true;
+
+  RouteBox* boxes = (RouteBox*)ps_malloc((chunks + blocks) * sizeof(RouteBox));
+  if (!boxes) return false;
+  geometry->chunkBoxes = boxes;
+  geometry->blockBoxes = boxes + chunks;
+  geometry->chunkCount = chunks;
+  geometry->blockCount = blocks;
+
+  for (int c = 0; c < chunks; c++) {
+    int first = c * ROUTE_CHUNK_SEGMENTS;
+    int last = min(first + ROUTE_CHUNK_SEGMENTS, geometry->count - 1);
+    RouteBox box = {geometry->points[first].x, geometry->points[first].y,
+                    geometry->points[first].x, geometry->points[first].y};
+    for (int i = first + 1; i <= last; i++) {
+      RouteBox point = {geometry->points[i].x, geometry->points[i].y, geometry->points[i].x, geometry->points[i].y};
+      growRouteBox(&box, point);
+    }
+    geometry->chunkBoxes[c] = box;
+
+    if (c % ROUTE_BLOCK_CHUNKS == 0) {
+      geometry->blockBoxes[c / ROUTE_BLOCK_CHUNKS] = box;
+    } else {
+      growRouteBox(&geometry->blockBoxes[c / ROUTE_BLOCK_CHUNKS], box);
+    }
+  }
+  return true;
+}
+
+/**
+ * Point index ranges whose segments may intersect box, in track order.
+ * Adjacent visible chunks merge into one range; past ROUTE_MAX_RUNS the
+ * last range is extended (still a superset). Returns the range count.
+ */
+int queryRouteRuns(const RouteGeometry* geometry, const RouteBox& box, RouteRun* runs, int* chunksVisited) {
+  int runCount = 0;
+  *chunksVisited = 0;
+
+  for (int b = 0; b < geometry->blockCount; b++) {
+    if (!routeBoxesOverlap(geometry->blockBoxes[b], box)) continue;
+
+    int firstChunk = b * ROUTE_BLOCK_CHUNKS;
+    int lastChunk = min(firstChunk + ROUTE_BLOCK_CHUNKS, geometry->chunkCount);
+    for (int c = firstChunk; c < lastChunk; c++) {
+      (*chunksVisited)++;
+      if (!routeBoxesOverlap(geometry->chunkBoxes[c], box)) continue;
+
+      int first = c * ROUTE_CHUNK_SEGMENTS;
+      int last = min(first + ROUTE_CHUNK_SEGMENTS, geometry->count - 1);
+      if (runCount > 0 && (runs[runCount - 1].last >= first || runCount == ROUTE_MAX_RUNS)) {
+        runs[runCount - 1].last = last;
+      } else {
+        runs[runCount].first = first;
+        runs[runCount].last = last;
+        runCount++;
+      }
+    }
+  }
+  return runCount;
+}
+
+// Position in an LOD index list of the last kept point <= pointIndex
+int findRouteLodPosition(const int32_t* lodIndex, int lodCount, int pointIndex) {
+  int lo = 0;
+  int hi = lodCount - 1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (lodIndex[mid] <= pointIndex) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return lo;
+}
+
+// LOD level to draw at a map zoom (finer zooms use the finest level)
+int getRouteLodLevel(int zoom) {
+  int level = ROUTE_LOD_FINEST_ZOOM - zoom;
+  if (level < 0) return 0;
+  if (level >= ROUTE_LOD_LEVELS) return ROUTE_LOD_LEVELS - 1;
+  return level;
+}
+
+/**
+ * Project all points of a track and build its LOD pyramid.
+ * Returns false if PSRAM is exhausted.
+ */
+bool buildRouteGeometry(RouteGeometry* geometry, const TrackPoint* track, int count) {
+  freeRouteGeometry(geometry);
+
+  unsigned long start = millis();
+  geometry->points = (RoutePoint*)ps_malloc(count * sizeof(RoutePoint));
+  if (!geometry->points) {
+    Serial.printf("[ROUTE] ERROR: Failed to allocate geometry for %d points\n", count);
+    return false;
+  }
+
+  for (int i = 0; i < count; i++) {
+    double x, y;
+    projectRouteWorld(track[i].lat, track[i].lon, &x, &y);
+    geometry->points[i].x = (int32_t)x;
+    geometry->points[i].y = (int32_t)y;
+  }
+  geometry->track = track;
+  geometry->count = count;
+
+  if (!buildRouteLod(geometry) || !buildRouteIndex(geometry)) {
+    Serial.printf("[ROUTE] ERROR: Failed to build LOD/index for %d points\n", count);
+    freeRouteGeometry(geometry);
+    return false;
+  }
+
+  Serial.printf("[ROUTE] Projected %d points in %lu ms, LOD z%d..z%d: %d..%d points\n",
+                count, millis() - start, ROUTE_LOD_FINEST_ZOOM, ROUTE_LOD_FINEST_ZOOM - ROUTE_LOD_LEVELS + 1,
+                geometry->lodCount[0], geometry->lodCount[ROUTE_LOD_LEVELS - 1]);
+  return true;
+}
+
+/**
+ * Geometry for a loaded track, built on first use. A track moved from the
+ * trip preview to navigation keeps its geometry (same pointer).
+ */
+RouteGeometry* getRouteGeometry(const TrackPoint* track, int count) {
+  if (track == nullptr || count <= 0) return nullptr;
+
+  for (int i = 0; i < ROUTE_GEOMETRY_SLOTS; i++) {
+    if (routeGeometrySlots[i].track == track && routeGeometrySlots[i].count == count) {
+      return &routeGeometrySlots[i];
+    }
+  }
+
+  // Prefer a free slot, otherwise replace round-robin
+  int slot = -1;
+  for (int i = 0; i < ROUTE_GEOMETRY_SLOTS; i++) {
+    if (routeGeometrySlots[i].track == nullptr) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    slot = routeGeometryNextSlot;
+    routeGeometryNextSlot = (routeGeometryNextSlot + 1) % ROUTE_GEOMETRY_SLOTS;
+  }
+
+  if (!buildRouteGeometry(&routeGeometrySlots[slot], track, count)) return nullptr;
+  return &routeGeometrySlots[slot];
+}
+
+// Call before a track's memory is freed (a new track may reuse the address)
+void releaseRouteGeometry(const TrackPoint* track) {
+  for (int i = 0; i < ROUTE_GEOMETRY_SLOTS; i++) {
+    if (routeGeometrySlots[i].track == track) {
+      freeRouteGeometry(&routeGeometrySlots[i]);
+    }
+  }
+}
+
+// --- ROUTE VIEW TRANSFORM ---
+// Maps projected route points to screen pixels for one frame: integer
+// subtract against the view center, then one scaled rotation.
+struct RouteView {
+  int32_t centerX, centerY;   // View center, integer part (projection zoom pixels)
+  float fracX, fracY;         // View center, fractional part
+  float a, b;                 // cos/sin of the rotation, pre-scaled to the view zoom
+  float screenX, screenY;     // Screen position of the view center
+};
+
+/**
+ * Set up the transform for a view centered on lat/lon at zoom, rotated by
+ * rotationDeg around the screen point (screenX, screenY).
+ */
+void setupRouteView(RouteView* view, double centerLat, double centerLon, int zoom,
+                    int rotationDeg, float screenX, float screenY) {
+  double cx, cy;
+  projectRouteWorld(centerLat, centerLon, &cx, &cy);
+  view->centerX = (int32_t)floor(cx);
+  view->centerY = (int32_t)floor(cy);
+  view->fracX = (float)(cx - view->centerX);
+  view->fracY = (float)(cy - view->centerY);
+
+  float scale = ldexpf(1.0f, zoom - ROUTE_PROJECTION_ZOOM);
+  float rotationRad = rotationDeg * M_PI / 180.0;
+  view->a = cosf(rotationRad) * scale;
+  view->b = sinf(rotationRad) * scale;
+  view->screenX = screenX;
+  view->screenY = screenY;
+}
+
+inline void routePointToScreen(const RouteView* view, const RoutePoint& p, int* sx, int* sy) {
+  float relX = (float)(p.x - view->centerX) - view->fracX;
+  float relY = (float)(p.y - view->centerY) - view->fracY;
+  *sx = (int)floorf(relX * view->a - relY * view->b + view->screenX + 0.5f);
+  *sy = (int)floorf(relX * view->b + relY * view->a + view->screenY + 0.5f);
+}
+
+/**
+ * Projection-unit box covering an unrotated screen rect [minU, maxU] x
+ * [minV, maxV] (same frame as screenX/screenY, before rotation), grown by
+ * marginPx screen pixels on every side.
+ */
+RouteBox getRouteViewBox(const RouteView* view, int zoom, float minU, float minV,
+                         float maxU, float maxV, int marginPx) {
+  float unitsPerPixel = ldexpf(1.0f, ROUTE_PROJECTION_ZOOM - zoom);
+  RouteBox box;
+  box.minX = view->centerX + (int32_t)floorf(view->fracX + (minU - view->screenX - marginPx) * unitsPerPixel);
+  box.minY = view->centerY + (int32_t)floorf(view->fracY + (minV - view->screenY - marginPx) * unitsPerPixel);
+  box.maxX = view->centerX + (int32_t)ceilf(view->fracX + (maxU - view->screenX + marginPx) * unitsPerPixel);
+  box.maxY = view->centerY + (int32_t)ceilf(view->fracY + (maxV - view->screenY + marginPx) * unitsPerPixel);
+  return box;
+}
+
+#endif // ROUTE_GEOMETRY_H
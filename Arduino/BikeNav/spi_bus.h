@@ -0,0 +1,178 @@
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <Arduino.h>
+
+// --- SPI BUS ARBITER ---
+// The e-paper panel and the SD card share one SPI bus, used from three
+// tasks: loop() pushes panel updates and prefetches tiles, the map render
+// task reads tiles, the BLE task reads and writes tiles, trips and the
+// tile index. Instead of letting an SD.open() fail mid panel transfer and
+// retrying after delay(), every panel transfer (nextDisplayPage() in
+// display_buffer.h, flushDisplayDiff() in panel_diff.h) and every SD access
+// takes the bus here first and waits its turn. Waiters are served by
+// priority: a pending panel update goes before file access for what is on
+// screen, which goes before background SD work (BLE transfers, index
+// rebuilds).
+// While the panel runs its waveform the bus is idle; the busy callback
+// (panel_busy.h) lends it to waiting SD clients and takes it back before
+// GxEPD2 transfers again. Recursive per task. No-op before initSpiBus().
+enum SpiBusClient : uint8_t {
+  SPI_CLIENT_BACKGROUND = 0, // BLE transfers (reads and writes), index rebuilds
+  SPI_CLIENT_SD_READ = 1,    // Rendering and UI file access, tile prefetch
+  SPI_CLIENT_DISPLAY = 2,    // Panel updates
+  SPI_CLIENT_COUNT = 3
+};
+
+const char* const SPI_CLIENT_NAMES[SPI_CLIENT_COUNT] = {"background", "sd read", "display"};
+
+struct SpiBusClientStats {
+  unsigned long transactions;
+  unsigned long waited;          // Transactions that found the bus taken
+  unsigned long waitUs;
+  unsigned long maxWaitUs;
+};
+
+struct SpiBusState {
+  SemaphoreHandle_t mutex;
+  TaskHandle_t owner;
+  int depth;                     // Nested acquisitions by the owner
+  volatile int waiting[SPI_CLIENT_COUNT];
+  int lentDepth;                 // Owner depth saved while the bus is lent
+  unsigned long lends;           // Busy polls that handed the bus to SD clients
+  SpiBusClientStats stats[SPI_CLIENT_COUNT];
+};
+
+SpiBusState spiBus = {};
+portMUX_TYPE spiBusMux = portMUX_INITIALIZER_UNLOCKED;
+
+bool initSpiBus() {
+  if (spiBus.mutex) return true;
+  spiBus.mutex = xSemaphoreCreateMutex();
+  if (!spiBus.mutex) {
+    Serial.println("[SPI] ERROR: Failed to create bus mutex, bus unarbitrated");
+    return false;
+  }
+  return true;
+}
+
+static bool isSpiBusWantedAbove(SpiBusClient client) {
+  for (int c = client + 1; c < SPI_CLIENT_COUNT; c++) {
+    if (spiBus.waiting[c] > 0) return true;
+  }
+  return false;
+}
+
+static void adjustSpiBusWaiting(SpiBusClient client, int delta) {
+  portENTER_CRITICAL(&spiBusMux);
+  spiBus.waiting[client] += delta;
+  portEXIT_CRITICAL(&spiBusMux);
+}
+
+// Wait for the mutex until no higher-priority client waits; returns the wait
+static unsigned long takeSpiBus(SpiBusClient client) {
+  bool taken = xSemaphoreTake(spiBus.mutex, 0) == pdTRUE;
+  if (taken && !isSpiBusWantedAbove(client)) return 0;
+  if (taken) xSemaphoreGive(spiBus.mutex);  // Free, but a higher client goes first
+
+  unsigned long start = micros();
+  adjustSpiBusWaiting(client, 1);
+  while (true) {
+    xSemaphoreTake(spiBus.mutex, portMAX_DELAY);
+    if (!isSpiBusWantedAbove(client)) break;
+    xSemaphoreGive(spiBus.mutex);
+    vTaskDelay(1);
+  }
+  adjustSpiBusWaiting(client, -1);
+  return (micros() - start) | 1;
+}
+
+/**
+ * Take the bus for a transaction, waiting until it is free and no
+ * higher-priority client is waiting. Pair with releaseSpiBus().
+ */
+void acquireSpiBus(SpiBusClient client) {
+  if (!spiBus.mutex) return;
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  if (spiBus.owner == self) {
+    spiBus.depth++;
+    return;
+  }
+
+  unsigned long waitUs = takeSpiBus(client);
+  spiBus.owner = self;
+  spiBus.depth = 1;
+
+  SpiBusClientStats& s = spiBus.stats[client];
+  s.transactions++;
+  if (!waitUs) return;
+  s.waited++;
+  s.waitUs += waitUs;
+  if (waitUs > s.maxWaitUs) s.maxWaitUs = waitUs;
+}
+
+void releaseSpiBus() {
+  if (!spiBus.mutex || spiBus.owner != xTaskGetCurrentTaskHandle()) return;
+  if (--spiBus.depth > 0) return;
+  spiBus.owner = nullptr;
+  xSemaphoreGive(spiBus.mutex);
+}
+
+/**
+ * Panel waveform running: if this task holds the bus and SD clients wait,
+ * release it completely. Returns true when lent; the caller must call
+ * reclaimSpiBus() before anything transfers to the panel again.
+ */
+bool lendSpiBus() {
+  if (!spiBus.mutex || spiBus.owner != xTaskGetCurrentTaskHandle()) return false;
+  if (spiBus.waiting[SPI_CLIENT_BACKGROUND] == 0 && spiBus.waiting[SPI_CLIENT_SD_READ] == 0) return false;
+  spiBus.lentDepth = spiBus.depth;
+  spiBus.owner = nullptr;
+  spiBus.depth = 0;
+  spiBus.lends++;
+  xSemaphoreGive(spiBus.mutex);
+  return true;
+}
+
+// Same transaction, so no new one in the stats
+void reclaimSpiBus() {
+  takeSpiBus(SPI_CLIENT_DISPLAY);
+  spiBus.owner = xTaskGetCurrentTaskHandle();
+  spiBus.depth = spiBus.lentDepth;
+}
+
+/**
+ * For long SD walks holding the bus: if a higher-priority client waits,
+ * let it go first and take the bus back (at any nesting depth).
+ */
+void yieldSpiBus(SpiBusClient client) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  if (!spiBus.mutex || spiBus.owner != self || !isSpiBusWantedAbove(client)) return;
+  int depth = spiBus.depth;
+  spiBus.owner = nullptr;
+  spiBus.depth = 0;
+  xSemaphoreGive(spiBus.mutex);
+  takeSpiBus(client);
+  spiBus.owner = self;
+  spiBus.depth = depth;
+}
+
+// Holds the bus for a scope, for functions with several exits
+struct SpiBusTransaction {
+  explicit SpiBusTransaction(SpiBusClient client) { acquireSpiBus(client); }
+  ~SpiBusTransaction() { releaseSpiBus(); }
+};
+
+void printSpiBusStats() {
+  Serial.println("=== SPI BUS ===");
+  for (int c = SPI_CLIENT_COUNT - 1; c >= 0; c--) {
+    const SpiBusClientStats& s = spiBus.stats[c];
+    Serial.printf("%-10s  %lu transactions, %lu waited, avg wait %lu ms, max %lu ms\n",
+                  SPI_CLIENT_NAMES[c], s.transactions, s.waited,
+                  s.waited ? s.waitUs / s.waited / 1000 : 0, s.maxWaitUs / 1000);
+  }
+  Serial.printf("Lent to SD clients during panel waveforms: %lu times\n", spiBus.lends);
+  Serial.println("===============");
+}
+
+#endif // SPI_BUS_H
@@ -5,9 +5,13 @@
 #include <GxEPD2_BW.h>
 #include <U8g2_for_Adafruit_GFX.h>
 #include <TinyGPS++.h>
+#include "glyph_cache.h"
+#include "panel_diff.h"
+#include "frame_scheduler.h"
 
 // External references
 extern GxEPD2_BW<GxEPD2_290_BS, GxEPD2_290_BS::HEIGHT> display;
+extern bool nextDisplayPage();  // display_buffer.h: nextPage() holding the SPI bus
 extern U8G2_FOR_ADAFRUIT_GFX u8g2_display;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
@@ -280,11 +284,9 @@ void drawStatusBarInternal(bool drawSeparator) {
   drawSmallBatteryIcon(1, batteryIconY, batteryPercent, isCharging);
 
   // Draw battery percentage right after icon
-  u8g2_display.setCursor(23, percentTextY);  // 1 + 18 (width) + 2 (tip) + 2 (spacing)
-  u8g2_display.print(percentStr);
+  int percentWidth = drawGlyphText(GLYPH_FONT_HELVB08, 23, percentTextY, percentStr);  // 1 + 18 (width) + 2 (tip) + 2 (spacing)
 
   // === CENTER: GPS and BLE Icons ===
-  int percentWidth = u8g2_display.getUTF8Width(percentStr);
   int iconsStartX = 23 + percentWidth + 3;  // After battery % + spacing
 
   // Align icons with text baseline (same as battery icon)
@@ -310,12 +312,11 @@ void drawStatusBarInternal(bool drawSeparator) {
   }
 
   // Right-align time at the very edge
-  int textWidth = u8g2_display.getUTF8Width(timeStr);
+  int textWidth = glyphTextWidth(GLYPH_FONT_HELVB08, timeStr);
   int timeX = DISPLAY_WIDTH - textWidth - 1;  // 1px margin from right edge
   int timeY = statusBarY + STATUS_BAR_HEIGHT - 2;
 
-  u8g2_display.setCursor(timeX, timeY);
-  u8g2_display.print(timeStr);
+  drawGlyphText(GLYPH_FONT_HELVB08, timeX, timeY, timeStr);
 
   // Update state tracking after drawing
   if (gps.time.isValid() && gps.date.isValid()) {
@@ -503,10 +504,36 @@ void drawStatusBarExtras() {
 }
 
 /**
- * @brief Check if status bar needs refresh and perform partial update
+ * @brief Partial refresh of the status bar band (run by the frame scheduler)
+ */
+void refreshStatusBar() {
+  Serial.println("Status bar: Performing partial refresh");
+
+  int extrasHeight = statusBarHasExtras() ? WEATHER_STATUS_BAR_EXTRA_HEIGHT : 0;
+  int totalHeight = STATUS_BAR_HEIGHT + extrasHeight;
+  int statusY = DISPLAY_HEIGHT - totalHeight;
+  display.setPartialWindow(0, statusY, DISPLAY_WIDTH, totalHeight);
+
+  display.firstPage();
+  do {
+    // Clear status bar area
+    display.fillRect(0, statusY, DISPLAY_WIDTH, totalHeight, GxEPD_WHITE);
+
+    // Redraw status bar
+    if (extrasHeight > 0) {
+      drawStatusBarExtras();
+    }
+    drawStatusBar();
+
+  } while (nextDisplayPage());
+  invalidatePanelShadowRows(statusY, totalHeight);
+}
+
+/**
+ * @brief Check if status bar needs refresh and schedule a partial update
  * Call this from page update functions or main loop
  * @param forceUpdate If true, bypass user activity check (use when page is already re-rendering)
- * Returns true if refresh was performed
+ * Returns true if a refresh was scheduled
  */
 bool updateStatusBar(bool forceUpdate = false) {
   if (!statusBarState.initialized) {
@@ -580,28 +607,10 @@ bool updateStatusBar(bool forceUpdate = false) {
     Serial.printf("Status bar: GPS %s\n", currentGPSActive ? "active" : "inactive");
   }
 
-  // Perform partial refresh if needed
+  // Schedule a partial refresh if needed (merged with page refreshes by the frame scheduler)
   if (needsRefresh) {
-    Serial.println("Status bar: Performing partial refresh");
-
-    int extrasHeight = statusBarHasExtras() ? WEATHER_STATUS_BAR_EXTRA_HEIGHT : 0;
-    int totalHeight = STATUS_BAR_HEIGHT + extrasHeight;
-    int statusY = DISPLAY_HEIGHT - totalHeight;
-    display.setPartialWindow(0, statusY, DISPLAY_WIDTH, totalHeight);
-
-    display.firstPage();
-    do {
-      // Clear status bar area
-      display.fillRect(0, statusY, DISPLAY_WIDTH, totalHeight, GxEPD_WHITE);
-
-      // Redraw status bar
-      if (extrasHeight > 0) {
-        drawStatusBarExtras();
-      }
-      drawStatusBar();
-
-    } while (display.nextPage());
-
+    Serial.println("Status bar: Partial refresh requested");
+    submitFrame(FRAME_REGION_STATUS_BAR, FRAME_PRIORITY_STATUS);
     statusBarState.lastRefreshTime = currentTime;
     return true;
   }
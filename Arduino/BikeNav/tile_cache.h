@@ -4,25 +4,495 @@
 #include <Arduino.h>
 
 // --- TILE CACHE CONFIGURATION ---
-#define TILE_CACHE_SIZE 768      // Number of tiles to cache (768 tiles = 6MB)
 #define TILE_DATA_SIZE 8192      // Size of each tile in bytes (256x256 / 8)
+#define TILE_CACHE_COMPRESSED 1  // 1 = keep tiles RLE-compressed in PSRAM, 0 = store raw 8KB tiles
+#define TILE_CACHE_SIZE 4096     // Max number of cached tiles (entries); bytes are bounded by the slab arena
+#define TILE_CACHE_HASH_BUCKETS 8192  // Hash index buckets (power of two, >= 2x cache size)
+#define TILE_CACHE_NONE -1       // Null index for hash chains and LRU links
+
+// Slab arena: fixed-size pages carved into equal chunks of one size class each
+#define TILE_SLAB_PAGE_SIZE 8192
+#define TILE_SLAB_PAGES 768      // 768 pages x 8KB = 6MB (same budget as the old raw cache)
+#define TILE_SLAB_CLASSES 14
+#define TILE_SLAB_MASK_WORDS 4   // Up to 128 chunks per page (smallest class)
+
+// Tiles a raw cache of the same byte budget would hold (for hit-rate comparison)
+#define TILE_CACHE_RAW_CAPACITY ((TILE_SLAB_PAGES * TILE_SLAB_PAGE_SIZE) / TILE_DATA_SIZE)
+
+// Decoded tiles kept ready for rendering. A pointer returned by lookup/insert
+// stays valid for the next TILE_CACHE_DECODE_SLOTS - 1 lookups/inserts.
+#define TILE_CACHE_DECODE_SLOTS 6
+
+// Segmented LRU: route-corridor tiles live in a protected segment that browsing
+// cannot flush; everything else enters the probationary segment and is evicted first.
+#define TILE_CACHE_PROTECTED_PERCENT 75  // Max share of slab chunk bytes held by the protected segment
+
+// A commit that finds no free chunk evicts a few LRU tiles (which may empty a
+// page), then looks near the LRU end for a tile of its own size class, then gives up
+#define TILE_CACHE_COMMIT_EVICTIONS 8
+#define TILE_CACHE_COMMIT_SCAN 64
+
+enum TileCacheClass {
+  TILE_CLASS_BROWSE = 0,   // Map browsing, scrub, trip preview, radar page -> probationary
+  TILE_CLASS_ROUTE = 1     // Navigation redraws and route prefetch -> protected
+};
+#define TILE_CLASS_COUNT 2
+
+const uint16_t TILE_SLAB_CLASS_SIZE[TILE_SLAB_CLASSES] = {
+  64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 8192
+};
 
 // --- CACHE ENTRY STRUCTURE ---
 struct TileCacheEntry {
   int zoom;
   int tileX;
   int tileY;
-  unsigned long lastUsed;     // millis() timestamp for LRU tracking
+  unsigned long lastUsed;     // millis() timestamp (debug only, LRU order lives in the list)
+  uint32_t accessSeq;         // tileCacheAccessSeq at the last hit / insert
   bool valid;                 // Is this cache entry populated?
-  uint8_t* data;              // Pointer to tile data in PSRAM (8KB each)
+  bool compressed;            // data holds RLE (count, value) pairs, otherwise a raw tile
+  uint8_t slabClass;          // Size class of the slab chunk holding data
+  int8_t decodeSlot;          // Decode slot currently holding this tile, or -1
+  uint16_t storedSize;        // Bytes used in the slab chunk
+  uint8_t* data;              // Slab chunk in PSRAM
+  int32_t hashNext;           // Next entry in the same hash bucket (or free list)
+  int32_t lruPrev;            // Towards most recently used (global recency, for stats)
+  int32_t lruNext;            // Towards least recently used
+  uint8_t segment;            // TileCacheClass of the segment holding this entry
+  int32_t segPrev;            // Towards most recently used within the segment
+  int32_t segNext;            // Towards least recently used within the segment
+};
+
+// --- SLAB PAGE STRUCTURE ---
+struct TileSlabPage {
+  int8_t slabClass;           // -1 = page is free
+  uint8_t usedChunks;
+  int16_t next;               // Partial-page list of its class, or free-page list
+  int16_t prev;
+  uint32_t freeMask[TILE_SLAB_MASK_WORDS];  // 1 bit = free chunk
 };
 
 // --- GLOBAL CACHE STATE ---
 TileCacheEntry* tileCache = nullptr;       // Array of cache entries
-uint8_t* tileCacheData = nullptr;          // Contiguous block of tile data in PSRAM
+int32_t* tileCacheBuckets = nullptr;       // Hash bucket heads (entry index or TILE_CACHE_NONE)
+int32_t tileCacheLruHead = TILE_CACHE_NONE;  // Most recently used entry
+int32_t tileCacheLruTail = TILE_CACHE_NONE;  // Least recently used entry (next eviction)
+int32_t tileCacheFreeHead = TILE_CACHE_NONE; // Unused entries, linked through hashNext
 unsigned long cacheHits = 0;               // Statistics
 unsigned long cacheMisses = 0;
 unsigned long cacheEvictions = 0;
+unsigned long cacheRawEquivalentHits = 0;  // Hits a raw cache of the same budget would also have had
+unsigned long cacheClassHits[TILE_CLASS_COUNT];    // Per access class
+unsigned long cacheClassMisses[TILE_CLASS_COUNT];
+unsigned long cachePromotions = 0;         // Probationary -> protected
+unsigned long cacheDemotions = 0;          // Protected -> probationary (protected segment over budget)
+int32_t tileSegHead[TILE_CLASS_COUNT];     // Per-segment LRU lists
+int32_t tileSegTail[TILE_CLASS_COUNT];
+int tileSegCount[TILE_CLASS_COUNT];
+uint32_t tileSegChunkBytes[TILE_CLASS_COUNT];
+TileCacheClass tileCacheAccessClass = TILE_CLASS_BROWSE;  // Class of the current lookups/inserts
+int tileCacheResidentCount = 0;
+uint32_t tileCacheAccessSeq = 0;           // Bumped on every hit / insert
+int tileCacheRawStoredCount = 0;           // Tiles that did not compress and are stored raw
+uint32_t tileCacheStoredBytes = 0;         // Payload bytes in the slab
+uint32_t tileCacheChunkBytes = 0;          // Slab chunk bytes handed out (payload + class rounding)
+
+uint8_t* tileSlabArena = nullptr;          // Contiguous PSRAM block for all tile data
+TileSlabPage* tileSlabPages = nullptr;
+int16_t tileSlabPartialHead[TILE_SLAB_CLASSES];
+int16_t tileSlabFreePageHead = TILE_CACHE_NONE;
+int tileSlabPagesInUse = 0;
+
+uint8_t* tileDecodeBuffers = nullptr;      // TILE_CACHE_DECODE_SLOTS x TILE_DATA_SIZE
+uint8_t* tileEncodeBuffer = nullptr;       // Scratch for RLE encoding
+int32_t tileDecodeOwner[TILE_CACHE_DECODE_SLOTS];  // Entry decoded into each slot
+bool tileDecodeStaged[TILE_CACHE_DECODE_SLOTS];    // Slot handed out by insert, awaiting commit
+int tileDecodeStageKey[TILE_CACHE_DECODE_SLOTS][3];
+int tileDecodeNextSlot = 0;
+
+// --- INTERNAL HELPERS ---
+// Full 32-bit key hash; callers mask it to their table size
+static inline uint32_t tileCacheKeyHash(int zoom, int tileX, int tileY) {
+  uint32_t h = (uint32_t)zoom * 0x9E3779B1u;
+  h ^= (uint32_t)tileX * 0x85EBCA6Bu;
+  h ^= (uint32_t)tileY * 0xC2B2AE35u;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 13;
+  return h;
+}
+
+static inline uint32_t tileCacheHash(int zoom, int tileX, int tileY) {
+  return tileCacheKeyHash(zoom, tileX, tileY) & (TILE_CACHE_HASH_BUCKETS - 1);
+}
+
+static inline void tileCacheLruUnlink(int32_t index) {
+  TileCacheEntry& e = tileCache[index];
+  if (e.lruPrev != TILE_CACHE_NONE) tileCache[e.lruPrev].lruNext = e.lruNext;
+  else tileCacheLruHead = e.lruNext;
+  if (e.lruNext != TILE_CACHE_NONE) tileCache[e.lruNext].lruPrev = e.lruPrev;
+  else tileCacheLruTail = e.lruPrev;
+  e.lruPrev = TILE_CACHE_NONE;
+  e.lruNext = TILE_CACHE_NONE;
+}
+
+static inline void tileCacheLruPushFront(int32_t index) {
+  TileCacheEntry& e = tileCache[index];
+  e.lruPrev = TILE_CACHE_NONE;
+  e.lruNext = tileCacheLruHead;
+  if (tileCacheLruHead != TILE_CACHE_NONE) tileCache[tileCacheLruHead].lruPrev = index;
+  tileCacheLruHead = index;
+  if (tileCacheLruTail == TILE_CACHE_NONE) tileCacheLruTail = index;
+}
+
+static void tileSegUnlink(int32_t index) {
+  TileCacheEntry& e = tileCache[index];
+  int seg = e.segment;
+  if (e.segPrev != TILE_CACHE_NONE) tileCache[e.segPrev].segNext = e.segNext;
+  else tileSegHead[seg] = e.segNext;
+  if (e.segNext != TILE_CACHE_NONE) tileCache[e.segNext].segPrev = e.segPrev;
+  else tileSegTail[seg] = e.segPrev;
+  e.segPrev = TILE_CACHE_NONE;
+  e.segNext = TILE_CACHE_NONE;
+  tileSegCount[seg]--;
+  tileSegChunkBytes[seg] -= TILE_SLAB_CLASS_SIZE[e.slabClass];
+}
+
+static void tileSegPushFront(int32_t index, int seg) {
+  TileCacheEntry& e = tileCache[index];
+  e.segment = seg;
+  e.segPrev = TILE_CACHE_NONE;
+  e.segNext = tileSegHead[seg];
+  if (tileSegHead[seg] != TILE_CACHE_NONE) tileCache[tileSegHead[seg]].segPrev = index;
+  tileSegHead[seg] = index;
+  if (tileSegTail[seg] == TILE_CACHE_NONE) tileSegTail[seg] = index;
+  tileSegCount[seg]++;
+  tileSegChunkBytes[seg] += TILE_SLAB_CLASS_SIZE[e.slabClass];
+}
+
+static inline void tileCacheHashRemove(int32_t index) {
+  TileCacheEntry& e = tileCache[index];
+  int32_t* link = &tileCacheBuckets[tileCacheHash(e.zoom, e.tileX, e.tileY)];
+  while (*link != TILE_CACHE_NONE) {
+    if (*link == index) {
+      *link = e.hashNext;
+      break;
+    }
+    link = &tileCache[*link].hashNext;
+  }
+  e.hashNext = TILE_CACHE_NONE;
+}
+
+static inline int32_t tileCacheFind(int zoom, int tileX, int tileY) {
+  int32_t i = tileCacheBuckets[tileCacheHash(zoom, tileX, tileY)];
+  while (i != TILE_CACHE_NONE) {
+    TileCacheEntry& e = tileCache[i];
+    if (e.zoom == zoom && e.tileX == tileX && e.tileY == tileY) return i;
+    i = e.hashNext;
+  }
+  return TILE_CACHE_NONE;
+}
+
+// --- SLAB ALLOCATOR ---
+static inline int tileSlabChunksPerPage(int cls) {
+  return TILE_SLAB_PAGE_SIZE / TILE_SLAB_CLASS_SIZE[cls];
+}
+
+static int tileSlabClassFor(uint32_t size) {
+  for (int c = 0; c < TILE_SLAB_CLASSES; c++) {
+    if (size <= TILE_SLAB_CLASS_SIZE[c]) return c;
+  }
+  return TILE_SLAB_CLASSES - 1;
+}
+
+static inline bool tileSlabPageFull(const TileSlabPage& pg) {
+  for (int w = 0; w < TILE_SLAB_MASK_WORDS; w++) {
+    if (pg.freeMask[w]) return false;
+  }
+  return true;
+}
+
+static void tileSlabPartialUnlink(int16_t p) {
+  TileSlabPage& pg = tileSlabPages[p];
+  if (pg.prev != TILE_CACHE_NONE) tileSlabPages[pg.prev].next = pg.next;
+  else tileSlabPartialHead[pg.slabClass] = pg.next;
+  if (pg.next != TILE_CACHE_NONE) tileSlabPages[pg.next].prev = pg.prev;
+  pg.next = TILE_CACHE_NONE;
+  pg.prev = TILE_CACHE_NONE;
+}
+
+static void tileSlabPartialPush(int16_t p) {
+  TileSlabPage& pg = tileSlabPages[p];
+  pg.prev = TILE_CACHE_NONE;
+  pg.next = tileSlabPartialHead[pg.slabClass];
+  if (pg.next != TILE_CACHE_NONE) tileSlabPages[pg.next].prev = p;
+  tileSlabPartialHead[pg.slabClass] = p;
+}
+
+// Returns a chunk of class cls, or nullptr if no page has room
+static uint8_t* tileSlabAlloc(int cls) {
+  int16_t p = tileSlabPartialHead[cls];
+  if (p == TILE_CACHE_NONE) {
+    // Take a fresh page from the free list and carve it into chunks
+    p = tileSlabFreePageHead;
+    if (p == TILE_CACHE_NONE) return nullptr;
+    tileSlabFreePageHead = tileSlabPages[p].next;
+
+    TileSlabPage& pg = tileSlabPages[p];
+    pg.slabClass = cls;
+    pg.usedChunks = 0;
+    int chunks = tileSlabChunksPerPage(cls);
+    for (int w = 0; w < TILE_SLAB_MASK_WORDS; w++) {
+      int bits = chunks - w * 32;
+      if (bits >= 32) pg.freeMask[w] = 0xFFFFFFFFu;
+      else if (bits > 0) pg.freeMask[w] = (1u << bits) - 1;
+      else pg.freeMask[w] = 0;
+    }
+    tileSlabPartialPush(p);
+    tileSlabPagesInUse++;
+  }
+
+  TileSlabPage& pg = tileSlabPages[p];
+  int chunk = 0;
+  for (int w = 0; w < TILE_SLAB_MASK_WORDS; w++) {
+    if (pg.freeMask[w]) {
+      int bit = __builtin_ctz(pg.freeMask[w]);
+      pg.freeMask[w] &= ~(1u << bit);
+      chunk = w * 32 + bit;
+      break;
+    }
+  }
+  pg.usedChunks++;
+  if (tileSlabPageFull(pg)) tileSlabPartialUnlink(p);
+
+  return tileSlabArena + (size_t)p * TILE_SLAB_PAGE_SIZE + chunk * TILE_SLAB_CLASS_SIZE[cls];
+}
+
+static void tileSlabFree(uint8_t* ptr, int cls) {
+  size_t offset = ptr - tileSlabArena;
+  int16_t p = offset / TILE_SLAB_PAGE_SIZE;
+  int chunk = (offset % TILE_SLAB_PAGE_SIZE) / TILE_SLAB_CLASS_SIZE[cls];
+
+  TileSlabPage& pg = tileSlabPages[p];
+  bool wasFull = tileSlabPageFull(pg);
+  pg.freeMask[chunk / 32] |= (1u << (chunk % 32));
+  pg.usedChunks--;
+
+  if (pg.usedChunks == 0) {
+    // Empty page goes back to the shared pool so any class can reuse it
+    if (!wasFull) tileSlabPartialUnlink(p);
+    pg.slabClass = -1;
+    pg.next = tileSlabFreePageHead;
+    pg.prev = TILE_CACHE_NONE;
+    tileSlabFreePageHead = p;
+    tileSlabPagesInUse--;
+  } else if (wasFull) {
+    tileSlabPartialPush(p);
+  }
+}
+
+// --- RLE CODEC ---
+// (count, value) pairs, the format of the BLE tile transfer and of
+// compressed cache entries.
+
+// Decodes into decompressed; *decompressedSize is its capacity on entry,
+// the decoded size on return
+bool decompressRLE(uint8_t* compressed, uint32_t compressedSize, uint8_t* decompressed, uint32_t* decompressedSize) {
+  uint32_t srcIdx = 0;
+  uint32_t dstIdx = 0;
+  uint32_t maxDst = *decompressedSize;
+  while (srcIdx < compressedSize && dstIdx < maxDst) {
+    if (srcIdx + 1 >= compressedSize) return false;
+    uint8_t count = compressed[srcIdx++];
+    uint8_t value = compressed[srcIdx++];
+    if (dstIdx + count > maxDst) return false;
+    for (int i = 0; i < count; i++) decompressed[dstIdx++] = value;
+  }
+  *decompressedSize = dstIdx;
+  return true;
+}
+
+// Returns encoded size, or 0 if it would not fit in maxDst.
+static uint32_t tileCacheEncodeRLE(const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t maxDst) {
+  uint32_t s = 0;
+  uint32_t d = 0;
+  while (s < size) {
+    uint8_t value = src[s];
+    uint32_t run = 1;
+    while (s + run < size && run < 255 && src[s + run] == value) run++;
+    if (d + 2 > maxDst) return 0;
+    dst[d++] = (uint8_t)run;
+    dst[d++] = value;
+    s += run;
+  }
+  return d;
+}
+
+// --- DECODE SLOTS ---
+static inline uint8_t* tileDecodeBuffer(int slot) {
+  return tileDecodeBuffers + slot * TILE_DATA_SIZE;
+}
+
+static int tileDecodeAcquire() {
+  int slot = tileDecodeNextSlot;
+  tileDecodeNextSlot = (tileDecodeNextSlot + 1) % TILE_CACHE_DECODE_SLOTS;
+  if (tileDecodeOwner[slot] != TILE_CACHE_NONE) {
+    tileCache[tileDecodeOwner[slot]].decodeSlot = -1;
+    tileDecodeOwner[slot] = TILE_CACHE_NONE;
+  }
+  tileDecodeStaged[slot] = false;
+  return slot;
+}
+
+// Removes an entry from the index and returns its storage to the slab
+static void tileCacheDropEntry(int32_t index) {
+  TileCacheEntry& e = tileCache[index];
+  tileCacheLruUnlink(index);
+  tileSegUnlink(index);
+  tileCacheHashRemove(index);
+  if (e.decodeSlot >= 0) {
+    tileDecodeOwner[e.decodeSlot] = TILE_CACHE_NONE;
+    e.decodeSlot = -1;
+  }
+  tileSlabFree(e.data, e.slabClass);
+  tileCacheStoredBytes -= e.storedSize;
+  tileCacheChunkBytes -= TILE_SLAB_CLASS_SIZE[e.slabClass];
+  if (!e.compressed) tileCacheRawStoredCount--;
+  tileCacheResidentCount--;
+
+  e.valid = false;
+  e.data = nullptr;
+  e.zoom = -1;
+  e.tileX = -1;
+  e.tileY = -1;
+  e.hashNext = tileCacheFreeHead;
+  tileCacheFreeHead = index;
+}
+
+// Evicts the probationary tail; the protected segment only loses tiles once
+// there is nothing probationary left
+static bool tileCacheEvictLru() {
+  int32_t victim = tileSegTail[TILE_CLASS_BROWSE];
+  if (victim == TILE_CACHE_NONE) victim = tileSegTail[TILE_CLASS_ROUTE];
+  if (victim == TILE_CACHE_NONE) return false;
+  tileCacheDropEntry(victim);
+  cacheEvictions++;
+  return true;
+}
+
+// Keeps the protected segment within its byte budget by demoting its tail
+static void tileCacheBalanceSegments() {
+  uint32_t budget = (uint32_t)TILE_SLAB_PAGES * TILE_SLAB_PAGE_SIZE / 100 * TILE_CACHE_PROTECTED_PERCENT;
+  while (tileSegChunkBytes[TILE_CLASS_ROUTE] > budget && tileSegCount[TILE_CLASS_ROUTE] > 1) {
+    int32_t index = tileSegTail[TILE_CLASS_ROUTE];
+    tileSegUnlink(index);
+    tileSegPushFront(index, TILE_CLASS_BROWSE);
+    cacheDemotions++;
+  }
+}
+
+// True if an uncompressed cache of the same budget would still hold the entry.
+// Fewer than TILE_CACHE_RAW_CAPACITY accesses since its last use means fewer
+// distinct tiles went in front of it in the LRU order - a lower bound on the
+// exact rank test, in O(1).
+static bool tileCacheWithinRawCapacity(int32_t index) {
+  if (tileCacheResidentCount <= TILE_CACHE_RAW_CAPACITY) return true;
+  return tileCacheAccessSeq - tileCache[index].accessSeq < TILE_CACHE_RAW_CAPACITY;
+}
+
+// Evicts the entry nearest the LRU end (probationary first) stored in slab
+// class cls, looking at most TILE_CACHE_COMMIT_SCAN entries deep
+static bool tileCacheEvictClass(int cls) {
+  int scanned = 0;
+  for (int seg = TILE_CLASS_BROWSE; seg < TILE_CLASS_COUNT; seg++) {
+    for (int32_t i = tileSegTail[seg]; i != TILE_CACHE_NONE && scanned < TILE_CACHE_COMMIT_SCAN;
+         i = tileCache[i].segPrev, scanned++) {
+      if (tileCache[i].slabClass != cls) continue;
+      tileCacheDropEntry(i);
+      cacheEvictions++;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void tileCacheResetIndex() {
+  for (int i = 0; i < TILE_CACHE_HASH_BUCKETS; i++) {
+    tileCacheBuckets[i] = TILE_CACHE_NONE;
+  }
+  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
+    tileCache[i].zoom = -1;
+    tileCache[i].tileX = -1;
+    tileCache[i].tileY = -1;
+    tileCache[i].lastUsed = 0;
+    tileCache[i].accessSeq = 0;
+    tileCache[i].valid = false;
+    tileCache[i].compressed = false;
+    tileCache[i].slabClass = 0;
+    tileCache[i].decodeSlot = -1;
+    tileCache[i].storedSize = 0;
+    tileCache[i].data = nullptr;
+    tileCache[i].hashNext = (i + 1 < TILE_CACHE_SIZE) ? i + 1 : TILE_CACHE_NONE;
+    tileCache[i].lruPrev = TILE_CACHE_NONE;
+    tileCache[i].lruNext = TILE_CACHE_NONE;
+    tileCache[i].segment = TILE_CLASS_BROWSE;
+    tileCache[i].segPrev = TILE_CACHE_NONE;
+    tileCache[i].segNext = TILE_CACHE_NONE;
+  }
+  tileCacheFreeHead = 0;
+  tileCacheLruHead = TILE_CACHE_NONE;
+  tileCacheLruTail = TILE_CACHE_NONE;
+  for (int c = 0; c < TILE_CLASS_COUNT; c++) {
+    tileSegHead[c] = TILE_CACHE_NONE;
+    tileSegTail[c] = TILE_CACHE_NONE;
+    tileSegCount[c] = 0;
+    tileSegChunkBytes[c] = 0;
+  }
+
+  for (int c = 0; c < TILE_SLAB_CLASSES; c++) {
+    tileSlabPartialHead[c] = TILE_CACHE_NONE;
+  }
+  for (int p = 0; p < TILE_SLAB_PAGES; p++) {
+    tileSlabPages[p].slabClass = -1;
+    tileSlabPages[p].usedChunks = 0;
+    tileSlabPages[p].next = (p + 1 < TILE_SLAB_PAGES) ? p + 1 : TILE_CACHE_NONE;
+    tileSlabPages[p].prev = TILE_CACHE_NONE;
+  }
+  tileSlabFreePageHead = 0;
+  tileSlabPagesInUse = 0;
+
+  for (int s = 0; s < TILE_CACHE_DECODE_SLOTS; s++) {
+    tileDecodeOwner[s] = TILE_CACHE_NONE;
+    tileDecodeStaged[s] = false;
+  }
+  tileDecodeNextSlot = 0;
+
+  tileCacheResidentCount = 0;
+  tileCacheAccessSeq = 0;
+  tileCacheRawStoredCount = 0;
+  tileCacheStoredBytes = 0;
+  tileCacheChunkBytes = 0;
+}
+
+// --- CACHE LOCK ---
+// The map render task (map_render_task.h) reads tiles on the other core.
+// Code that looks up, inserts or draws from cached tiles holds this lock for
+// as long as it uses the returned pointers. Recursive, so locked callers may
+// call helpers that lock again. No-op while the cache is not initialized.
+SemaphoreHandle_t tileCacheMutex = nullptr;
+
+void tileCacheLock() {
+  if (tileCacheMutex) xSemaphoreTakeRecursive(tileCacheMutex, portMAX_DELAY);
+}
+
+// Non-blocking variant for background work that can simply try again later
+bool tileCacheTryLock() {
+  return !tileCacheMutex || xSemaphoreTakeRecursive(tileCacheMutex, 0) == pdTRUE;
+}
+
+void tileCacheUnlock() {
+  if (tileCacheMutex) xSemaphoreGiveRecursive(tileCacheMutex);
+}
 
 // --- CACHE INITIALIZATION ---
 bool initTileCache() {
@@ -37,117 +507,248 @@ bool initTileCache() {
   Serial.printf("PSRAM size: %d bytes\n", ESP.getPsramSize());
   Serial.printf("Free PSRAM: %d bytes\n", ESP.getFreePsram());
 
-  // Allocate cache entry array in PSRAM
+  // Allocate cache entry array and slab page table in PSRAM
   size_t entriesSize = TILE_CACHE_SIZE * sizeof(TileCacheEntry);
+  size_t pagesSize = TILE_SLAB_PAGES * sizeof(TileSlabPage);
   tileCache = (TileCacheEntry*)ps_malloc(entriesSize);
-  if (!tileCache) {
-    Serial.println("ERROR: Failed to allocate tile cache entries");
-    return false;
+  tileSlabPages = (TileSlabPage*)ps_malloc(pagesSize);
+
+  // Hash index is small and hit on every lookup, keep it in internal RAM when possible
+  size_t bucketsSize = TILE_CACHE_HASH_BUCKETS * sizeof(int32_t);
+  tileCacheBuckets = (int32_t*)malloc(bucketsSize);
+  if (!tileCacheBuckets) {
+    tileCacheBuckets = (int32_t*)ps_malloc(bucketsSize);
   }
 
-  // Allocate contiguous block for all tile data in PSRAM
-  size_t dataSize = TILE_CACHE_SIZE * TILE_DATA_SIZE;
-  tileCacheData = (uint8_t*)ps_malloc(dataSize);
-  if (!tileCacheData) {
-    Serial.println("ERROR: Failed to allocate tile cache data");
-    free(tileCache);
-    tileCache = nullptr;
+  // Decode slots and encode scratch
+  size_t decodeSize = TILE_CACHE_DECODE_SLOTS * TILE_DATA_SIZE;
+  tileDecodeBuffers = (uint8_t*)ps_malloc(decodeSize);
+  tileEncodeBuffer = (uint8_t*)ps_malloc(TILE_DATA_SIZE);
+
+  // Allocate contiguous slab arena for all tile data in PSRAM
+  size_t dataSize = (size_t)TILE_SLAB_PAGES * TILE_SLAB_PAGE_SIZE;
+  tileSlabArena = (uint8_t*)ps_malloc(dataSize);
+
+  if (!tileCache || !tileSlabPages || !tileCacheBuckets || !tileDecodeBuffers ||
+      !tileEncodeBuffer || !tileSlabArena) {
+    Serial.println("ERROR: Failed to allocate tile cache");
+    free(tileCache); tileCache = nullptr;
+    free(tileSlabPages); tileSlabPages = nullptr;
+    free(tileCacheBuckets); tileCacheBuckets = nullptr;
+    free(tileDecodeBuffers); tileDecodeBuffers = nullptr;
+    free(tileEncodeBuffer); tileEncodeBuffer = nullptr;
+    free(tileSlabArena); tileSlabArena = nullptr;
     return false;
   }
 
+  if (!tileCacheMutex) tileCacheMutex = xSemaphoreCreateRecursiveMutex();
+
   // Initialize cache entries
-  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
-    tileCache[i].zoom = -1;
-    tileCache[i].tileX = -1;
-    tileCache[i].tileY = -1;
-    tileCache[i].lastUsed = 0;
-    tileCache[i].valid = false;
-    tileCache[i].data = tileCacheData + (i * TILE_DATA_SIZE);  // Point to slice of data block
-  }
+  tileCacheResetIndex();
 
   // Reset statistics
   cacheHits = 0;
   cacheMisses = 0;
   cacheEvictions = 0;
+  cacheRawEquivalentHits = 0;
+  cachePromotions = 0;
+  cacheDemotions = 0;
+  for (int c = 0; c < TILE_CLASS_COUNT; c++) {
+    cacheClassHits[c] = 0;
+    cacheClassMisses[c] = 0;
+  }
 
-  Serial.printf("Tile cache initialized: %d tiles, %.2f MB total\n",
+  Serial.printf("Tile cache initialized: up to %d tiles (%s), %.2f MB total\n",
                 TILE_CACHE_SIZE,
-                (entriesSize + dataSize) / 1024.0 / 1024.0);
+                TILE_CACHE_COMPRESSED ? "RLE" : "raw",
+                (entriesSize + pagesSize + bucketsSize + decodeSize + TILE_DATA_SIZE + dataSize) / 1024.0 / 1024.0);
   Serial.printf("Free PSRAM after init: %d bytes\n", ESP.getFreePsram());
 
   return true;
 }
 
 // --- CACHE LOOKUP ---
-// Returns pointer to tile data if found in cache, nullptr otherwise
+// Returns pointer to decoded tile data if found in cache, nullptr otherwise
 uint8_t* tileCacheLookup(int zoom, int tileX, int tileY) {
   if (!tileCache) return nullptr;
 
-  unsigned long currentTime = millis();
+  int32_t index = tileCacheFind(zoom, tileX, tileY);
+  if (index == TILE_CACHE_NONE) {
+    cacheMisses++;
+    cacheClassMisses[tileCacheAccessClass]++;
+    return nullptr;
+  }
 
-  // Linear search through cache (fast enough for 128 entries)
-  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
-    if (tileCache[i].valid &&
-        tileCache[i].zoom == zoom &&
-        tileCache[i].tileX == tileX &&
-        tileCache[i].tileY == tileY) {
+  TileCacheEntry& e = tileCache[index];
+  uint8_t* tileData = e.data;
+
+  if (e.compressed) {
+    if (e.decodeSlot >= 0) {
+      tileData = tileDecodeBuffer(e.decodeSlot);
+    } else {
+      int slot = tileDecodeAcquire();
+      tileData = tileDecodeBuffer(slot);
+      uint32_t decodedSize = TILE_DATA_SIZE;
+      if (!decompressRLE(e.data, e.storedSize, tileData, &decodedSize) || decodedSize != TILE_DATA_SIZE) {
+        // Corrupt entry - drop it and let the caller reload from SD
+        Serial.printf("Tile cache: bad RLE for %d/%d/%d, dropping\n", zoom, tileX, tileY);
+        tileCacheDropEntry(index);
+        cacheMisses++;
+        cacheClassMisses[tileCacheAccessClass]++;
+        return nullptr;
+      }
+      tileDecodeOwner[slot] = index;
+      e.decodeSlot = slot;
+    }
+  }
 
-      // Cache hit! Update LRU timestamp
-      tileCache[i].lastUsed = currentTime;
-      cacheHits++;
+  if (tileCacheWithinRawCapacity(index)) cacheRawEquivalentHits++;
+  e.accessSeq = ++tileCacheAccessSeq;
 
-      return tileCache[i].data;
-    }
+  // Cache hit! Move to the front of the LRU list
+  if (index != tileCacheLruHead) {
+    tileCacheLruUnlink(index);
+    tileCacheLruPushFront(index);
+  }
+
+  // Route access promotes a probationary tile; otherwise it stays in its segment
+  int segment = e.segment;
+  if (tileCacheAccessClass == TILE_CLASS_ROUTE && segment == TILE_CLASS_BROWSE) {
+    segment = TILE_CLASS_ROUTE;
+    cachePromotions++;
   }
+  if (segment != e.segment || index != tileSegHead[segment]) {
+    tileSegUnlink(index);
+    tileSegPushFront(index, segment);
+    if (segment == TILE_CLASS_ROUTE) tileCacheBalanceSegments();
+  }
+
+  e.lastUsed = millis();
+  cacheHits++;
+  cacheClassHits[tileCacheAccessClass]++;
 
-  // Cache miss
-  cacheMisses++;
-  return nullptr;
+  return tileData;
+}
+
+// --- ACCESS CLASS ---
+// Sets the class used by following lookups/inserts. Returns the previous class
+// so callers can restore it when done.
+TileCacheClass setTileCacheAccessClass(TileCacheClass cls) {
+  TileCacheClass previous = tileCacheAccessClass;
+  tileCacheAccessClass = cls;
+  return previous;
+}
+
+// --- CACHE PEEK ---
+// True if the tile is cached. Does not touch LRU order or hit statistics.
+bool tileCacheContains(int zoom, int tileX, int tileY) {
+  if (!tileCache) return false;
+  return tileCacheFind(zoom, tileX, tileY) != TILE_CACHE_NONE;
+}
+
+bool isTileCacheReady() {
+  return tileCache != nullptr;
 }
 
 // --- CACHE INSERT ---
-// Inserts tile data into cache, evicting LRU entry if full
-// Returns pointer to cache slot where data should be written
+// Returns a TILE_DATA_SIZE buffer to read the tile into. The tile only becomes
+// visible to lookups after tileCacheCommit() is called with the same pointer.
 uint8_t* tileCacheInsert(int zoom, int tileX, int tileY) {
   if (!tileCache) return nullptr;
 
-  unsigned long currentTime = millis();
+  int slot = tileDecodeAcquire();
+  tileDecodeStaged[slot] = true;
+  tileDecodeStageKey[slot][0] = zoom;
+  tileDecodeStageKey[slot][1] = tileX;
+  tileDecodeStageKey[slot][2] = tileY;
+  return tileDecodeBuffer(slot);
+}
 
-  // First, try to find an invalid (empty) slot
-  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
-    if (!tileCache[i].valid) {
-      // Found empty slot
-      tileCache[i].zoom = zoom;
-      tileCache[i].tileX = tileX;
-      tileCache[i].tileY = tileY;
-      tileCache[i].lastUsed = currentTime;
-      tileCache[i].valid = true;
-
-      return tileCache[i].data;
+// --- CACHE COMMIT ---
+// Compresses a tile filled in via tileCacheInsert() into the slab, evicting a
+// bounded number of tiles to make room. The buffer stays readable as a decoded copy.
+bool tileCacheCommit(uint8_t* tileData) {
+  if (!tileCache || !tileData) return false;
+
+  int slot = -1;
+  for (int s = 0; s < TILE_CACHE_DECODE_SLOTS; s++) {
+    if (tileDecodeStaged[s] && tileDecodeBuffer(s) == tileData) {
+      slot = s;
+      break;
     }
   }
+  if (slot < 0) return false;
+  tileDecodeStaged[slot] = false;
+
+  int zoom = tileDecodeStageKey[slot][0];
+  int tileX = tileDecodeStageKey[slot][1];
+  int tileY = tileDecodeStageKey[slot][2];
+
+  // Re-inserted tile (e.g. file changed on SD) replaces the old copy
+  int32_t existing = tileCacheFind(zoom, tileX, tileY);
+  if (existing != TILE_CACHE_NONE) tileCacheDropEntry(existing);
+
+  const uint8_t* payload = tileData;
+  uint32_t payloadSize = TILE_DATA_SIZE;
+  bool compressed = false;
+#if TILE_CACHE_COMPRESSED
+  uint32_t encodedSize = tileCacheEncodeRLE(tileData, TILE_DATA_SIZE, tileEncodeBuffer, TILE_DATA_SIZE - 1);
+  if (encodedSize > 0) {
+    payload = tileEncodeBuffer;
+    payloadSize = encodedSize;
+    compressed = true;
+  }
+#endif
 
-  // Cache is full - find LRU (oldest) entry to evict
-  int oldestIndex = 0;
-  unsigned long oldestTime = tileCache[0].lastUsed;
+  int cls = tileSlabClassFor(payloadSize);
+  uint8_t* chunk = tileSlabAlloc(cls);
+  for (int n = 0; !chunk && n < TILE_CACHE_COMMIT_EVICTIONS && tileCacheEvictLru(); n++) {
+    chunk = tileSlabAlloc(cls);
+  }
+  // Fragmented slab: free a chunk of this class rather than flushing the cache
+  if (!chunk && tileCacheEvictClass(cls)) chunk = tileSlabAlloc(cls);
+  if (!chunk) return false;  // The staged buffer still serves as a decoded copy
 
-  for (int i = 1; i < TILE_CACHE_SIZE; i++) {
-    if (tileCache[i].lastUsed < oldestTime) {
-      oldestTime = tileCache[i].lastUsed;
-      oldestIndex = i;
-    }
+  if (tileCacheFreeHead == TILE_CACHE_NONE && !tileCacheEvictLru()) {
+    tileSlabFree(chunk, cls);
+    return false;
+  }
+  int32_t index = tileCacheFreeHead;
+  tileCacheFreeHead = tileCache[index].hashNext;
+
+  memcpy(chunk, payload, payloadSize);
+
+  TileCacheEntry& e = tileCache[index];
+  e.zoom = zoom;
+  e.tileX = tileX;
+  e.tileY = tileY;
+  e.lastUsed = millis();
+  e.accessSeq = ++tileCacheAccessSeq;
+  e.valid = true;
+  e.compressed = compressed;
+  e.slabClass = cls;
+  e.storedSize = payloadSize;
+  e.data = chunk;
+  e.decodeSlot = -1;
+  if (compressed) {
+    // The staging buffer already holds the decoded tile
+    e.decodeSlot = slot;
+    tileDecodeOwner[slot] = index;
   }
 
-  // Evict oldest entry
-  cacheEvictions++;
+  uint32_t bucket = tileCacheHash(zoom, tileX, tileY);
+  e.hashNext = tileCacheBuckets[bucket];
+  tileCacheBuckets[bucket] = index;
+  tileCacheLruPushFront(index);
+  tileSegPushFront(index, tileCacheAccessClass);
+  if (tileCacheAccessClass == TILE_CLASS_ROUTE) tileCacheBalanceSegments();
 
-  tileCache[oldestIndex].zoom = zoom;
-  tileCache[oldestIndex].tileX = tileX;
-  tileCache[oldestIndex].tileY = tileY;
-  tileCache[oldestIndex].lastUsed = currentTime;
-  tileCache[oldestIndex].valid = true;
+  tileCacheResidentCount++;
+  tileCacheStoredBytes += payloadSize;
+  tileCacheChunkBytes += TILE_SLAB_CLASS_SIZE[cls];
+  if (!compressed) tileCacheRawStoredCount++;
 
-  return tileCache[oldestIndex].data;
+  return true;
 }
 
 // --- CACHE CLEAR ---
@@ -155,14 +756,18 @@ uint8_t* tileCacheInsert(int zoom, int tileX, int tileY) {
 void tileCacheClear() {
   if (!tileCache) return;
 
-  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
-    tileCache[i].valid = false;
-    tileCache[i].lastUsed = 0;
-  }
+  tileCacheResetIndex();
 
   cacheHits = 0;
   cacheMisses = 0;
   cacheEvictions = 0;
+  cacheRawEquivalentHits = 0;
+  cachePromotions = 0;
+  cacheDemotions = 0;
+  for (int c = 0; c < TILE_CLASS_COUNT; c++) {
+    cacheClassHits[c] = 0;
+    cacheClassMisses[c] = 0;
+  }
 
   Serial.println("Tile cache cleared");
 }
@@ -174,25 +779,38 @@ void printTileCacheStats() {
     return;
   }
 
-  // Count valid entries
-  int validEntries = 0;
-  for (int i = 0; i < TILE_CACHE_SIZE; i++) {
-    if (tileCache[i].valid) {
-      validEntries++;
-    }
-  }
-
   // Calculate hit rate
   unsigned long totalAccesses = cacheHits + cacheMisses;
   float hitRate = (totalAccesses > 0) ? (100.0 * cacheHits / totalAccesses) : 0.0;
+  float rawHitRate = (totalAccesses > 0) ? (100.0 * cacheRawEquivalentHits / totalAccesses) : 0.0;
+  float ratio = (tileCacheStoredBytes > 0) ?
+                ((float)tileCacheResidentCount * TILE_DATA_SIZE / tileCacheStoredBytes) : 0.0;
 
   Serial.println("=== TILE CACHE STATISTICS ===");
-  Serial.printf("Cache size: %d tiles\n", TILE_CACHE_SIZE);
-  Serial.printf("Valid entries: %d (%.1f%% full)\n", validEntries, 100.0 * validEntries / TILE_CACHE_SIZE);
+  Serial.printf("Cache size: %d tiles max (%s mode)\n", TILE_CACHE_SIZE, TILE_CACHE_COMPRESSED ? "RLE" : "raw");
+  Serial.printf("Valid entries: %d (%.1f%% full, raw cache would hold %d)\n",
+                tileCacheResidentCount, 100.0 * tileCacheResidentCount / TILE_CACHE_SIZE, TILE_CACHE_RAW_CAPACITY);
+  Serial.printf("Stored: %lu bytes for %lu bytes of tiles (%.1fx), %d uncompressible\n",
+                (unsigned long)tileCacheStoredBytes,
+                (unsigned long)tileCacheResidentCount * TILE_DATA_SIZE,
+                ratio, tileCacheRawStoredCount);
+  Serial.printf("Slab: %d/%d pages, %lu bytes in chunks (%.1f%% rounding waste)\n",
+                tileSlabPagesInUse, TILE_SLAB_PAGES, (unsigned long)tileCacheChunkBytes,
+                tileCacheChunkBytes > 0 ? 100.0 * (tileCacheChunkBytes - tileCacheStoredBytes) / tileCacheChunkBytes : 0.0);
   Serial.printf("Cache hits: %lu\n", cacheHits);
   Serial.printf("Cache misses: %lu\n", cacheMisses);
   Serial.printf("Cache evictions: %lu\n", cacheEvictions);
-  Serial.printf("Hit rate: %.1f%%\n", hitRate);
+  const char* classNames[TILE_CLASS_COUNT] = {"Browse", "Route"};
+  for (int c = 0; c < TILE_CLASS_COUNT; c++) {
+    unsigned long classTotal = cacheClassHits[c] + cacheClassMisses[c];
+    Serial.printf("%s: %d tiles, %lu bytes | hits %lu misses %lu (%.1f%%)\n",
+                  classNames[c], tileSegCount[c], (unsigned long)tileSegChunkBytes[c],
+                  cacheClassHits[c], cacheClassMisses[c],
+                  classTotal > 0 ? 100.0 * cacheClassHits[c] / classTotal : 0.0);
+  }
+  Serial.printf("Promotions: %lu, demotions: %lu\n", cachePromotions, cacheDemotions);
+  Serial.printf("Hit rate: %.1f%% (raw-equivalent %.1f%%, gain %+.1f pts)\n",
+                hitRate, rawHitRate, hitRate - rawHitRate);
   Serial.printf("Free PSRAM: %d bytes\n", ESP.getFreePsram());
   Serial.println("============================");
 }
@@ -204,8 +822,10 @@ void printCacheSlot(int index) {
   TileCacheEntry* entry = &tileCache[index];
   Serial.printf("Slot %d: ", index);
   if (entry->valid) {
-    Serial.printf("z=%d x=%d y=%d lastUsed=%lu\n",
-                  entry->zoom, entry->tileX, entry->tileY, entry->lastUsed);
+    Serial.printf("z=%d x=%d y=%d lastUsed=%lu %s %u bytes %s\n",
+                  entry->zoom, entry->tileX, entry->tileY, entry->lastUsed,
+                  entry->compressed ? "rle" : "raw", entry->storedSize,
+                  entry->segment == TILE_CLASS_ROUTE ? "protected" : "probation");
   } else {
     Serial.println("EMPTY");
   }
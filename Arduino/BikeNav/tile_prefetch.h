@@ -0,0 +1,230 @@
+#ifndef TILE_PREFETCH_H
+#define TILE_PREFETCH_H
+
+#include <Arduino.h>
+#include <math.h>
+
+// External navigation state from map_navigation.h
+extern bool navigationActive;
+extern TrackPoint* navigationTrack;
+extern int navigationTrackPointCount;
+extern int currentWaypointIndex;
+extern float calculateDistance(double lat1, double lon1, double lat2, double lon2);
+
+// External zoom state from page_map.h / map_rendering.h
+extern int currentZoomIndex;
+
+// External tile loading from map_rendering.h / tile_cache.h
+extern uint8_t* loadTileIntoCache(int zoom, int tileX, int tileY);
+extern bool tileCacheContains(int zoom, int tileX, int tileY);
+extern bool isTileCacheReady();
+extern TileCacheClass setTileCacheAccessClass(TileCacheClass cls);
+extern bool tileCacheTryLock();
+extern void tileCacheUnlock();
+
+// BLE tile transfer in progress (ble_handler.h) - leave the SD card to it
+extern bool tileHeaderReceived;
+
+// Defined in BikeNav.ino - true while encoder/button events wait to be handled
+extern bool isUserInputPending();
+
+// --- PREFETCH CONFIGURATION ---
+const float PREFETCH_DISTANCE_M = 3000.0;      // How far ahead along the route to prefetch
+const int PREFETCH_MARGIN_PX = 192;            // Corridor half-width, covers the rotated screen around the route
+const unsigned long PREFETCH_BUDGET_MS = 25;   // Max time per loop iteration (one tile read may overrun it)
+const int PREFETCH_MISS_RING = 32;             // Recently missing tiles, so they are not probed again
+
+// --- PREFETCH STATE ---
+struct TilePrefetchState {
+  TrackPoint* track;       // Track the pass belongs to (detects a new navigation)
+  int zoomIndex;           // currentZoomIndex the pass was planned for
+  int anchor;              // Waypoint index distanceAhead is measured from
+  int cursor;              // Next track point to process
+  int zoomPass;            // Zoom of the cursor point to resume at
+  float distanceAhead;     // Route distance from anchor to cursor (meters)
+  bool corridorReady;      // Prefetched up to PREFETCH_DISTANCE_M ahead
+  bool readyLogged;
+  int lastMinX[3], lastMinY[3], lastMaxX[3], lastMaxY[3];  // Last tile range per zoom pass
+  unsigned long tilesLoaded;
+  unsigned long tilesMissing;
+  unsigned long tilesAlreadyCached;
+};
+
+TilePrefetchState prefetchState = {nullptr, -1, 0, 0, 0, 0.0, false, false};
+int prefetchMissRing[PREFETCH_MISS_RING][3];
+int prefetchMissRingPos = 0;
+
+// --- HELPERS ---
+void resetTilePrefetch() {
+  prefetchState.track = navigationTrack;
+  prefetchState.zoomIndex = currentZoomIndex;
+  prefetchState.anchor = currentWaypointIndex;
+  prefetchState.cursor = currentWaypointIndex;
+  prefetchState.zoomPass = 0;
+  prefetchState.distanceAhead = 0.0;
+  prefetchState.corridorReady = false;
+  prefetchState.readyLogged = false;
+  for (int i = 0; i < 3; i++) {
+    prefetchState.lastMinX[i] = prefetchState.lastMinY[i] = 1;
+    prefetchState.lastMaxX[i] = prefetchState.lastMaxY[i] = 0;  // Empty range
+  }
+  prefetchState.tilesLoaded = 0;
+  prefetchState.tilesMissing = 0;
+  prefetchState.tilesAlreadyCached = 0;
+}
+
+static bool prefetchRecentlyMissing(int zoom, int tileX, int tileY) {
+  for (int i = 0; i < PREFETCH_MISS_RING; i++) {
+    if (prefetchMissRing[i][0] == zoom && prefetchMissRing[i][1] == tileX && prefetchMissRing[i][2] == tileY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Current zoom first, then the next closer and next farther zoom
+static int getPrefetchZooms(int* zooms) {
+  int count = 0;
+  zooms[count++] = ZOOM_LEVELS[currentZoomIndex];
+  if (currentZoomIndex > 0) zooms[count++] = ZOOM_LEVELS[currentZoomIndex - 1];
+  if (currentZoomIndex < ZOOM_COUNT - 1) zooms[count++] = ZOOM_LEVELS[currentZoomIndex + 1];
+  return count;
+}
+
+/**
+ * Fetch the corridor tiles around one track point for all prefetch zooms.
+ * Returns false when the time budget ran out or input is waiting; the
+ * state keeps the zoom pass so the next call resumes at the same point.
+ */
+static bool prefetchTrackPoint(int index, unsigned long startMs, unsigned long budgetMs) {
+  int zooms[3];
+  int zoomCount = getPrefetchZooms(zooms);
+
+  // Project once at the highest zoom, lower zooms are plain shifts
+  int topZoom = zooms[0];
+  for (int i = 1; i < zoomCount; i++) {
+    if (zooms[i] > topZoom) topZoom = zooms[i];
+  }
+  double worldSize = ldexp(256.0, topZoom);
+  double latRad = navigationTrack[index].lat * M_PI / 180.0;
+  int32_t worldX = (int32_t)((navigationTrack[index].lon + 180.0) / 360.0 * worldSize);
+  int32_t worldY = (int32_t)((1.0 - asinh(tan(latRad)) / M_PI) / 2.0 * worldSize);
+
+  for (; prefetchState.zoomPass < zoomCount; prefetchState.zoomPass++) {
+    int pass = prefetchState.zoomPass;
+    int zoom = zooms[pass];
+    int shift = topZoom - zoom;
+    int32_t px = worldX >> shift;
+    int32_t py = worldY >> shift;
+
+    int minX = (px - PREFETCH_MARGIN_PX) >> 8;
+    int maxX = (px + PREFETCH_MARGIN_PX) >> 8;
+    int minY = (py - PREFETCH_MARGIN_PX) >> 8;
+    int maxY = (py + PREFETCH_MARGIN_PX) >> 8;
+
+    for (int tileY = minY; tileY <= maxY; tileY++) {
+      for (int tileX = minX; tileX <= maxX; tileX++) {
+        // Already handled for the previous point at this zoom
+        if (tileX >= prefetchState.lastMinX[pass] && tileX <= prefetchState.lastMaxX[pass] &&
+            tileY >= prefetchState.lastMinY[pass] && tileY <= prefetchState.lastMaxY[pass]) {
+          continue;
+        }
+        // The render task may hold the cache for a whole frame - never wait for it
+        if (!tileCacheTryLock()) return false;
+        bool cached = tileCacheContains(zoom, tileX, tileY);
+        tileCacheUnlock();
+        if (cached) {
+          prefetchState.tilesAlreadyCached++;
+          continue;
+        }
+        if (prefetchRecentlyMissing(zoom, tileX, tileY)) continue;
+
+        if (millis() - startMs >= budgetMs || isUserInputPending()) {
+          return false;
+        }
+
+        if (!tileCacheTryLock()) return false;
+        TileCacheClass previousClass = setTileCacheAccessClass(TILE_CLASS_ROUTE);
+        uint8_t* loaded = loadTileIntoCache(zoom, tileX, tileY);
+        setTileCacheAccessClass(previousClass);
+        tileCacheUnlock();
+
+        if (loaded) {
+          prefetchState.tilesLoaded++;
+        } else {
+          prefetchState.tilesMissing++;
+          prefetchMissRing[prefetchMissRingPos][0] = zoom;
+          prefetchMissRing[prefetchMissRingPos][1] = tileX;
+          prefetchMissRing[prefetchMissRingPos][2] = tileY;
+          prefetchMissRingPos = (prefetchMissRingPos + 1) % PREFETCH_MISS_RING;
+        }
+      }
+    }
+
+    prefetchState.lastMinX[pass] = minX;
+    prefetchState.lastMaxX[pass] = maxX;
+    prefetchState.lastMinY[pass] = minY;
+    prefetchState.lastMaxY[pass] = maxY;
+  }
+
+  return true;
+}
+
+/**
+ * Pull tiles for the next PREFETCH_DISTANCE_M of the active route into the
+ * tile cache, at the current zoom and +-1 zoom. Call from the idle part of
+ * loop(); stops after budgetMs or as soon as user input is pending.
+ */
+void updateTilePrefetch(unsigned long budgetMs) {
+  if (!navigationActive || navigationTrack == nullptr || navigationTrackPointCount < 2) {
+    prefetchState.track = nullptr;
+    return;
+  }
+  if (!isTileCacheReady() || tileHeaderReceived) return;
+
+  // New route, zoom change, or rider jumped outside the planned stretch -> start over
+  if (prefetchState.track != navigationTrack ||
+      prefetchState.zoomIndex != currentZoomIndex ||
+      currentWaypointIndex < prefetchState.anchor ||
+      currentWaypointIndex > prefetchState.cursor) {
+    resetTilePrefetch();
+  }
+
+  // Keep distanceAhead measured from the rider's current waypoint
+  while (prefetchState.anchor < currentWaypointIndex) {
+    int i = prefetchState.anchor;
+    prefetchState.distanceAhead -= calculateDistance(navigationTrack[i].lat, navigationTrack[i].lon,
+                                                     navigationTrack[i + 1].lat, navigationTrack[i + 1].lon);
+    prefetchState.anchor++;
+  }
+
+  if (prefetchState.corridorReady && prefetchState.distanceAhead >= PREFETCH_DISTANCE_M) return;
+  if (prefetchState.cursor >= navigationTrackPointCount) return;
+  prefetchState.corridorReady = false;
+
+  unsigned long startMs = millis();
+  while (prefetchState.cursor < navigationTrackPointCount &&
+         prefetchState.distanceAhead < PREFETCH_DISTANCE_M) {
+    int i = prefetchState.cursor;
+    if (!prefetchTrackPoint(i, startMs, budgetMs)) return;  // Out of budget, resume here next time
+
+    if (i + 1 < navigationTrackPointCount) {
+      prefetchState.distanceAhead += calculateDistance(navigationTrack[i].lat, navigationTrack[i].lon,
+                                                       navigationTrack[i + 1].lat, navigationTrack[i + 1].lon);
+    }
+    prefetchState.cursor++;
+    prefetchState.zoomPass = 0;
+
+    if (millis() - startMs >= budgetMs) return;
+  }
+
+  prefetchState.corridorReady = true;
+  if (!prefetchState.readyLogged) {
+    prefetchState.readyLogged = true;
+    Serial.printf("[PREFETCH] Route corridor ready: %.1f km ahead at z%d+-1 (loaded %lu, missing %lu, cached %lu)\n",
+                  prefetchState.distanceAhead / 1000.0, ZOOM_LEVELS[currentZoomIndex],
+                  prefetchState.tilesLoaded, prefetchState.tilesMissing, prefetchState.tilesAlreadyCached);
+  }
+}
+
+#endif // TILE_PREFETCH_H
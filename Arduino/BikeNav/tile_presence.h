@@ -0,0 +1,141 @@
+#ifndef TILE_PRESENCE_H
+#define TILE_PRESENCE_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include "spi_bus.h"
+
+// --- TILE PRESENCE FILTER ---
+// Bloom filter over the (zoom, x, y) records of /Map/index.bin. A "no" is
+// definite and saves the SD.exists() directory walk; a "maybe" still goes
+// to the card. Until the index is loaded every tile counts as "maybe".
+#define TILE_PRESENCE_BITS (1UL << 21)   // 2M bits = 256KB PSRAM, ~0.1% false positives at 100k tiles
+#define TILE_PRESENCE_HASHES 4
+#define TILE_PRESENCE_READ_RECORDS 128   // Index records per SD read while loading
+
+uint32_t* tilePresenceBits = nullptr;
+volatile bool tilePresenceReady = false;
+uint32_t tilePresenceCount = 0;                   // Records added since the last clear
+unsigned long tilePresenceProbesAvoided = 0;      // Total SD probes answered by the filter
+unsigned long tilePresenceFrameProbesAvoided = 0; // Since the last takeTilePresenceFrameStats()
+unsigned long tilePresenceFalsePositives = 0;     // Filter said maybe, SD said no
+
+// Two independent hashes, combined as h1 + i*h2 for each probe
+static inline void tilePresenceHash(int zoom, uint32_t tileX, uint32_t tileY, uint32_t* h1, uint32_t* h2) {
+  uint32_t h = (uint32_t)zoom * 0x9E3779B1u ^ tileX * 0x85EBCA6Bu ^ tileY * 0xC2B2AE35u;
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+  *h1 = h;
+
+  uint32_t g = tileX * 0xCC9E2D51u + tileY * 0x1B873593u + (uint32_t)zoom;
+  g ^= g >> 15;
+  g *= 0x2C1B3C6Du;
+  g ^= g >> 12;
+  *h2 = g | 1;
+}
+
+void tilePresenceAdd(uint8_t zoom, uint32_t tileX, uint32_t tileY) {
+  if (!tilePresenceBits) return;
+  uint32_t h1, h2;
+  tilePresenceHash(zoom, tileX, tileY, &h1, &h2);
+  for (int i = 0; i < TILE_PRESENCE_HASHES; i++) {
+    uint32_t bit = (h1 + i * h2) & (TILE_PRESENCE_BITS - 1);
+    tilePresenceBits[bit >> 5] |= (1u << (bit & 31));
+  }
+  tilePresenceCount++;
+}
+
+/**
+ * False only if the tile is definitely not on SD card (counts as an avoided probe).
+ */
+bool tilePresenceMayExist(int zoom, int tileX, int tileY) {
+  if (!tilePresenceReady) return true;
+  uint32_t h1, h2;
+  tilePresenceHash(zoom, (uint32_t)tileX, (uint32_t)tileY, &h1, &h2);
+  for (int i = 0; i < TILE_PRESENCE_HASHES; i++) {
+    uint32_t bit = (h1 + i * h2) & (TILE_PRESENCE_BITS - 1);
+    if (!(tilePresenceBits[bit >> 5] & (1u << (bit & 31)))) {
+      tilePresenceProbesAvoided++;
+      tilePresenceFrameProbesAvoided++;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Call when the filter said "maybe" but the tile was not on SD card
+void tilePresenceNoteMiss() {
+  if (tilePresenceReady) tilePresenceFalsePositives++;
+}
+
+// Empties the filter and stops answering until setTilePresenceReady(true)
+void tilePresenceClear() {
+  tilePresenceReady = false;
+  if (tilePresenceBits) memset(tilePresenceBits, 0, TILE_PRESENCE_BITS / 8);
+  tilePresenceCount = 0;
+}
+
+void setTilePresenceReady(bool ready) {
+  tilePresenceReady = ready && tilePresenceBits != nullptr;
+}
+
+/**
+ * Allocate the filter and fill it from the tile index file.
+ * If the index is missing the filter stays disabled (all probes hit SD)
+ * until the index is rebuilt.
+ */
+bool loadTilePresenceFilter(const char* indexPath) {
+  if (!tilePresenceBits) {
+    tilePresenceBits = (uint32_t*)ps_malloc(TILE_PRESENCE_BITS / 8);
+    if (!tilePresenceBits) {
+      Serial.println("[PRESENCE] ERROR: Failed to allocate tile presence filter");
+      return false;
+    }
+  }
+  tilePresenceClear();
+  SpiBusTransaction bus(SPI_CLIENT_SD_READ);
+
+  File indexFile = SD.open(indexPath, FILE_READ);
+  if (!indexFile) {
+    Serial.println("[PRESENCE] No tile index, filter disabled");
+    return false;
+  }
+
+  unsigned long start = millis();
+  uint8_t buffer[TILE_PRESENCE_READ_RECORDS * 9];
+  while (true) {
+    int bytesRead = indexFile.read(buffer, sizeof(buffer));
+    if (bytesRead <= 0) break;
+    for (int off = 0; off + 9 <= bytesRead; off += 9) {
+      uint8_t* r = buffer + off;
+      uint32_t tileX = ((uint32_t)r[1] << 24) | ((uint32_t)r[2] << 16) | ((uint32_t)r[3] << 8) | r[4];
+      uint32_t tileY = ((uint32_t)r[5] << 24) | ((uint32_t)r[6] << 16) | ((uint32_t)r[7] << 8) | r[8];
+      tilePresenceAdd(r[0], tileX, tileY);
+    }
+    if (bytesRead < (int)sizeof(buffer)) break;
+  }
+  indexFile.close();
+
+  setTilePresenceReady(true);
+  Serial.printf("[PRESENCE] Loaded %lu tile records in %lu ms\n",
+                (unsigned long)tilePresenceCount, millis() - start);
+  return true;
+}
+
+// Returns SD probes avoided since the last call (one map frame)
+unsigned long takeTilePresenceFrameStats() {
+  unsigned long avoided = tilePresenceFrameProbesAvoided;
+  tilePresenceFrameProbesAvoided = 0;
+  return avoided;
+}
+
+void printTilePresenceStats() {
+  Serial.printf("[PRESENCE] %s, %lu records, %lu SD probes avoided, %lu false positives\n",
+                tilePresenceReady ? "ready" : "not loaded", (unsigned long)tilePresenceCount,
+                tilePresenceProbesAvoided, tilePresenceFalsePositives);
+}
+
+#endif // TILE_PRESENCE_H